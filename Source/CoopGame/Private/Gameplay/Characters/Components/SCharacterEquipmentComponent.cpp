@@ -5,243 +5,495 @@
 #include "Gameplay/Characters/Components/SCharacterEquipmentComponent.h"
 #include "Gameplay/Characters/SPlayerCharacter.h"
 #include "Gameplay/Weapons/SWeapon.h"
+#include "Gameplay/Weapons/Helpers/AmmoCore.h"
+#include "Engine/AssetManager.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "General/SLogCategories.h"
+#include "General/SWeaponTrace.h"
 
 
 
 // Sets default values for this component's properties
 USCharacterEquipmentComponent::USCharacterEquipmentComponent() {
 
-
+	// Only ticks while the loadout is being spawned and on the frame after a switch
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	CurrentWeapon = nullptr;
+	MaxWeaponSlots = 5;
+	CurrentSlotIndex = INDEX_NONE;
+	LastSlotIndex = INDEX_NONE;
+	LastSwitchDirection = 0;
+	PrewarmedSlotIndex = INDEX_NONE;
+	bPrewarmPending = false;
+	LastSlotSwitchKey = 0;
+	bRestoringServerSlot = false;
+	bPrewarmPredictedWeapon = true;
+	NumLoadoutWeapons = 0;
+	NextLoadoutSpawnIndex = 0;
+	bLoadoutClassesLoaded = false;
+	bLoadoutSpawnSuccess = false;
+	ReplicatedSlotIndex = 0;
+
+	SetIsReplicatedByDefault(true);
 	
 }
 
 // Spawns the configured loadout for the character and delegates its addition to the loadout
 void USCharacterEquipmentComponent::SpawnDefaultLoadout() {
 
-	// Success flag used to trigger broadcast of loadout spawn
-	bool Success = false;
+	// The weapons are replicated, clients get theirs from the server; a character that already has weapons (e.g.: taken over from its player's previous character) keeps them
+	if (GetOwnerRole() != ROLE_Authority || HasLoadout()) {
+
+		return;
+
+	}
+
+	// Guarantees we will only try to spawn only the weapons types from the first MaxWeaponSlots members of the DefaultWeapons array
+	NumLoadoutWeapons = FMath::Min<int32>(DefaultWeapons.Num(), MaxWeaponSlots);
+	NextLoadoutSpawnIndex = 0;
+	bLoadoutClassesLoaded = false;
+	bLoadoutSpawnSuccess = false;
+	WeaponSlots.Reserve(MaxWeaponSlots);
+
+	if (NumLoadoutWeapons > 0 && Cast<ASPlayerCharacter>(GetOwner())) {
+
+		FStreamableManager& Streamable = UAssetManager::GetStreamableManager();
+
+		// The first weapon is loaded ahead of the others, so the player is armed as soon as possible (right away if it is already in memory)
+		if (DefaultWeapons[0].IsNull() || DefaultWeapons[0].Get()) {
+
+			SpawnNextLoadoutWeapon();
+
+		}
+		else {
+
+			FirstWeaponLoadHandle = Streamable.RequestAsyncLoad(DefaultWeapons[0].ToSoftObjectPath(), FStreamableDelegate::CreateUObject(this, &USCharacterEquipmentComponent::SpawnNextLoadoutWeapon), FStreamableManager::AsyncLoadHighPriority);
+
+		}
+
+		// The rest of the loadout is loaded in the background and spawned one weapon per frame once it's in memory
+		TArray<FSoftObjectPath> RemainingWeaponPaths;
+
+		for (int32 WeaponIndex = 1; WeaponIndex < NumLoadoutWeapons; ++WeaponIndex) {
+
+			if (!DefaultWeapons[WeaponIndex].IsNull() && !DefaultWeapons[WeaponIndex].Get()) {
+
+				RemainingWeaponPaths.Add(DefaultWeapons[WeaponIndex].ToSoftObjectPath());
+
+			}
+
+		}
+
+		if (RemainingWeaponPaths.Num() > 0) {
+
+			LoadoutLoadHandle = Streamable.RequestAsyncLoad(RemainingWeaponPaths, FStreamableDelegate::CreateUObject(this, &USCharacterEquipmentComponent::OnLoadoutClassesLoaded));
+
+		}
+		else {
 
-	// Used to set the initially active weapon
-	uint8 InitialActiveWeaponSlotNumber = 0;
+			OnLoadoutClassesLoaded();
+
+		}
+
+	}
 	
+}
+
+
+// Spawns the weapon of the next DefaultWeapons entry and adds it to the loadout (the first one is equipped), finishing the loadout after the last one
+void USCharacterEquipmentComponent::SpawnNextLoadoutWeapon() {
+
 	ASPlayerCharacter* OwningCharacter = Cast<ASPlayerCharacter>(GetOwner());
 	
-	if (OwningCharacter) {
+	if (OwningCharacter && NextLoadoutSpawnIndex < NumLoadoutWeapons) {
 
-		// Guarantees we will only try to spawn only the weapons types from the first 3 members of the DefaultWeapons array
-		uint8 NumUniqueWeapons = (DefaultWeapons.Num() <= 3) ? DefaultWeapons.Num() : 3;
+		const int32 i = NextLoadoutSpawnIndex++;
+		UClass* WeaponClass = DefaultWeapons[i].Get();
 
-		for (uint8 i = 0; i < NumUniqueWeapons; i++){
+		// Spawn Weapon only if the subclass has been set up properly (and loaded)
+		if (WeaponClass) { 
 
-			// Spawn Weapon only if the subclass has been set up properly
-			if (DefaultWeapons[i]) { 
-
-				// Spawn weapon proper
-				FTransform PlayerTransform = OwningCharacter->GetActorTransform();
-				FActorSpawnParameters SpawnParameters;
-				SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			// Spawn weapon proper
+			FTransform PlayerTransform = OwningCharacter->GetActorTransform();
+			FActorSpawnParameters SpawnParameters;
+			SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			SpawnParameters.Owner = OwningCharacter;
+			SpawnParameters.Instigator = OwningCharacter;
 	
-				ASWeapon* NewWeapon = GetWorld()->SpawnActor<ASWeapon>(DefaultWeapons[i], PlayerTransform, SpawnParameters);
+			ASWeapon* NewWeapon = GetWorld()->SpawnActor<ASWeapon>(WeaponClass, PlayerTransform, SpawnParameters);
 
-				// If weapon spawn, add it to the loadout
-				if (NewWeapon) {
+			// If weapon spawn, add it to the loadout
+			if (NewWeapon) {
 
-					// If we're currently spawning the first weapon class, we want to set it to active
-					bool bEquipFirstWeapon = (i == 0);
-					bool AddWeaponSuccess = AddWeaponToLoadout(NewWeapon, bEquipFirstWeapon);
+				// If we're currently spawning the first weapon class, we want to set it to active
+				bool bEquipFirstWeapon = (i == 0);
+				bool AddWeaponSuccess = AddWeaponToLoadout(NewWeapon, bEquipFirstWeapon);
+				
+				if (AddWeaponSuccess) {
+
+					bool WeaponCharSetup = SetupWeaponCharacterRelationship(NewWeapon, OwningCharacter);
 					
-					if (AddWeaponSuccess) {
+					// since the success flag is initiated as false, we cannot use AND flags for first equipped weapon
+					if (bEquipFirstWeapon && WeaponCharSetup) {
 
-						bool WeaponCharSetup = SetupWeaponCharacterRelationship(NewWeapon, OwningCharacter);
-						
-						// since Success is initiated as false, we cannot use AND flags for first equipped weapon, plus, tell delegate broadcast which is the initially active slot
-						if (bEquipFirstWeapon && WeaponCharSetup) {
-
-							Success = true;
-							InitialActiveWeaponSlotNumber = (i + 1);
-
-							// We can send nullptr here, all subscribed functions must always have nullptr checks!
-							WeaponChangeDelegate.Broadcast(nullptr, NewWeapon, 1);
-							NewWeapon->RequestSubcomponentBroadcast();
-														
-						}
-						// if it was successful before and is successful still, flag remains true
-						else if (WeaponCharSetup) {
-
-							Success &= WeaponCharSetup;
-							
-						}
-						
-						if (!WeaponCharSetup) {
+						bLoadoutSpawnSuccess = true;
 
-							UE_LOG(LogTemp, Error, TEXT("Error when setting up character-weapon relationship for index %u of Default Weapons"), i);
-							
-						}
+						// We can send nullptr here, all subscribed functions must always have nullptr checks!
+						WeaponChangeDelegate.Broadcast(nullptr, NewWeapon, 1);
+						NewWeapon->RequestSubcomponentBroadcast();
+													
+					}
+					// if it was successful before and is successful still, flag remains true
+					else if (WeaponCharSetup) {
+
+						bLoadoutSpawnSuccess &= WeaponCharSetup;
 						
 					}
-					else {
+					
+					if (!WeaponCharSetup) {
 
-						UE_LOG(LogTemp, Error, TEXT("Error when adding Weapon spawned from index %u of Default Weapons"), i);
-				
+						UE_LOG(LogCoopEquipment, Error, TEXT("Error when setting up character-weapon relationship for index %d of Default Weapons"), i);
+						
 					}
 					
 				}
 				else {
 
-					UE_LOG(LogTemp, Error, TEXT("Weapon has NOT spawned from index %u of Default Weapons, null pointer"), i);
-					
+					UE_LOG(LogCoopEquipment, Error, TEXT("Error when adding Weapon spawned from index %d of Default Weapons"), i);
+			
 				}
-
+				
 			}
 			else {
 
-				UE_LOG(LogTemp, Error, TEXT("Index %u of DefaultWeapons is not set properly, null pointer"), i);
+				UE_LOG(LogCoopEquipment, Error, TEXT("Weapon has NOT spawned from index %d of Default Weapons, null pointer"), i);
 				
 			}
+
+		}
+		else {
+
+			UE_LOG(LogCoopEquipment, Error, TEXT("Index %d of DefaultWeapons is not set properly or failed to load, null pointer"), i);
 			
 		}
 
-		// todo is this code leftover? this is odd
-		// Spawn weapon and attach to player skeletal mesh
-		if (WeaponInSlot1) {
+		if (NextLoadoutSpawnIndex >= NumLoadoutWeapons) {
+
+			FinishLoadoutSpawn();
+
+		}
+		
+	}
+	
+}
+
 
-			WeaponInSlot1->SetOwner(OwningCharacter);
+// Hands the weapons of the loadout over to the given new owner, in slot order, deactivated and detached from the character, and empties the loadout so they can outlive it (server only)
+void USCharacterEquipmentComponent::StowLoadout(AActor* NewOwner, TArray<ASWeapon*>& OutWeapons) {
 
-			// Assign weapon in slot 1 as current weapon by default
-			CurrentWeapon = WeaponInSlot1;
+	OutWeapons.Reset();
 
-			if (CurrentWeapon) {
+	if (GetOwnerRole() == ROLE_Authority) {
+
+		// Whatever was spawned so far is stowed, the rest of the loadout never will be
+		CancelLoadoutSpawn();
+
+		for (ASWeapon* Weapon : WeaponSlots) {
+
+			if (Weapon) {
+
+				ReleaseWeapon(Weapon);
+				Weapon->SetOwner(NewOwner);
+				OutWeapons.Add(Weapon);
 
-				FAttachmentTransformRules AttachRules(EAttachmentRule::SnapToTarget, EAttachmentRule::SnapToTarget, EAttachmentRule::SnapToTarget, true);
-				CurrentWeapon->AttachToComponent(OwningCharacter->GetMesh(), AttachRules, CurrentWeapon->GetCharacterSocketName());
-		
 			}
-		
+
 		}
-		
-	}
 
-	if (Success) {
+		WeaponSlots.Reset();
+		MARK_PROPERTY_DIRTY_FROM_NAME(USCharacterEquipmentComponent, WeaponSlots, this);
+
+		ResetSlotTracking();
+		UpdateReplicatedSlotIndex();
 
-		FLoadoutInfo temp = CreateLoadoutInfo();
-		LoadoutSpawnDelegate.Broadcast(temp, CurrentWeapon, InitialActiveWeaponSlotNumber);
-		
 	}
-	
+
 }
 
 
-// Deactivate the current weapon and change the currently active weapon to the weapon in slot 1
-bool USCharacterEquipmentComponent::ChangeToWeapon1(void) {
+// Takes over the weapons stowed from a previous character instead of spawning the default loadout: attaches them to this character, equips the first one and starts all of them on a fresh ammo state; returns false if none could be equipped (server only, only if the character has no loadout yet)
+bool USCharacterEquipmentComponent::EquipStowedLoadout(const TArray<ASWeapon*>& Weapons) {
 
 	bool Success = false;
+	ASPlayerCharacter* OwningCharacter = Cast<ASPlayerCharacter>(GetOwner());
 
-	if (CurrentWeapon && WeaponInSlot1) {
+	if (GetOwnerRole() == ROLE_Authority && OwningCharacter && !HasLoadout()) {
 
-		// don't change weapons if the requested slot is already active
-		if (CurrentWeapon != WeaponInSlot1) {
-			
-			// Save weapon to be deactivated to be passed to weapon change delegate
-			ASWeapon* PreviousWeapon = CurrentWeapon;
+		bLoadoutSpawnSuccess = false;
 
-			// deactivate current weapon, assign new weapon and activate it
-			bool DeactivateSuccess = CurrentWeapon->DeactivateWeapon();
-			CurrentWeapon = WeaponInSlot1;
-			bool ActivateSuccess = WeaponInSlot1->ActivateWeapon();
+		for (ASWeapon* Weapon : Weapons) {
 
-			Success = (DeactivateSuccess && ActivateSuccess);
+			const bool bEquipWeapon = (WeaponSlots.Num() == 0);
 
-			// if operation was successful, broadcast the previous and new weapons for rebinding
-			if (Success) {
+			if (Weapon && AddWeaponToLoadout(Weapon, bEquipWeapon)) {
+
+				SetupWeaponCharacterRelationship(Weapon, OwningCharacter);
+
+				// A new life for the weapon, exactly as if it had just been spawned
+				Weapon->ResetAmmoState();
+
+				if (bEquipWeapon) {
+
+					bLoadoutSpawnSuccess = true;
+
+					// We can send nullptr here, all subscribed functions must always have nullptr checks!
+					WeaponChangeDelegate.Broadcast(nullptr, Weapon, 1);
+					Weapon->RequestSubcomponentBroadcast();
+
+				}
 
-				WeaponChangeDelegate.Broadcast(PreviousWeapon, CurrentWeapon, 1);
-				// start any automatic actions
-				CurrentWeapon->RequestSubcomponentBroadcast();
-				CurrentWeapon->TriggerAutomaticActions();
-				
 			}
-			
+			// A weapon that doesn't fit the loadout anymore would be left lying around otherwise
+			else if (Weapon) {
+
+				UE_LOG(LogCoopEquipment, Error, TEXT("Stowed weapon %s could not be added to the loadout, destroying it"), *Weapon->GetName());
+				Weapon->Destroy();
+
+			}
+
 		}
-		
-	}
-	else {
-		
-		UE_LOG(LogTemp, Error, TEXT("Nullptr error in change to weapon slot 1"));
-		
+
+		FinishLoadoutSpawn();
+		Success = bLoadoutSpawnSuccess;
+
 	}
 
 	return Success;
+
 }
 
-// Deactivate the current weapon and change the currently active weapon to the weapon in slot 2
-bool USCharacterEquipmentComponent::ChangeToWeapon2(void) {
 
-	bool Success = false;
+// Called once the classes of the weapons after the first one are in memory; starts spawning them, one per frame
+void USCharacterEquipmentComponent::OnLoadoutClassesLoaded() {
 
-	if (CurrentWeapon && WeaponInSlot2) {
+	bLoadoutClassesLoaded = true;
 
-		// don't change weapons if the requested slot is already active
-		if (CurrentWeapon != WeaponInSlot2) {
-			
-			// Save weapon to be deactivated to be passed to weapon change delegate
-			ASWeapon* PreviousWeapon = CurrentWeapon;
+	if (NextLoadoutSpawnIndex < NumLoadoutWeapons) {
 
-			// deactivate current weapon, assign new weapon and activate it
-			bool DeactivateSuccess = CurrentWeapon->DeactivateWeapon();
-			CurrentWeapon = WeaponInSlot2;
-			bool ActivateSuccess = WeaponInSlot2->ActivateWeapon();
+		SetComponentTickEnabled(true);
 
-			Success = (DeactivateSuccess && ActivateSuccess);
+	}
 
-			// if operation was successful, broadcast the previous and new weapons for rebinding
-			if (Success) {
+}
 
-				WeaponChangeDelegate.Broadcast(PreviousWeapon, CurrentWeapon, 2);
-				CurrentWeapon->RequestSubcomponentBroadcast();
-				CurrentWeapon->TriggerAutomaticActions();
-				
-			}
 
-		}
+// Ends the loadout spawn: broadcasts the loadout and the current weapon for the HUD, and starts pre-warming
+void USCharacterEquipmentComponent::FinishLoadoutSpawn() {
+
+	SetComponentTickEnabled(false);
+	FirstWeaponLoadHandle.Reset();
+	LoadoutLoadHandle.Reset();
+
+	// Every weapon was already attached and the first one activated as it was added, the player may even have switched weapons while the rest of the loadout was spawning
+	if (bLoadoutSpawnSuccess) {
+
+		FLoadoutInfo temp = CreateLoadoutInfo();
+		LoadoutSpawnDelegate.Broadcast(temp, CurrentWeapon, CurrentSlotIndex + 1);
 		
 	}
-	else {
-		
-		UE_LOG(LogTemp, Error, TEXT("Nullptr error in change to weapon slot 2"));
-		
+
+	RequestPrewarm();
+
+}
+
+
+// Stops a loadout spawn still underway, dropping the classes still being loaded
+void USCharacterEquipmentComponent::CancelLoadoutSpawn() {
+
+	if (FirstWeaponLoadHandle.IsValid()) {
+
+		FirstWeaponLoadHandle->CancelHandle();
+		FirstWeaponLoadHandle.Reset();
+
+	}
+
+	if (LoadoutLoadHandle.IsValid()) {
+
+		LoadoutLoadHandle->CancelHandle();
+		LoadoutLoadHandle.Reset();
+
+	}
+
+	NumLoadoutWeapons = NextLoadoutSpawnIndex;
+
+}
+
+
+// Returns true if the character has weapons or some are being spawned
+bool USCharacterEquipmentComponent::HasLoadout() const {
+
+	return WeaponSlots.Num() > 0 || NextLoadoutSpawnIndex < NumLoadoutWeapons;
+
+}
+
+
+// Deactivates a weapon leaving the loadout and detaches it from the character
+void USCharacterEquipmentComponent::ReleaseWeapon(ASWeapon* Weapon) {
+
+	if (Weapon) {
+
+		Weapon->DeactivateWeapon();
+		Weapon->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+		Weapon->WeaponOwner = nullptr;
+
+	}
+
+}
+
+
+// Forgets the current, last and pre-warmed slots, once the loadout has been emptied
+void USCharacterEquipmentComponent::ResetSlotTracking() {
+
+	CurrentWeapon = nullptr;
+	CurrentSlotIndex = INDEX_NONE;
+	LastSlotIndex = INDEX_NONE;
+	LastSwitchDirection = 0;
+	PrewarmedSlotIndex = INDEX_NONE;
+	bPrewarmPending = false;
+
+}
+
+
+// Asks for the predicted weapon to be pre-warmed on the next frame, keeping the switch frame free of it
+void USCharacterEquipmentComponent::RequestPrewarm() {
+
+	if (bPrewarmPredictedWeapon) {
+
+		bPrewarmPending = true;
+		SetComponentTickEnabled(true);
+
 	}
 
-	return Success;
 }
 
 
+// Returns the slot most likely to be switched to next: the next one in the direction of the last scroll, the last weapon otherwise; INDEX_NONE if there is no other weapon
+int32 USCharacterEquipmentComponent::PredictNextSlot() const {
+
+	const int32 NumWeapons = WeaponSlots.Num();
+	int32 PredictedSlotIndex = INDEX_NONE;
+
+	if (NumWeapons > 1 && CurrentSlotIndex != INDEX_NONE) {
+
+		// someone scrolling through the weapons keeps scrolling the same way
+		if (LastSwitchDirection != 0) {
+
+			PredictedSlotIndex = (CurrentSlotIndex + NumWeapons + LastSwitchDirection) % NumWeapons;
+
+		}
+		// otherwise, the most likely switch is back to the weapon used before
+		else if (WeaponSlots.IsValidIndex(LastSlotIndex)) {
+
+			PredictedSlotIndex = LastSlotIndex;
+
+		}
+		else {
+
+			PredictedSlotIndex = (CurrentSlotIndex + 1) % NumWeapons;
+
+		}
+
+	}
+
+	return PredictedSlotIndex;
+
+}
+
+
+// Pre-warms the weapon in the predicted slot, and puts the one pre-warmed before it back to sleep if the prediction changed
+void USCharacterEquipmentComponent::PrewarmPredictedWeapon() {
+
+	const int32 PredictedSlotIndex = PredictNextSlot();
+
+	if (PredictedSlotIndex != PrewarmedSlotIndex) {
 
-// Deactivate the current weapon and change the currently active weapon to the weapon in slot 3
-bool USCharacterEquipmentComponent::ChangeToWeapon3(void) {
+		if (ASWeapon* PrewarmedWeapon = GetWeaponInSlot(PrewarmedSlotIndex)) {
+
+			PrewarmedWeapon->CoolDownWeapon();
+
+		}
+
+		ASWeapon* PredictedWeapon = GetWeaponInSlot(PredictedSlotIndex);
+		PrewarmedSlotIndex = PredictedWeapon ? PredictedSlotIndex : INDEX_NONE;
+
+		if (PredictedWeapon) {
+
+			PredictedWeapon->PrewarmWeapon();
+
+		}
+
+	}
+
+}
+
+
+// Deactivate the current weapon and change the currently active weapon to the weapon in the given slot (index 0 is slot 1)
+bool USCharacterEquipmentComponent::ChangeToWeaponSlot(int32 SlotIndex) {
 
 	bool Success = false;
 
-	if (CurrentWeapon && WeaponInSlot3) {
+	if (CurrentWeapon && WeaponSlots.IsValidIndex(SlotIndex) && WeaponSlots[SlotIndex]) {
+
+		ASWeapon* NewWeapon = WeaponSlots[SlotIndex];
 
 		// don't change weapons if the requested slot is already active
-		if (CurrentWeapon != WeaponInSlot3) {
-		
+		if (CurrentWeapon != NewWeapon) {
+			
 			// Save weapon to be deactivated to be passed to weapon change delegate
 			ASWeapon* PreviousWeapon = CurrentWeapon;
 
 			// deactivate current weapon, assign new weapon and activate it
 			bool DeactivateSuccess = CurrentWeapon->DeactivateWeapon();
-			CurrentWeapon = WeaponInSlot3;
-			bool ActivateSuccess = WeaponInSlot3->ActivateWeapon();
+			CurrentWeapon = NewWeapon;
+			bool ActivateSuccess = NewWeapon->ActivateWeapon();
+
+			// the weapon that was active is the one a quick switch goes back to
+			LastSlotIndex = CurrentSlotIndex;
+			CurrentSlotIndex = SlotIndex;
+			LastSwitchDirection = 0;
+
+			// the pre-warmed weapon is now in use, a new prediction is warmed up next frame
+			if (PrewarmedSlotIndex == SlotIndex) {
+
+				PrewarmedSlotIndex = INDEX_NONE;
+
+			}
+
+			RequestPrewarm();
 
 			Success = (DeactivateSuccess && ActivateSuccess);
 
 			// if operation was successful, broadcast the previous and new weapons for rebinding
 			if (Success) {
 
-				WeaponChangeDelegate.Broadcast(PreviousWeapon, CurrentWeapon, 3);
+				// The owning client doesn't wait for the server to switch, the server only follows it
+				if (GetOwnerRole() == ROLE_AutonomousProxy && !bRestoringServerSlot) {
+
+					ServerChangeToWeaponSlot(SlotIndex, ++LastSlotSwitchKey);
+
+				}
+
+				UpdateReplicatedSlotIndex();
+
+				const uint8 SlotNumber = SlotIndex + 1;
+				WeaponChangeDelegate.Broadcast(PreviousWeapon, CurrentWeapon, SlotNumber);
+				COOP_TRACE_WEAPON(WeaponSwitched, CurrentWeapon, SlotNumber);
+				// start any automatic actions
 				CurrentWeapon->RequestSubcomponentBroadcast();
-				CurrentWeapon->TriggerAutomaticActions();				
+				CurrentWeapon->TriggerAutomaticActions();
 				
 			}
 			
@@ -250,7 +502,7 @@ bool USCharacterEquipmentComponent::ChangeToWeapon3(void) {
 	}
 	else {
 		
-		UE_LOG(LogTemp, Error, TEXT("Nullptr error in change to weapon slot 3"));
+		UE_LOG(LogCoopEquipment, Error, TEXT("Nullptr error in change to weapon slot %d"), SlotIndex + 1);
 		
 	}
 
@@ -259,6 +511,78 @@ bool USCharacterEquipmentComponent::ChangeToWeapon3(void) {
 }
 
 
+// Deactivate the current weapon and change the currently active weapon to the weapon in the next slot, wrapping around
+bool USCharacterEquipmentComponent::ChangeToNextWeapon(void) {
+
+	// slots are compact, so the next slot always holds a weapon
+	const int32 NumWeapons = WeaponSlots.Num();
+
+	const bool Success = (NumWeapons > 0 && CurrentSlotIndex != INDEX_NONE) ? ChangeToWeaponSlot((CurrentSlotIndex + 1) % NumWeapons) : false;
+
+	// remembered for the prediction of the next switch, which only happens next frame
+	if (Success) {
+
+		LastSwitchDirection = 1;
+
+	}
+
+	return Success;
+	
+}
+
+
+// Deactivate the current weapon and change the currently active weapon to the weapon in the previous slot, wrapping around
+bool USCharacterEquipmentComponent::ChangeToPreviousWeapon(void) {
+
+	// slots are compact, so the previous slot always holds a weapon
+	const int32 NumWeapons = WeaponSlots.Num();
+
+	const bool Success = (NumWeapons > 0 && CurrentSlotIndex != INDEX_NONE) ? ChangeToWeaponSlot((CurrentSlotIndex + NumWeapons - 1) % NumWeapons) : false;
+
+	// remembered for the prediction of the next switch, which only happens next frame
+	if (Success) {
+
+		LastSwitchDirection = -1;
+
+	}
+
+	return Success;
+	
+}
+
+
+// Deactivate the current weapon and change the currently active weapon back to the one that was active before it
+bool USCharacterEquipmentComponent::ChangeToLastWeapon(void) {
+
+	return ChangeToWeaponSlot(LastSlotIndex);
+	
+}
+
+
+// Returns the maximum number of weapons in the loadout
+int32 USCharacterEquipmentComponent::GetMaxWeaponSlots(void) const {
+
+	return MaxWeaponSlots;
+	
+}
+
+
+// Returns the weapon in the given slot (index 0 is slot 1), nullptr if there is none
+ASWeapon* USCharacterEquipmentComponent::GetWeaponInSlot(int32 SlotIndex) const {
+
+	return WeaponSlots.IsValidIndex(SlotIndex) ? WeaponSlots[SlotIndex] : nullptr;
+	
+}
+
+
+// Returns the slot of the currently active weapon, INDEX_NONE if there is none
+int32 USCharacterEquipmentComponent::GetCurrentSlotIndex(void) const {
+
+	return CurrentSlotIndex;
+	
+}
+
+
 
 // Execute the pressing action of the currently active weapon's primary action
 void USCharacterEquipmentComponent::PerformCurrentWeaponPrimaryActionPress(void) {
@@ -323,6 +647,214 @@ void USCharacterEquipmentComponent::ReloadCurrentWeapon() {
 }
 
 
+// Takes a snapshot of the ammo state of every slot (index 0 is slot 1), empty snapshots for empty slots or weapons without ammo
+void USCharacterEquipmentComponent::CaptureLoadoutAmmo(TArray<FSAmmoSnapshot>& OutSnapshots) {
+
+	OutSnapshots.Reset();
+	OutSnapshots.AddDefaulted(MaxWeaponSlots);
+
+	for (int32 SlotIndex = 0; SlotIndex < WeaponSlots.Num(); ++SlotIndex) {
+
+		if (WeaponSlots[SlotIndex]) {
+
+			WeaponSlots[SlotIndex]->CaptureAmmoSnapshot(OutSnapshots[SlotIndex]);
+
+		}
+
+	}
+
+}
+
+
+// Restores the ammo state of every slot from snapshots taken with CaptureLoadoutAmmo(); returns false if any of them didn't fit its slot's weapon
+bool USCharacterEquipmentComponent::RestoreLoadoutAmmo(const TArray<FSAmmoSnapshot>& Snapshots) {
+
+	bool Success = true;
+
+	for (int32 SlotIndex = 0; SlotIndex < WeaponSlots.Num() && SlotIndex < Snapshots.Num(); ++SlotIndex) {
+
+		// Empty snapshots (empty slot or no ammo when captured) leave the slot's weapon as it is
+		if (WeaponSlots[SlotIndex] && Snapshots[SlotIndex].ReloadType != 0) {
+
+			Success &= WeaponSlots[SlotIndex]->RestoreAmmoSnapshot(Snapshots[SlotIndex]);
+
+		}
+
+	}
+
+	return Success;
+
+}
+
+
+// Registers the replicated loadout and current slot (pushed when dirty)
+void USCharacterEquipmentComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const {
+
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(USCharacterEquipmentComponent, WeaponSlots, Params);
+
+	// The owning client makes its own switches, the server's current slot would only drag it back (a switch the server refuses is undone through ClientRestoreWeaponSlot instead)
+	Params.Condition = COND_SkipOwner;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(USCharacterEquipmentComponent, ReplicatedSlotIndex, Params);
+
+}
+
+
+// Copies the current slot into its replicated counterpart and marks it dirty if it changed (server only)
+void USCharacterEquipmentComponent::UpdateReplicatedSlotIndex() {
+
+	if (GetOwnerRole() == ROLE_Authority && ReplicatedSlotIndex != CurrentSlotIndex) {
+
+		ReplicatedSlotIndex = CurrentSlotIndex;
+		MARK_PROPERTY_DIRTY_FROM_NAME(USCharacterEquipmentComponent, ReplicatedSlotIndex, this);
+
+	}
+
+}
+
+
+// Lets go of the weapons that left the loadout, sets up the ones that arrived from the server and broadcasts the loadout for the HUD once every slot has arrived (clients only)
+void USCharacterEquipmentComponent::OnRep_WeaponSlots(const TArray<ASWeapon*>& PreviousWeaponSlots) {
+
+	ASPlayerCharacter* OwningCharacter = Cast<ASPlayerCharacter>(GetOwner());
+	bool bLostCurrentWeapon = false;
+
+	// Weapons stowed when the character died, unless the player's next character already took them over
+	for (ASWeapon* Weapon : PreviousWeaponSlots) {
+
+		if (Weapon && Weapon->WeaponOwner == OwningCharacter && !WeaponSlots.Contains(Weapon)) {
+
+			bLostCurrentWeapon |= (Weapon == CurrentWeapon);
+			ReleaseWeapon(Weapon);
+
+		}
+
+	}
+
+	if (bLostCurrentWeapon) {
+
+		ResetSlotTracking();
+
+	}
+
+	// The loadout only grows while the server spawns it, so this happens once per weapon at most
+	if (ApplyReplicatedLoadout() && CurrentWeapon) {
+
+		bLoadoutSpawnSuccess = true;
+		LoadoutSpawnDelegate.Broadcast(CreateLoadoutInfo(), CurrentWeapon, CurrentSlotIndex + 1);
+
+	}
+
+}
+
+
+// Switches to the current slot of the server (clients other than the owning one)
+void USCharacterEquipmentComponent::OnRep_ReplicatedSlotIndex() {
+
+	ApplyReplicatedLoadout();
+
+}
+
+
+// Attaches the weapons that arrived from the server to the character and equips the server's current weapon if this client follows it; returns true if every slot has arrived (clients only)
+bool USCharacterEquipmentComponent::ApplyReplicatedLoadout() {
+
+	ASPlayerCharacter* OwningCharacter = Cast<ASPlayerCharacter>(GetOwner());
+	bool bEverySlotArrived = (WeaponSlots.Num() > 0);
+
+	if (OwningCharacter) {
+
+		for (ASWeapon* Weapon : WeaponSlots) {
+
+			// A weapon that hasn't replicated yet is null for now, this is called again once it has
+			if (!Weapon) {
+
+				bEverySlotArrived = false;
+
+			}
+			else if (Weapon->WeaponOwner != OwningCharacter) {
+
+				SetupWeaponCharacterRelationship(Weapon, OwningCharacter);
+
+				if (Weapon != CurrentWeapon) {
+
+					Weapon->DeactivateWeapon();
+
+				}
+
+			}
+
+		}
+
+		// The owning client only takes the server's weapon to get armed, every switch after that is its own
+		ASWeapon* ServerWeapon = GetWeaponInSlot(ReplicatedSlotIndex);
+		const bool bFollowsServer = !CurrentWeapon || !OwningCharacter->IsLocallyControlled();
+
+		if (ServerWeapon && bFollowsServer && ServerWeapon != CurrentWeapon) {
+
+			if (CurrentWeapon) {
+
+				ChangeToWeaponSlot(ReplicatedSlotIndex);
+
+			}
+			else {
+
+				ServerWeapon->ActivateWeapon();
+				CurrentWeapon = ServerWeapon;
+				CurrentSlotIndex = ReplicatedSlotIndex;
+
+				// We can send nullptr here, all subscribed functions must always have nullptr checks!
+				WeaponChangeDelegate.Broadcast(nullptr, CurrentWeapon, CurrentSlotIndex + 1);
+				CurrentWeapon->RequestSubcomponentBroadcast();
+				RequestPrewarm();
+
+			}
+
+		}
+
+	}
+
+	return bEverySlotArrived;
+
+}
+
+
+// Applies a weapon switch already made by the owning client, sending it back to the server's slot if the server can't follow
+void USCharacterEquipmentComponent::ServerChangeToWeaponSlot_Implementation(int32 SlotIndex, int32 SwitchKey) {
+
+	LastSlotSwitchKey = SwitchKey;
+
+	// The owning client doesn't get the replicated slot, so it has to be told when it's on a weapon the server isn't
+	if (!ChangeToWeaponSlot(SlotIndex) && CurrentSlotIndex != SlotIndex && WeaponSlots.IsValidIndex(CurrentSlotIndex)) {
+
+		UE_LOG(LogCoopEquipment, Warning, TEXT("Weapon switch to slot %d refused by the server, owning client sent back to slot %d"), SlotIndex, CurrentSlotIndex);
+		ClientRestoreWeaponSlot(CurrentSlotIndex, SwitchKey);
+
+	}
+
+}
+
+
+// Takes the owning client back to the server's current slot after the server refused one of its switches, unless the client made another switch since
+void USCharacterEquipmentComponent::ClientRestoreWeaponSlot_Implementation(int32 SlotIndex, int32 SwitchKey) {
+
+	// A later switch is still on its way to the server, which either follows it or refuses it too
+	if (SwitchKey == LastSlotSwitchKey) {
+
+		bRestoringServerSlot = true;
+		ChangeToWeaponSlot(SlotIndex);
+		bRestoringServerSlot = false;
+
+	}
+
+}
+
+
 // Called when the game starts
 void USCharacterEquipmentComponent::BeginPlay() {
 
@@ -331,6 +863,63 @@ void USCharacterEquipmentComponent::BeginPlay() {
 }
 
 
+// Called when the component is removed from play; drops any loadout still being loaded, and destroys the weapons still in the loadout along with the character (server only)
+void USCharacterEquipmentComponent::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+
+	CancelLoadoutSpawn();
+
+	// Stowed weapons were taken out of the loadout already, whatever is left has no one to go to
+	if (EndPlayReason == EEndPlayReason::Destroyed && GetOwnerRole() == ROLE_Authority) {
+
+		for (ASWeapon* Weapon : WeaponSlots) {
+
+			if (Weapon) {
+
+				Weapon->Destroy();
+
+			}
+
+		}
+
+	}
+
+	Super::EndPlay(EndPlayReason);
+
+}
+
+
+// Called every frame while the loadout is being spawned or a pre-warm is pending; spawns one weapon per frame, in slot order, then pre-warms the predicted weapon
+void USCharacterEquipmentComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) {
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (NextLoadoutSpawnIndex < NumLoadoutWeapons) {
+
+		// The first weapon has the slot 1 and must be spawned before the others, wait for it if it's still loading
+		if (bLoadoutClassesLoaded && NextLoadoutSpawnIndex > 0) {
+
+			SpawnNextLoadoutWeapon();
+
+		}
+
+	}
+	// The switch frame is over, the predicted weapon is warmed up on this one
+	else if (bPrewarmPending) {
+
+		bPrewarmPending = false;
+		SetComponentTickEnabled(false);
+		PrewarmPredictedWeapon();
+
+	}
+	else {
+
+		SetComponentTickEnabled(false);
+
+	}
+
+}
+
+
 // Adds a new weapon to the loadout. Returns false if the weapon already exists in the inventory, true if it's a new weapon.
 bool USCharacterEquipmentComponent::AddWeaponToLoadout(ASWeapon* NewWeapon, bool bActivateFirstWeapon) {
 
@@ -347,9 +936,11 @@ bool USCharacterEquipmentComponent::AddWeaponToLoadout(ASWeapon* NewWeapon, bool
 				
 				NewWeapon->ActivateWeapon();
 				CurrentWeapon = NewWeapon;
+				CurrentSlotIndex = WeaponSlots.Num() - 1;
+				UpdateReplicatedSlotIndex();
 				
 			}
-			// Deactivate weapon if it's the second or third weapons
+			// Deactivate weapon if it's not the first weapon
 			else {
 				
 				NewWeapon->DeactivateWeapon();
@@ -362,14 +953,14 @@ bool USCharacterEquipmentComponent::AddWeaponToLoadout(ASWeapon* NewWeapon, bool
 
 		else {
 
-			UE_LOG(LogTemp, Error, TEXT("Could not add weapon to slot"));
+			UE_LOG(LogCoopEquipment, Error, TEXT("Could not add weapon to slot"));
 	
 		}
 		
 	}
 	else {
 		
-		UE_LOG(LogTemp, Error, TEXT("Weapon cannot be added, a weapon of the same type already exists in the loadout"));
+		UE_LOG(LogCoopEquipment, Error, TEXT("Weapon cannot be added, a weapon of the same type already exists in the loadout"));
 		
 	}
 	
@@ -382,13 +973,8 @@ bool USCharacterEquipmentComponent::AddWeaponToLoadout(ASWeapon* NewWeapon, bool
 bool USCharacterEquipmentComponent::CanNewWeaponBeAdded(ASWeapon* NewWeapon) {
 
 
-	// Check if a weapon of the same class is already in the loadout
-	bool SameWeaponInSlot1 = (NewWeapon && WeaponInSlot1 && (NewWeapon->GetClass() == WeaponInSlot1->GetClass()));
-	bool SameWeaponInSlot2 = (NewWeapon && WeaponInSlot2 && (NewWeapon->GetClass() == WeaponInSlot2->GetClass()));
-	bool SameWeaponInSlot3 = (NewWeapon && WeaponInSlot3 && (NewWeapon->GetClass() == WeaponInSlot3->GetClass()));
-
-	// Return true if there is no weapon of the same type in slots 1, 2 or 3
-	return (!SameWeaponInSlot1 && !SameWeaponInSlot2 && !SameWeaponInSlot3);
+	// Return true if there is no weapon of the same class in any slot (only done when the loadout is built)
+	return !(NewWeapon && WeaponSlots.ContainsByPredicate([NewWeapon](const ASWeapon* Weapon) { return Weapon && Weapon->GetClass() == NewWeapon->GetClass(); }));
 	
 }
 
@@ -398,24 +984,11 @@ bool USCharacterEquipmentComponent::FindAndAddWeaponToSlot(ASWeapon* NewWeapon)
 
 	bool Success = false;
 
-	// Check slot 1 and add if possible
-	if (!WeaponInSlot1) {
+	// Slots are compact, the first open slot is always the one after the last weapon
+	if (NewWeapon && WeaponSlots.Num() < MaxWeaponSlots) {
 	
-		WeaponInSlot1 = NewWeapon;
-		Success = true;
-
-	}
-	// Check slot 2 and add if possible
-	else if (!WeaponInSlot2) {
-
-		WeaponInSlot2 = NewWeapon;
-		Success = true;
-
-	}
-	// Check slot 3 and add if possible
-	else if (!WeaponInSlot3) {
-
-		WeaponInSlot3 = NewWeapon;
+		WeaponSlots.Add(NewWeapon);
+		MARK_PROPERTY_DIRTY_FROM_NAME(USCharacterEquipmentComponent, WeaponSlots, this);
 		Success = true;
 
 	}
@@ -451,30 +1024,19 @@ bool USCharacterEquipmentComponent::SetupWeaponCharacterRelationship(ASWeapon* N
 
 FLoadoutInfo USCharacterEquipmentComponent::CreateLoadoutInfo() const {
 
-	FLoadoutInfo temp;
+	// One entry per slot, the ones past the last weapon staying unequipped
+	FLoadoutInfo temp(MaxWeaponSlots);
 
-	// Set-up Weapon 1 info
-	if (WeaponInSlot1) {
-		
-		temp.Weapon1Info.IsEquipped = true;
-		temp.Weapon1Info.EquipmentShortName = WeaponInSlot1->GetWeaponShortName();
-		temp.Weapon1Info.EquipmentSlot = 1;
-		
-	}
-	// Set-up Weapon 2 info
-	if (WeaponInSlot2) {
-		
-		temp.Weapon2Info.IsEquipped = true;
-		temp.Weapon2Info.EquipmentShortName = WeaponInSlot2->GetWeaponShortName();
-		temp.Weapon2Info.EquipmentSlot = 2;
-		
-	}
-	// Set-up Weapon 3 info
-	if (WeaponInSlot3) {
+	// Set-up info of every weapon
+	for (int32 SlotIndex = 0; SlotIndex < WeaponSlots.Num(); ++SlotIndex) {
+
+		if (WeaponSlots[SlotIndex]) {
 		
-		temp.Weapon3Info.IsEquipped = true;
-		temp.Weapon3Info.EquipmentShortName = WeaponInSlot3->GetWeaponShortName();
-		temp.Weapon3Info.EquipmentSlot = 3;
+			temp.WeaponInfos[SlotIndex].IsEquipped = true;
+			temp.WeaponInfos[SlotIndex].EquipmentShortName = WeaponSlots[SlotIndex]->GetWeaponShortName();
+			temp.WeaponInfos[SlotIndex].EquipmentSlot = SlotIndex + 1;
+
+		}
 		
 	}
 	// Set-up skill info (placeholder, no skills implemented)
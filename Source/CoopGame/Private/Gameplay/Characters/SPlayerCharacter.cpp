@@ -10,7 +10,9 @@
 #include "GameFramework/SpringArmComponent.h"
 #include "Gameplay/Characters/Components/SCharacterEquipmentComponent.h"
 #include "Gameplay/Characters/Components/SAttributesComponent.h"
+#include "General/SCharacterPlayerController.h"
 #include "CoopGame/CoopGame.h"
+#include "General/SLogCategories.h"
 
 
 
@@ -85,10 +87,20 @@ void ASPlayerCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCo
 	// Bind Jump
 	PlayerInputComponent->BindAction("Jump", IE_Pressed, this, &ASPlayerCharacter::Jump);
 
-	// Bind Weapon Switches
-	PlayerInputComponent->BindAction("WeaponSlot1", IE_Pressed, this, &ASPlayerCharacter::ChangetoWeaponSlot1);
-	PlayerInputComponent->BindAction("WeaponSlot2", IE_Pressed, this, &ASPlayerCharacter::ChangetoWeaponSlot2);
-	PlayerInputComponent->BindAction("WeaponSlot3", IE_Pressed, this, &ASPlayerCharacter::ChangetoWeaponSlot3);
+	// Bind Weapon Switches, one "WeaponSlotN" action per slot of the loadout, all going to the same handler with their slot index
+	const int32 NumWeaponSlots = CharEquipComp ? CharEquipComp->GetMaxWeaponSlots() : 0;
+
+	for (int32 SlotIndex = 0; SlotIndex < NumWeaponSlots; ++SlotIndex) {
+
+		FInputActionBinding SlotBinding(*FString::Printf(TEXT("WeaponSlot%d"), SlotIndex + 1), IE_Pressed);
+		SlotBinding.ActionDelegate.GetDelegateForManualSet().BindUObject(this, &ASPlayerCharacter::ChangeToWeaponSlot, SlotIndex);
+		PlayerInputComponent->AddActionBinding(SlotBinding);
+
+	}
+
+	PlayerInputComponent->BindAction("NextWeapon", IE_Pressed, this, &ASPlayerCharacter::ChangeToNextWeapon);
+	PlayerInputComponent->BindAction("PreviousWeapon", IE_Pressed, this, &ASPlayerCharacter::ChangeToPreviousWeapon);
+	PlayerInputComponent->BindAction("LastWeapon", IE_Pressed, this, &ASPlayerCharacter::ChangeToLastWeapon);
 
 	
 	// Bind Mouse Button Press & Release
@@ -127,12 +139,6 @@ void ASPlayerCharacter::BeginPlay() {
 
 	DefaultFOV = CameraComp->FieldOfView;
 
-	if (CharEquipComp) {
-
-		CharEquipComp->SpawnDefaultLoadout();
-		
-	}
-
 	if (StatsComp) {
 
 		StatsComp->HPChangedDelegate.AddDynamic(this, &ASPlayerCharacter::OnHPChanged);
@@ -142,6 +148,27 @@ void ASPlayerCharacter::BeginPlay() {
 }
 
 
+// Called when a controller takes the character (server only); hands it the weapons of the player's previous character, or spawns its default loadout if there are none
+void ASPlayerCharacter::PossessedBy(AController* NewController) {
+
+	Super::PossessedBy(NewController);
+
+	if (CharEquipComp) {
+
+		ASCharacterPlayerController* PlayerController = Cast<ASCharacterPlayerController>(NewController);
+
+		// a character that already has a loadout keeps it, see SpawnDefaultLoadout
+		if (!PlayerController || !PlayerController->UnstowLoadout(CharEquipComp)) {
+
+			CharEquipComp->SpawnDefaultLoadout();
+
+		}
+
+	}
+
+}
+
+
 // Called when "Move Forward" or "Move Backward" keys are pressed; "Move Forward" -> Value = 1.0f, "Move Backward" -> Value = -1.0f
 void ASPlayerCharacter::MoveForward(float Value) {
 
@@ -182,25 +209,22 @@ void ASPlayerCharacter::Jump() {
 }
 
 
-// Called when "WeaponSlot1" key is pressed
-void ASPlayerCharacter::ChangetoWeaponSlot1(void) {
+// Called when one of the "WeaponSlotN" keys is pressed, with the index of its slot (index 0 is "WeaponSlot1")
+void ASPlayerCharacter::ChangeToWeaponSlot(int32 SlotIndex) {
+
+	UE_LOG(LogCoopEquipment, Verbose, TEXT("Switch to Weapon %d requested"), SlotIndex + 1);
 
 	bool Success = false;
 	
 	if (CharEquipComp) {
 
-		Success = CharEquipComp->ChangeToWeapon1();
+		// broadcast is done in the equipment manager
+		Success = CharEquipComp->ChangeToWeaponSlot(SlotIndex);
 
-		// request weapon info update for HUD if change successful
-		if (Success) {
-
-			// broadcast is done in the equipment manager
-		
-		}
 		// log if there were problems
-		else {
+		if (!Success) {
 		
-			UE_LOG(LogTemp, Error, TEXT("Change to weapon slot 1 unsuccessful, problem with previous weapon deactivation or new weapon activation"))
+			UE_LOG(LogCoopEquipment, Error, TEXT("Change to weapon slot %d unsuccessful, problem with previous weapon deactivation or new weapon activation"), SlotIndex + 1);
 		
 		}
 		
@@ -209,54 +233,36 @@ void ASPlayerCharacter::ChangetoWeaponSlot1(void) {
 }
 
 
-// Called when "WeaponSlot2" key is pressed
-void ASPlayerCharacter::ChangetoWeaponSlot2(void) {
+// Called when "NextWeapon" key is pressed
+void ASPlayerCharacter::ChangeToNextWeapon(void) {
 
-	bool Success = false;
-	
 	if (CharEquipComp) {
 
-		Success = CharEquipComp->ChangeToWeapon2();
-
-		// request weapon info update for HUD if change successful
-		if (Success) {
-
-			// broadcast is done in the equipment manager
-		
-		}
-		// log if there were problems
-		else {
-		
-			UE_LOG(LogTemp, Error, TEXT("Change to weapon slot 2 unsuccessful, problem with previous weapon deactivation or new weapon activation"))
-		
-		}
+		CharEquipComp->ChangeToNextWeapon();
 		
 	}
 	
 }
 
 
-// Called when "WeaponSlot3" key is pressed
-void ASPlayerCharacter::ChangetoWeaponSlot3(void) {
+// Called when "PreviousWeapon" key is pressed
+void ASPlayerCharacter::ChangeToPreviousWeapon(void) {
 
-	bool Success = false;
-	
 	if (CharEquipComp) {
 
-		Success = CharEquipComp->ChangeToWeapon3();
+		CharEquipComp->ChangeToPreviousWeapon();
+		
+	}
 	
-		// request weapon info update for HUD if change successful
-		if (Success) {
+}
 
-			// broadcast is done in the equipment manager
-		
-		}
-		// log if there were problems
-		else {
-		
-			UE_LOG(LogTemp, Error, TEXT("Change to weapon slot 3 unsuccessful, problem with previous weapon deactivation or new weapon activation"))
-		
-		}
+
+// Called when "LastWeapon" key is pressed
+void ASPlayerCharacter::ChangeToLastWeapon(void) {
+
+	if (CharEquipComp) {
+
+		CharEquipComp->ChangeToLastWeapon();
 		
 	}
 	
@@ -324,29 +330,6 @@ void ASPlayerCharacter::ReloadPressed() {
 }
 
 
-// Called when "WeaponSlot1" is pressed
-void ASPlayerCharacter::ChangeToWeaponSlot1() {
-
-	UE_LOG(LogTemp, Log, TEXT("Switch to Weapon 1 requested"));
-	
-}
-
-
-// Called when "WeaponSlot2" is pressed
-void ASPlayerCharacter::ChangeToWeaponSlot2() {
-
-	UE_LOG(LogTemp, Log, TEXT("Switch to Weapon 2 requested"));
-	
-}
-
-// Called when "WeaponSlot3" is pressed
-void ASPlayerCharacter::ChangeToWeaponSlot3() {
-
-	UE_LOG(LogTemp, Log, TEXT("Switch to Weapon 3 requested"));
-	
-}
-
-
 // Called when a health change has been detected by the attribute component
 void ASPlayerCharacter::OnHPChanged(USAttributesComponent* AttrComp, float CurrentHP, float DeltaHP
 	, const UDamageType* DamageType, AController* InstigatedBy, AActor* DamageCauser) {
@@ -359,6 +342,15 @@ void ASPlayerCharacter::OnHPChanged(USAttributesComponent* AttrComp, float Curre
 		GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 		GetMesh()->SetCollisionResponseToChannel(COLLISION_WEAPON, ECR_Ignore);
 
+		// the weapons outlive the character, the player's next character takes them over
+		ASCharacterPlayerController* PlayerController = Cast<ASCharacterPlayerController>(GetController());
+
+		if (PlayerController && HasAuthority()) {
+
+			PlayerController->StowLoadout(CharEquipComp);
+
+		}
+
 		DetachFromControllerPendingDestroy();
 
 		SetLifeSpan(10.0f);
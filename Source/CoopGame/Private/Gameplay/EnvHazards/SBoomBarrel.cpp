@@ -12,6 +12,7 @@
 #include "HAL/IConsoleManager.h"
 #include "DrawDebugHelpers.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "General/SCosmeticEffectsSubsystem.h"
 
 
 
@@ -90,7 +91,9 @@ void ASBoomBarrel::Explode(AController* InstigatedBy) {
 	IConsoleVariable* debugDrawVariable =
 		IConsoleManager::Get().FindConsoleVariable(TEXT("COOP.DebugWeapons"));
 
-	if (debugDrawVariable && debugDrawVariable->GetInt() > 0) {
+	const bool bPlayCosmetics = USCosmeticEffectsSubsystem::AreCosmeticsEnabled(GetWorld());
+
+	if (bPlayCosmetics && debugDrawVariable && debugDrawVariable->GetInt() > 0) {
 
 		DrawDebugSphere(GetWorld(), GetActorLocation(), ExplosionRadius, 12, FColor::Red, false, 5.0f, 0, 0);
 
@@ -104,7 +107,11 @@ void ASBoomBarrel::Explode(AController* InstigatedBy) {
 
 	}
 
-	PlayExplosionEffects();
+	if (bPlayCosmetics) {
+
+		PlayExplosionEffects();
+
+	}
 
 }
 
@@ -112,10 +119,11 @@ void ASBoomBarrel::Explode(AController* InstigatedBy) {
 // Function that triggers the emitting of the particle effects and sound effects on explosion
 void ASBoomBarrel::PlayExplosionEffects() {
 
-	if (ExplosionParticle) {
+	USCosmeticEffectsSubsystem* CosmeticsSubsystem = GetWorld()->GetSubsystem<USCosmeticEffectsSubsystem>();
+	if (ExplosionParticle && CosmeticsSubsystem) {
 
-		UParticleSystemComponent* ExplosionVFX = UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplosionParticle, GetActorLocation(), GetActorRotation());
-		ExplosionVFX->SetWorldScale3D(ExplosionParticleScale);
+		// Explosions are the most important feedback there is, they're only dropped if nobody can see them
+		CosmeticsSubsystem->SpawnEmitterAtLocation(ExplosionParticle, GetActorLocation(), GetActorRotation(), ExplosionParticleScale, UCosmeticEffectPriority::High);
 
 	}
 
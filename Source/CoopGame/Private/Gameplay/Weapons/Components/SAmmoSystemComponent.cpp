@@ -3,128 +3,400 @@
 
 
 #include "Gameplay/Weapons/Components/SAmmoSystemComponent.h"
-#include "TimerManager.h"
+#include "Gameplay/Weapons/SWeaponDefinition.h"
+#include "GameFramework/Pawn.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "General/SLogCategories.h"
+#include "General/SWeaponTrace.h"
+
+
+
+// How far back in time (in seconds) the server accepts to apply an ammo action predicted by the owning client, so latency is absorbed but can't be abused
+static constexpr double MaxReloadPredictionRewind = 0.5;
+
+
+// Broadcasts an ammo system event to its native listeners, and to its Blueprint listeners only if there are any
+template<typename NativeEventType, typename BlueprintDelegateType, typename... ParamTypes>
+static FORCEINLINE void BroadcastAmmoEvent(NativeEventType& NativeEvent, BlueprintDelegateType& BlueprintDelegate, ParamTypes... Params) {
+
+	NativeEvent.Broadcast(Params...);
+
+	// The dynamic delegate marshals its parameters through reflection even for an empty invocation list, so it is skipped altogether when unbound
+	if (BlueprintDelegate.IsBound()) {
+
+		BlueprintDelegate.Broadcast(Params...);
+
+	}
+
+}
+
+
+
+/*
+ *
+ *	Receives the events of the ammo core and broadcasts them through the ammo system's events
+ *
+ */
+struct FSAmmoCoreListener {
+
+	FSAmmoCoreListener(USAmmoSystemComponent& InAmmoSystem, bool bInBroadcast) : AmmoSystem(InAmmoSystem), bBroadcast(bInBroadcast) {}
+
+	// Ammo changes are coalesced and only broadcast at the end of the frame
+	void OnAmmoChanged(int32 BulletsCurrentlyActive, int32 AvailableReloads) { if (bBroadcast) AmmoSystem.QueueAmmoNotification(0); }
+	void OnBulletsAdded(uint8 NumBulletsAdded) { if (bBroadcast) AmmoSystem.QueueAmmoNotification(NumBulletsAdded); }
+
+	// Passive reload events
+	void OnReloadStarted(FSPassiveReloadPolicy, float FirstDelay) { if (bBroadcast) BroadcastAmmoEvent(AmmoSystem.PassiveStartEvent, AmmoSystem.PassiveStartDelegate, FirstDelay); }
+	void OnReloadCycleStarted(FSPassiveReloadPolicy, float CycleDuration) { if (bBroadcast) BroadcastAmmoEvent(AmmoSystem.PassiveReloadCycleStartEvent, AmmoSystem.PassiveReloadCycleStartDelegate, CycleDuration); }
+	void OnReloadCancelled(FSPassiveReloadPolicy, ESAmmoCancelTrigger CancelType) { if (bBroadcast) BroadcastAmmoEvent(AmmoSystem.PassiveCancelEvent, AmmoSystem.PassiveCancelDelegate, static_cast<UReloadCancelTrigger>(CancelType)); }
+
+	// Magazine reload events
+	void OnReloadStarted(FSMagazineReloadPolicy, float TimeToBulletsIn) { if (bBroadcast) BroadcastAmmoEvent(AmmoSystem.MagazineStartEvent, AmmoSystem.MagazineStartDelegate, TimeToBulletsIn); }
+	void OnMagazineBulletsIn(float TimeToCompletion) { if (bBroadcast) BroadcastAmmoEvent(AmmoSystem.MagazineBulletsInEvent, AmmoSystem.MagazineBulletsInDelegate, TimeToCompletion); }
+	void OnReloadCompleted(FSMagazineReloadPolicy) { if (bBroadcast) BroadcastAmmoEvent(AmmoSystem.MagazineCompleteEvent, AmmoSystem.MagazineCompleteDelegate); }
+	void OnReloadCancelled(FSMagazineReloadPolicy, ESAmmoCancelTrigger CancelType) { if (bBroadcast) BroadcastAmmoEvent(AmmoSystem.MagazineCancelEvent, AmmoSystem.MagazineCancelDelegate); }
+
+	// Per-bullet reload events
+	void OnReloadStarted(FSPerBulletReloadPolicy, float FirstDelay) { if (bBroadcast) BroadcastAmmoEvent(AmmoSystem.PerBulletStartEvent, AmmoSystem.PerBulletStartDelegate, FirstDelay); }
+	void OnReloadCycleStarted(FSPerBulletReloadPolicy, float CycleDuration) { if (bBroadcast) BroadcastAmmoEvent(AmmoSystem.PerBulletReloadCycleStartEvent, AmmoSystem.PerBulletReloadCycleStartDelegate, CycleDuration); }
+	void OnReloadCompleted(FSPerBulletReloadPolicy) { if (bBroadcast) BroadcastAmmoEvent(AmmoSystem.PerBulletCompleteEvent, AmmoSystem.PerBulletCompleteDelegate); }
+	void OnReloadCancelled(FSPerBulletReloadPolicy, ESAmmoCancelTrigger CancelType) { if (bBroadcast) BroadcastAmmoEvent(AmmoSystem.PerBulletInstantCancelEvent, AmmoSystem.PerBulletInstantCancelDelegate); }
+	void OnReloadCancelledWithWinddown(float TimeToCompletion) { if (bBroadcast) BroadcastAmmoEvent(AmmoSystem.PerBulletTimedCancelEvent, AmmoSystem.PerBulletTimedCancelDelegate, TimeToCompletion); }
+
+	USAmmoSystemComponent& AmmoSystem;
+	const bool bBroadcast;
+
+};
+
+
+
+// Splits the given time of the reload clock into its whole second and the offset from it
+FSNetReloadTime::FSNetReloadTime(double Time) {
+
+	const double ClampedTime = FMath::Max(Time, 0.0);
+	const double WholeSecond = FMath::FloorToDouble(ClampedTime);
+
+	BaseSecond = static_cast<int32>(WholeSecond);
+	Offset = static_cast<float>(ClampedTime - WholeSecond);
+
+	// Rounding to a float may land right on the next second, which belongs to the base instead
+	if (Offset >= 1.0f) {
+
+		++BaseSecond;
+		Offset = 0.0f;
+
+	}
+
+}
+
+
+// Returns the time of the reload clock this stands for
+double FSNetReloadTime::ToTime() const {
+
+	return static_cast<double>(BaseSecond) + static_cast<double>(Offset);
+
+}
+
+
+// Custom serialization of the base second and offset
+bool FSNetReloadTime::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) {
+
+	uint32 PackedBaseSecond = static_cast<uint32>(BaseSecond);
+	Ar.SerializeIntPacked(PackedBaseSecond);
+	Ar << Offset;
+
+	if (Ar.IsLoading()) {
+
+		BaseSecond = static_cast<int32>(PackedBaseSecond);
+		Offset = FMath::Clamp(Offset, 0.0f, 1.0f);
+
+	}
+
+	bOutSuccess = true;
+	return true;
+
+}
+
+
+// Compares base second and offset
+bool FSNetReloadTime::operator==(const FSNetReloadTime& Other) const {
+
+	return BaseSecond == Other.BaseSecond && Offset == Other.Offset;
+
+}
+
+
+
+// Copies the given ammo state into this one
+void FSReplicatedAmmoState::Pack(const FSAmmoState& State) {
+
+	BulletsCurrentlyActive = State.BulletsCurrentlyActive;
+	MagazinesExpended = State.MagazinesExpended;
+	BulletsExpended = State.BulletsExpended;
+	PerBulletReloadCycles = State.PerBulletReloadCycles;
+	PassiveCyclesApplied = State.PassiveCyclesApplied;
+	Phase = State.Phase;
+	bReloadIsBeingCancelled = State.bReloadIsBeingCancelled;
+
+	// The phase time means nothing while idle, so it doesn't make the state dirty either
+	PhaseTime = State.IsReloading() ? FSNetReloadTime(State.PhaseTime) : FSNetReloadTime();
+
+}
+
+
+// Copies this state into the given ammo state
+void FSReplicatedAmmoState::Unpack(FSAmmoState& State) const {
+
+	State.BulletsCurrentlyActive = BulletsCurrentlyActive;
+	State.MagazinesExpended = MagazinesExpended;
+	State.BulletsExpended = BulletsExpended;
+	State.PerBulletReloadCycles = PerBulletReloadCycles;
+	State.PassiveCyclesApplied = PassiveCyclesApplied;
+	State.Phase = Phase;
+	State.bReloadIsBeingCancelled = bReloadIsBeingCancelled;
+	State.PhaseTime = PhaseTime.ToTime();
+
+}
+
+
+// Custom serialization of the packed state
+bool FSReplicatedAmmoState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) {
+
+	// All the counters are small and never negative, so they go as packed integers (1 byte each below 128)
+	uint32 PackedValues[6] = { static_cast<uint32>(LastAcknowledgedAmmoAction), static_cast<uint32>(BulletsCurrentlyActive), static_cast<uint32>(MagazinesExpended), static_cast<uint32>(BulletsExpended), static_cast<uint32>(PerBulletReloadCycles), static_cast<uint32>(PassiveCyclesApplied) };
+
+	for (uint32& PackedValue : PackedValues) {
+
+		Ar.SerializeIntPacked(PackedValue);
+
+	}
+
+	// Phase in the lower 2 bits, cancel flag in the third
+	uint8 PhaseAndFlags = static_cast<uint8>(Phase) | (bReloadIsBeingCancelled ? (1 << 2) : 0);
+	Ar << PhaseAndFlags;
+
+	if (Ar.IsLoading()) {
+
+		LastAcknowledgedAmmoAction = static_cast<int32>(PackedValues[0]);
+		BulletsCurrentlyActive = static_cast<int32>(PackedValues[1]);
+		MagazinesExpended = static_cast<int32>(PackedValues[2]);
+		BulletsExpended = static_cast<int32>(PackedValues[3]);
+		PerBulletReloadCycles = static_cast<int32>(PackedValues[4]);
+		PassiveCyclesApplied = static_cast<int32>(PackedValues[5]);
+		Phase = static_cast<ESAmmoPhase>(PhaseAndFlags & 0x3);
+		bReloadIsBeingCancelled = (PhaseAndFlags & (1 << 2)) != 0;
+
+	}
+
+	// Timestamp of the phase, only while there is one
+	if (Phase != ESAmmoPhase::Idle) {
+
+		PhaseTime.NetSerialize(Ar, Map, bOutSuccess);
+
+	}
+	else {
+
+		PhaseTime = FSNetReloadTime();
+		bOutSuccess = true;
+
+	}
+
+	return true;
+
+}
+
+
+// Compares every packed value
+bool FSReplicatedAmmoState::operator==(const FSReplicatedAmmoState& Other) const {
+
+	return LastAcknowledgedAmmoAction == Other.LastAcknowledgedAmmoAction && BulletsCurrentlyActive == Other.BulletsCurrentlyActive && MagazinesExpended == Other.MagazinesExpended && BulletsExpended == Other.BulletsExpended
+		&& PerBulletReloadCycles == Other.PerBulletReloadCycles && PassiveCyclesApplied == Other.PassiveCyclesApplied && Phase == Other.Phase
+		&& bReloadIsBeingCancelled == Other.bReloadIsBeingCancelled && PhaseTime == Other.PhaseTime;
+
+}
 
 
 
 // Sets default values for this component's properties
 USAmmoSystemComponent::USAmmoSystemComponent() {
 
-	// Not reloading nor cancelling it at construction, 0 out usages
-	bIsReloading = false;
-	bReloadIsBeingCancelled = false;
-	MagazinesExpended = 0;
-    BulletsExpended = 0;
-	PerBulletReloadCycles = 0;
+	// Only ticks to flush the ammo notifications of a frame, after every weapon has acted
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+
+	// Until BeginPlay there is no reload type to speak of
+	AmmoCorePolicy = UReloadType::NoReload;
+	bIsAmmoCoreBound = false;
+	WeaponDefinition = nullptr;
+	ReloadTimingWheel = nullptr;
+	bIsHUDVisible = false;
+	ScheduledDeadline = AmmoCoreNoDeadline;
+	bAmmoChangedPending = false;
+	PendingBulletsAdded = 0;
+	bReceivedReplicatedAmmoState = false;
+	LastPredictedAmmoAction = 0;
+	LastAcknowledgedAmmoAction = 0;
+	LastPredictedActionTime = 0.0;
+
+	// The ammo state goes to the owning client, as long as the weapon replicates
+	SetIsReplicatedByDefault(true);
 	
 }
 
 
+// Called every frame (only enabled while there are ammo notifications waiting to be flushed)
+void USAmmoSystemComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) {
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FlushAmmoNotifications();
+	SetComponentTickEnabled(false);
+
+}
+
+
+// Registers the replicated ammo state (owner only, pushed when dirty)
+void USAmmoSystemComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const {
+
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// Nobody but the owner displays the ammo, and the state is only compared when it has been marked dirty
+	FDoRepLifetimeParams Params;
+	Params.Condition = COND_OwnerOnly;
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(USAmmoSystemComponent, ReplicatedAmmoState, Params);
+
+}
+
+
+// Calls the given functor with an instance of the bound reload policy (an empty struct, only there for its type), returning whatever the functor returns
+template<typename FunctorType>
+FORCEINLINE decltype(auto) USAmmoSystemComponent::VisitAmmoCore(FunctorType&& Functor) const {
+
+	// Every case is its own instantiation of the functor, with the policy's code inlined into it
+	switch (AmmoCorePolicy) {
+
+	case UReloadType::PassiveReload:
+		return Functor(FSPassiveReloadPolicy());
+
+	case UReloadType::ActiveMagazineReload:
+		return Functor(FSMagazineReloadPolicy());
+
+	case UReloadType::ActivePerBulletReload:
+		return Functor(FSPerBulletReloadPolicy());
+
+	default:
+		return Functor(FSNoReloadPolicy());
+
+	}
+
+}
+
+
 // Requests the cancelling of any reloading action that is in process and consumes a given number of bullets, returning true if successful in spending ammo (also returns the number of bullets truly consumed by the ammo system as the third parameter)
 bool USAmmoSystemComponent::ManageAmmoWhenUseRequested(bool CanBePartial, const uint8 NumToExpend, uint8& BulletsTrulyExpended) {
 
-	bool retval = false;
-	
-	// Check if there are limitations to the ammo system itself to firing
-	if (CanFire(CanBePartial, NumToExpend)) {
-
-		// Subtract bullets from the ones available in the weapon
-		// Prevent underflow by checking if there are more bullets being requested than available
-		if (NumToExpend <= BulletsCurrentlyActive) {
-
-			// Expend the bullets being requested and increment count in full
-			BulletsTrulyExpended = NumToExpend;
-			// BulletsExpended += NumToExpend;
-			BulletsCurrentlyActive -= NumToExpend;
-			
-			retval = true;
-		
-		}
+	bool Success = false;
+
+	if (bIsAmmoCoreBound) {
 
-		// If the requested number of bullets to be consumed is higher than what we have available, expend those
-		else {
+		const bool bIsPredicting = IsPredictingAmmo();
+		const double Now = bIsPredicting ? GetAmmoActionTime() : GetAmmoCoreTime();
+		Success = VisitAmmoCore([&](auto Policy) { return ConsumeAmmoWithPolicy<decltype(Policy)>(CanBePartial, NumToExpend, BulletsTrulyExpended, Now); });
 
-			// Expend all available bullets and adjust count increment accordingly
-			BulletsTrulyExpended = BulletsCurrentlyActive;
-			BulletsCurrentlyActive = 0;
+		// The shot is fired on the owning client only, so the server has to be told about the ammo it took (a refused shot would be refused there too)
+		if (Success && bIsPredicting) {
+
+			FSPredictedAmmoAction Action;
+			Action.Type = ESPredictedAmmoActionType::Consume;
+			Action.bCanBePartial = CanBePartial;
+			Action.NumToExpend = NumToExpend;
+			Action.Time = Now;
+
+			PredictAmmoAction(Action);
 
-			retval = true;
-			
 		}
 
-		// We try to cancel the reload
-		HandleReloadCancel(UReloadCancelTrigger::TriggerByWeaponAction);
-		
-		// independent of which branch chosen above, the bullets currently available had their value updated, so broadcast it
-		AmmoChangedDelegate.Broadcast(BulletsCurrentlyActive, GetAvailableReloads());
-		
 	}
 
-	return retval;
+	return Success;
 	
 }
 
 
-// Main reload function, delegates and branches according to reload type; returns true on reload success
+// Main reload function, delegates to the ammo core of the weapon's reload type; returns true on reload success
 bool USAmmoSystemComponent::HandleReloadTrigger(bool WeaponIsBusy, const UReloadCancelTrigger CancelType) {
 
 	bool Success = false;
 
-	switch (ReloadType) {
-		
-	case UReloadType::PassiveReload:
-		Success = TriggerPassiveReload(CancelType);
-		break;
-			
-	case UReloadType::ActiveMagazineReload:
-		Success = TriggerMagazineReload(WeaponIsBusy);
-		break;
-		
-	case UReloadType::ActivePerBulletReload:
-		Success = TriggerPerBulletReload(WeaponIsBusy);
-		break;
-		
-	default:
-		UE_LOG(LogTemp, Error, TEXT("No reload system configured!"))
-		Success = false;
-		break;
-		
+	if (bIsAmmoCoreBound && GetReloadType() != UReloadType::NoReload) {
+
+		const double Now = GetAmmoActionTime();
+		Success = VisitAmmoCore([&](auto Policy) { return TriggerReloadWithPolicy<decltype(Policy)>(WeaponIsBusy, CancelType, Now); });
+
+		// The owning client doesn't wait for the server, it only tells it what it did (a trigger that failed here would fail there too)
+		if (Success && IsPredictingAmmo()) {
+
+			FSPredictedAmmoAction Action;
+			Action.Type = ESPredictedAmmoActionType::Trigger;
+			Action.bWeaponIsBusy = WeaponIsBusy;
+			Action.CancelType = CancelType;
+			Action.Time = Now;
+
+			PredictAmmoAction(Action);
+
+		}
+
 	}
+	else {
+
+		UE_LOG(LogCoopAmmo, Error, TEXT("No reload system configured!"))
 
-	UE_LOG(LogTemp, Log, TEXT("Weapon reload trigger %u"), Success);
+	}
+
+	UE_LOG(LogCoopAmmo, Verbose, TEXT("Weapon reload trigger %u"), Success);
+	COOP_TRACE_WEAPON(ReloadTriggered, GetOwner(), Success, static_cast<int32>(CancelType));
 	
 	return Success;
 	
 }
 
 
-// Handling function for reload cancelling requests, either called indirectly via HandleReloadTrigger (in which we use IsReloading as a flip-flop between triggering reload or cancel
+// Handling function for reload cancelling requests, delegates to the ammo core of the weapon's reload type
 bool USAmmoSystemComponent::HandleReloadCancel(const UReloadCancelTrigger& CancelType) {
 
 	bool Success = false;
-		
-	switch (ReloadType) {
-		
-	case UReloadType::PassiveReload:
-		Success = CancelPassiveReload(CancelType);
-		break;
-			
-	case UReloadType::ActiveMagazineReload:
-		Success = CancelMagazineReload(CancelType);
-		break;
-		
-	case UReloadType::ActivePerBulletReload:
-		Success = CancelPerBulletReload(CancelType);
-		break;
-		
-	default:
-		UE_LOG(LogTemp, Error, TEXT("No reload system configured!"))
-		Success = false;
-		break;
-		
+
+	if (bIsAmmoCoreBound && GetReloadType() != UReloadType::NoReload) {
+
+		const double Now = GetAmmoActionTime();
+		const bool bWasReloading = AmmoState.IsReloading();
+		Success = VisitAmmoCore([&](auto Policy) { return CancelReloadWithPolicy<decltype(Policy)>(CancelType, Now); });
+
+		// Cancels rejected locally still go to the server if there was a reload, as its reload may be further along (e.g.: a per-bullet cycle already completed there)
+		if (bWasReloading && IsPredictingAmmo()) {
+
+			FSPredictedAmmoAction Action;
+			Action.Type = ESPredictedAmmoActionType::Cancel;
+			Action.CancelType = CancelType;
+			Action.Time = Now;
+
+			PredictAmmoAction(Action);
+
+		}
+
 	}
+	else {
 
-	UE_LOG(LogTemp, Log, TEXT("Weapon reload cancel %u"), Success);
+		UE_LOG(LogCoopAmmo, Error, TEXT("No reload system configured!"))
+
+	}
+
+	UE_LOG(LogCoopAmmo, Verbose, TEXT("Weapon reload cancel %u"), Success);
+	COOP_TRACE_WEAPON(ReloadCancelled, GetOwner(), Success, static_cast<int32>(CancelType));
 	
 	return Success;
 	
@@ -134,34 +406,20 @@ bool USAmmoSystemComponent::HandleReloadCancel(const UReloadCancelTrigger& Cance
 // Activate the automatic properties of the weapon upon switching
 void USAmmoSystemComponent::ActivateAutomaticProperties() {
 
-	// trigger passive reload if weapon is of that type
-	if (ReloadType == UReloadType::PassiveReload) {
+	// triggers passive reload if weapon is of that type
+	if (bIsAmmoCoreBound) {
 
-		TriggerPassiveReload(UReloadCancelTrigger::GenericPassiveTrigger);
+		VisitAmmoCore([&](auto Policy) { ActivateReloadWithPolicy<decltype(Policy)>(); });
 		
 	}
 	
 }
 
 
-// Returns the maximum number of bullets that can be available for the weapon simultaneously (depends on reload type)
+// Returns the maximum number of bullets that can be available for the weapon simultaneously (depends on reload type, set when the ammo core is bound)
 int32 USAmmoSystemComponent::GetMaximumBullets() const {
 
-	switch (ReloadType) {
-		
-	case UReloadType::PassiveReload:
-		return MaximumPassiveCapacity;
-		
-	case UReloadType::ActiveMagazineReload:
-		return BulletPerMagazine;
-		
-	case UReloadType::ActivePerBulletReload:
-		return MaximumBulletCapacity;
-		
-	default:
-		return 0;
-		
-	}
+	return AmmoConfig.MaximumBullets;
 
 }
 
@@ -169,602 +427,630 @@ int32 USAmmoSystemComponent::GetMaximumBullets() const {
 // Expose the reload type
 UReloadType USAmmoSystemComponent::GetReloadType() const {
 
-	return ReloadType;
+	return USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::ReloadType, ReloadType);
 	
 }
 
 
 // Broadcasts information on generic request
-void USAmmoSystemComponent::OnBroadcastRequested() const {
+void USAmmoSystemComponent::OnBroadcastRequested() {
+
+	if (bIsAmmoCoreBound) {
+
+		const int32 AvailableReloads = VisitAmmoCore([&](auto Policy) {
 
-	AmmoChangedDelegate.Broadcast(BulletsCurrentlyActive, GetAvailableReloads());
+			AdvanceReloadWithPolicy<decltype(Policy)>(GetAmmoCoreTime());
+			return GetAvailableReloadsWithPolicy<decltype(Policy)>();
+
+		});
+
+		// Sent right away (e.g.: a weapon switch shouldn't display the previous values for a frame), which also covers any change still pending
+		bAmmoChangedPending = false;
+		BroadcastAmmoEvent(AmmoChangedEvent, AmmoChangedDelegate, AmmoState.BulletsCurrentlyActive, AvailableReloads);
+
+	}
 	
 }
 
 
-// Called when the game starts
-void USAmmoSystemComponent::BeginPlay() {
+// Sets whether this ammo system's weapon is the one being displayed in the HUD; only then are timed events (e.g.: passive bullets-in) scheduled and broadcast
+void USAmmoSystemComponent::SetHUDVisibility(bool bVisible) {
 
-	Super::BeginPlay();
+	bIsHUDVisible = bVisible;
 
-	// Set status variables to their defaults (start always at maximum capacity)
-	BulletsCurrentlyActive = GetMaximumBullets();
+	if (bIsAmmoCoreBound) {
 
-	// Calculate leftover bullets/magazines for Active Magazine and Active Per-Bullet weapons
-	if (ReloadType == UReloadType::ActiveMagazineReload) {
+		VisitAmmoCore([&](auto Policy) {
 
-		// Always 1 because at game start we've only used 1 magazine (hurr durr)
-		MagazinesExpended = 1;
+			AdvanceReloadWithPolicy<decltype(Policy)>(GetAmmoCoreTime());
+			ScheduleReloadDeadlineWithPolicy<decltype(Policy)>();
+
+		});
 		
 	}
-	else if (ReloadType == UReloadType::ActivePerBulletReload) {
+	
+}
+
+
+// Makes the ammo system read its ammo and reload settings through a weapon definition instead of this component's defaults; must be called before BeginPlay
+void USAmmoSystemComponent::ApplyWeaponDefinition(const USWeaponDefinition& Definition) {
+
+	ensureMsgf(!HasBegunPlay(), TEXT("Weapon definition applied to %s after BeginPlay, the ammo core keeps its previous settings"), *GetNameSafe(GetOwner()));
+
+	WeaponDefinition = &Definition;
+
+}
+
+
+// Takes a compact snapshot of the ammo and reload state, brought up to now
+FSAmmoSnapshot USAmmoSystemComponent::CaptureAmmoSnapshot() {
+
+	FSAmmoSnapshot Snapshot;
+
+	if (bIsAmmoCoreBound) {
+
+		const double Now = GetAmmoCoreTime();
+		VisitAmmoCore([&](auto Policy) { AdvanceReloadWithPolicy<decltype(Policy)>(Now); });
+
+		Snapshot = FSAmmoSnapshot::Capture(AmmoState, Now);
+		Snapshot.ReloadType = static_cast<uint8>(GetReloadType());
 
-		// Always the currently available bullets at start
-		BulletsExpended = BulletsCurrentlyActive;
-		
 	}
 
-	// no need to broadcast changes of ammo and whatnot here because that initial set up can be done once the weapon to which this ammo system belongs is activated
-	
+	return Snapshot;
+
 }
 
 
-// Returns the number of available bullets/magazines depending on the active reload type; if the reload type is passive or if there is no maximum cap on reloads for this weapon's type, this function returns -1
-int32 USAmmoSystemComponent::GetAvailableReloads() const {
+// Restores a snapshot taken from a weapon of the same reload type, resuming any reload it had on-going; returns false if the snapshot doesn't fit this weapon
+bool USAmmoSystemComponent::RestoreAmmoSnapshot(const FSAmmoSnapshot& Snapshot) {
 
-	// values under 0 are coded values for no reload limit
-	switch (ReloadType) {
-		
-	case UReloadType::PassiveReload:
-		return -1;
-		
-	case UReloadType::ActiveMagazineReload:
-		if (bCapMagazinesPerLife) return (MagazinesPerLife - MagazinesExpended);
-		else return -1;
-		
-	case UReloadType::ActivePerBulletReload:
-		if (bCapBulletsPerLife) {
+	bool Success = false;
+
+	const bool bSameReloadType = (Snapshot.ReloadType == static_cast<uint8>(GetReloadType())) && (GetReloadType() != UReloadType::NoReload);
+	const bool bFitsWeapon = (Snapshot.BulletsCurrentlyActive >= 0) && (Snapshot.BulletsCurrentlyActive <= AmmoConfig.MaximumBullets);
+
+	if (bIsAmmoCoreBound && bSameReloadType && bFitsWeapon) {
+
+		const double Now = GetAmmoCoreTime();
+		Snapshot.Restore(AmmoState, Now);
+
+		// Whatever was scheduled belonged to the previous state
+		if (ReloadTimingWheel) {
+
+			ReloadTimingWheel->Cancel(ReloadDeadlineHandle);
 
-			// Guard against bad configuration in which MaximumBulletCapacity > BulletsPerLife (recall that at BeginGame, BulletsExpended = MaximumBulletCapacity
-			return ((BulletsExpended > BulletsPerLife) ? 0 : (BulletsPerLife - BulletsExpended));
-			
-		}
-		else {
-			return -1;
 		}
-		
-	default:
-		return 0;
-		
+
+		ScheduledDeadline = AmmoCoreNoDeadline;
+
+		VisitAmmoCore([&](auto Policy) {
+
+			AdvanceReloadWithPolicy<decltype(Policy)>(Now);
+			ScheduleReloadDeadlineWithPolicy<decltype(Policy)>();
+
+		});
+		QueueAmmoNotification(0);
+
+		Success = true;
+
 	}
-	
-}
+	else {
 
+		UE_LOG(LogCoopAmmo, Warning, TEXT("Ammo snapshot of reload type %u doesn't fit weapon %s"), Snapshot.ReloadType, *GetNameSafe(GetOwner()));
 
-// Indicates whether this weapon can be fired, using intBulletsCurrentlyActive as a basis vs the number of bullets the attack to be used requires (depending on whether partial fire is accepted) and whether reloading blocks firing the weapon
-bool USAmmoSystemComponent::CanFire(bool CanBePartial, uint8 NumToExpend) const {
+	}
 
-	// If we can fire only part of the RequiredBullets, we check only if we have 1 or more bullets
-	// Otherwise, we check if we can fire all required bullets
-	bool EnoughBulletsAvailable = (CanBePartial && (BulletsCurrentlyActive > 0)) || (BulletsCurrentlyActive >= NumToExpend);
+	return Success;
 
-	// reload does not block firing in passive reload or no reload, only in per-bullet or magazine types
-	bool IsNotBlockedByReload = (!bIsReloading || (ReloadType == UReloadType::PassiveReload) || (ReloadType == UReloadType::NoReload));
-	
-	return (EnoughBulletsAvailable && IsNotBlockedByReload);
-	
 }
 
 
-// Returns true if the request performed and the weapon status and configuration is proper for triggering of passive-type reload
-bool USAmmoSystemComponent::CanTriggerPassiveReload(const UReloadCancelTrigger& CancelType) const {
+// Resets the ammo state to that of a freshly spawned weapon, so a pooled weapon can start a new life without being spawned again
+void USAmmoSystemComponent::ResetAmmoState() {
 
-	// Bullets currently active are less than the maximum bullet capacity (there is space in weapon for more bullets)
-	bool SpaceAvailableInWeapon = (BulletsCurrentlyActive < MaximumPassiveCapacity);
-	
-	bool ReloadKeyPressed = (CancelType == UReloadCancelTrigger::TriggerByReload);
+	if (bIsAmmoCoreBound) {
 
-	UE_LOG(LogTemp, Log, TEXT("Passive Reload Trigger Validation, SpaceAvailableInWeapon %u, ReloadKeyPressed %u"), SpaceAvailableInWeapon, ReloadKeyPressed);
-	
-	// If there is space in the weapon and the reload key is not requesting passive reload, we can trigger passive reload
-	return (!bIsReloading && SpaceAvailableInWeapon && !ReloadKeyPressed);
-	
-}
+		if (ReloadTimingWheel) {
 
+			ReloadTimingWheel->Cancel(ReloadDeadlineHandle);
 
-// Returns true if the weapon has magazine reload type configured and has no impediments to reload
-bool USAmmoSystemComponent::CanTriggerMagazineReload(bool OtherWeaponActionOccurring) const {
+		}
 
-	// There is no maximum on magazines per life OR the magazines expended in this life are less than the maximum magazines available per life (there are magazines in storage)
-	bool MagazinesAvailableForUse = (!bCapMagazinesPerLife || (MagazinesExpended < MagazinesPerLife));
+		ScheduledDeadline = AmmoCoreNoDeadline;
 
-	// If both the bullet timer and the completion timer are set, we do not execute magazine reload (just-in-case check, as this should never be reached since bIsReloading is only set to false once OnCompleteMagazineReload is called
-	bool NewBulletTimerNotActive = (!GetWorld()->GetTimerManager().IsTimerActive(TimerHandle_NewBulletsTimer));
-	bool ReloadCompletionTimerNotActive = (!GetWorld()->GetTimerManager().IsTimerActive(TimerHandle_ReloadCompletion));
+		VisitAmmoCore([&](auto Policy) { InitializeAmmoWithPolicy<decltype(Policy)>(); });
+		UpdateReplicatedAmmoState();
+		QueueAmmoNotification(0);
+
+	}
 
-	UE_LOG(LogTemp, Log, TEXT("Magazine Reload Trigger Validation, bIsReloading %u, OtherWeaponActionOccurring %u, MagazinesAvailableForUse %u, NewBulletTimerNotActive %u, ReloadCompletionTimerNotActive %u"), bIsReloading, OtherWeaponActionOccurring, MagazinesAvailableForUse, NewBulletTimerNotActive, ReloadCompletionTimerNotActive);
-	
-	// If there are magazines in storage AND no reload-blocking weapon action is happening, reload is possible	
-	return (!bIsReloading && !OtherWeaponActionOccurring && MagazinesAvailableForUse && NewBulletTimerNotActive && ReloadCompletionTimerNotActive);
-	
 }
 
 
-// Returns true if the weapon has magazine per-bullet type configured and has no impediments to reload
-bool USAmmoSystemComponent::CanTriggerPerBulletReload(bool OtherWeaponActionOccurring) const {
+// Called when the game starts
+void USAmmoSystemComponent::BeginPlay() {
 
-	// Bullets currently active are less than the maximum bullet capacity (there is space in weapon for more bullets)
-	bool SpaceAvailableInWeapon = (BulletsCurrentlyActive < MaximumBulletCapacity);
+	Super::BeginPlay();
 
-	// There is no maximum on bullets per life OR the required bullets for a reload are equal or less than the bullets expended in this life (bullets available per life minus the bullets already loaded into the weapon)
-	bool EnoughBulletsAvailableInStorage = (!bCapBulletsPerLife || (BulletsPerLife - BulletsExpended) >= BulletPerReload);
+	ReloadTimingWheel = GetWorld()->GetSubsystem<USReloadTimingWheelSubsystem>();
+
+	// Hand the properties (or those of the weapon definition) over to the ammo core
+	AmmoConfig.PassiveReloadDelay = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::PassiveReloadDelay, PassiveReloadDelay);
+	AmmoConfig.ReloadTimePassive = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::ReloadTimePassive, ReloadTimePassive);
+	AmmoConfig.bEnableMagazineReloadCancel = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::bEnableMagazineReloadCancel, bEnableMagazineReloadCancel);
+	AmmoConfig.BulletsReloadTimeMagazine = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::BulletsReloadTimeMagazine, BulletsReloadTimeMagazine);
+	AmmoConfig.WinddownReloadTimeMagazine = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::WinddownReloadTimeMagazine, WinddownReloadTimeMagazine);
+	AmmoConfig.bCapMagazinesPerLife = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::bCapMagazinesPerLife, bCapMagazinesPerLife);
+	AmmoConfig.MagazinesPerLife = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::MagazinesPerLife, MagazinesPerLife);
+	AmmoConfig.BulletPerReload = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::BulletPerReload, BulletPerReload);
+	AmmoConfig.ReloadDelayTimeBullet = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::ReloadDelayTimeBullet, ReloadDelayTimeBullet);
+	AmmoConfig.ReloadTimeBullet = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::ReloadTimeBullet, ReloadTimeBullet);
+	AmmoConfig.ReloadEndTimeBullet = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::ReloadEndTimeBullet, ReloadEndTimeBullet);
+	AmmoConfig.bCapBulletsPerLife = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::bCapBulletsPerLife, bCapBulletsPerLife);
+	AmmoConfig.BulletsPerLife = USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::BulletsPerLife, BulletsPerLife);
+
+	// The only place in which the reload type is looked at, everything afterwards goes through the policy bound here (see VisitAmmoCore)
+	switch (GetReloadType()) {
 
-	// If the bullet timer is set, we do not execute per-bullet reload (just-in-case check, as this should never be reached since bIsReloading is only set to false once OnCompletePerBulletReload is called
-	bool NewBulletTimerNotActive = !GetWorld()->GetTimerManager().IsTimerActive(TimerHandle_NewBulletsTimer);
+	case UReloadType::PassiveReload:
+		BindAmmoCore<FSPassiveReloadPolicy>(USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::MaximumPassiveCapacity, MaximumPassiveCapacity));
+		break;
 
-	UE_LOG(LogTemp, Log, TEXT("Per-Bullet Reload Trigger Validation, bIsReloading %u, SpaceAvailableInWeapon %u, EnoughBulletsAvailableInStorage %u, NewBulletTimerNotActive %u"), bIsReloading, SpaceAvailableInWeapon, EnoughBulletsAvailableInStorage, NewBulletTimerNotActive);
-	
-	// If the above conditions are true AND no reload-blocking weapon action is happening, reload is possible
-	return (!bIsReloading && !OtherWeaponActionOccurring && SpaceAvailableInWeapon && EnoughBulletsAvailableInStorage && NewBulletTimerNotActive);
+	case UReloadType::ActiveMagazineReload:
+		BindAmmoCore<FSMagazineReloadPolicy>(USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::BulletPerMagazine, BulletPerMagazine));
+		break;
+
+	case UReloadType::ActivePerBulletReload:
+		BindAmmoCore<FSPerBulletReloadPolicy>(USWeaponDefinition::ReadTuning(WeaponDefinition, &USWeaponDefinition::MaximumBulletCapacity, MaximumBulletCapacity));
+		break;
+
+	default:
+		BindAmmoCore<FSNoReloadPolicy>(0);
+		break;
+
+	}
+
+	// The server's state wins over the one just initialized if it arrived before BeginPlay
+	if (bReceivedReplicatedAmmoState) {
+
+		ReplicatedAmmoState.Unpack(AmmoState);
+
+	}
+	else {
+
+		UpdateReplicatedAmmoState();
+
+	}
+
+	// no need to broadcast changes of ammo and whatnot here because that initial set up can be done once the weapon to which this ammo system belongs is activated
 	
 }
 
 
-// Returns true if the request performed and the weapon status and configuration is proper for cancellation of passive-type reload
-bool USAmmoSystemComponent::CanCancelPassiveReload(UReloadCancelTrigger CancelType) const {
+// Called when the game ends or the component is destroyed
+void USAmmoSystemComponent::EndPlay(const EEndPlayReason::Type EndPlayReason) {
 
-	bool WeaponActionTriggered = (CancelType == UReloadCancelTrigger::TriggerByWeaponAction) && (BulletsCurrentlyActive > 0);
+	if (ReloadTimingWheel) {
 
-	// needed to prevent some multithreading fuckery going on with WeaponActionTriggered
-	bool temp = WeaponActionTriggered;
-	
-	bool LimitReached = (CancelType == UReloadCancelTrigger::TriggerByLimitReached);
-	bool WeaponSwitched = (CancelType == UReloadCancelTrigger::TriggerByWeaponSwitch);	
-	bool OutsideFactors = (CancelType == UReloadCancelTrigger::TriggerByExternal);
-	
-	UE_LOG(LogTemp, Log, TEXT("Passive Reload Cancel Validation, bIsReloading %u, WeaponActionTriggered %u, LimitReached %u, WeaponSwitched %u, OutsideFactors %u"), bIsReloading, WeaponActionTriggered, LimitReached, WeaponSwitched, OutsideFactors);
+		ReloadTimingWheel->Cancel(ReloadDeadlineHandle);
 
-	if (BulletsCurrentlyActive == 0) {
-		
-		//UE_LOG(LogTemp, Log, TEXT("TEXT bulletsatzero %u, wepact %u"), bulletsatzero, wepact);
-		
 	}
-	
-	// passive weapon reload can only be cancelled indirectly (limit reached, weapon switch, others) or by a weapon action
-	// no need to check if reloading is happening; cancelling may be done anyways as cancelling has no nefarious side effects
-	return (bIsReloading && (WeaponActionTriggered || LimitReached || WeaponSwitched || OutsideFactors));
-	
+
+	Super::EndPlay(EndPlayReason);
+
 }
 
 
-// Returns true if the request performed and the weapon status and configuration is proper for cancellation of magazine-type reload
-bool USAmmoSystemComponent::CanCancelMagazineReload(UReloadCancelTrigger CancelType) const {
+// Binds the given reload policy with its maximum bullets and initializes the ammo state for it (start always at maximum capacity)
+template<typename PolicyType>
+void USAmmoSystemComponent::BindAmmoCore(int32 MaximumBullets) {
 
-	// Weapon with magazine-type reload type is not reloading OR is reloading and is configured with cancellation properties
-	bool ReloadKeyPressed = ((CancelType == UReloadCancelTrigger::TriggerByReload) && bEnableMagazineReloadCancel);
-	bool LimitReached = (CancelType == UReloadCancelTrigger::TriggerByLimitReached);
-	bool WeaponSwitched = (CancelType == UReloadCancelTrigger::TriggerByWeaponSwitch);	
-	bool OutsideFactors = (CancelType == UReloadCancelTrigger::TriggerByExternal);
+	AmmoConfig.MaximumBullets = MaximumBullets;
+	AmmoCorePolicy = GetReloadType();
+	bIsAmmoCoreBound = true;
+
+	InitializeAmmoWithPolicy<PolicyType>();
 
-	UE_LOG(LogTemp, Log, TEXT("Magazine Reload Cancel Validation, bIsReloading %u, ReloadKeyPressed %u, LimitReached %u, WeaponSwitched %u, OutsideFactors %u"), bIsReloading, ReloadKeyPressed, LimitReached, WeaponSwitched, OutsideFactors);
-	
-	// magazine weapon reload can only be cancelled indirectly (limit reached, weapon switch, others) or via pressing the reload key
-	// no need to check if reloading is happening; cancelling may be done anyways as cancelling has no nefarious side effects
-	return (bIsReloading && (ReloadKeyPressed || LimitReached || WeaponSwitched || OutsideFactors));
-	
 }
 
 
-// Returns true if the request performed and the weapon status and configuration is proper for cancellation of per-bullet-type reload
-bool USAmmoSystemComponent::CanCancelPerBulletReload(UReloadCancelTrigger CancelType) const {
+// Sets the ammo state of a freshly spawned weapon through the ammo core of the given reload policy
+template<typename PolicyType>
+void USAmmoSystemComponent::InitializeAmmoWithPolicy() {
 
-	// Weapon with magazine-type reload type is not reloading OR is reloading and is configured with cancellation properties
-	bool WeaponActionTriggered = (CancelType == UReloadCancelTrigger::TriggerByWeaponAction);
-	bool LimitReached = (CancelType == UReloadCancelTrigger::TriggerByLimitReached);
-	bool WeaponSwitched = (CancelType == UReloadCancelTrigger::TriggerByWeaponSwitch);	
-	bool OutsideFactors = (CancelType == UReloadCancelTrigger::TriggerByExternal);
+	TSAmmoCore<PolicyType>::Initialize(AmmoState, AmmoConfig);
 
-	UE_LOG(LogTemp, Log, TEXT("Per-bullet Reload Cancel Validation, bIsReloading $u, WeaponActionTriggered %u, LimitReached %u, WeaponSwitched %u, OutsideFactors %u"), bIsReloading, WeaponActionTriggered, LimitReached, WeaponSwitched, OutsideFactors);
-	
-	// magazine weapon reload can only be cancelled indirectly (limit reached, weapon switch, others) or via pressing the reload key
-	// no need to check if reloading is happening; cancelling may be done anyways as cancelling has no nefarious side effects
-	return (bIsReloading && (WeaponActionTriggered || LimitReached || WeaponSwitched || OutsideFactors));
-	
 }
 
 
-// todo HIGH PRIORITY: if there are no available bullets but the user continues using the weapon, passive reload never starts (perhaps a functionality in which holding the button down doesn't retrigger the passive reload timer, blocking firing, but releasing then pressing the button anew would make it possible to reuse the weapon? just an idea, not high priority)
-// Function dedicated to handling passive reload
-bool USAmmoSystemComponent::TriggerPassiveReload(const UReloadCancelTrigger& CancelType) {
+// Consumes ammo at the given time through the ammo core of the given reload policy
+template<typename PolicyType>
+bool USAmmoSystemComponent::ConsumeAmmoWithPolicy(bool CanBePartial, uint8 NumToExpend, uint8& BulletsTrulyExpended, double Now) {
 
-	bool ReloadSuccess = false;
+	// Reload types whose timed events drive gameplay have always been broadcast, the others only while the weapon is displayed
+	FSAmmoCoreListener Listener(*this, bIsHUDVisible || PolicyType::bNeedsDeadlineWhenHidden);
 
-	if (CanTriggerPassiveReload(CancelType)) {
-		
-		// Immediately set up the timer afterwards
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle_InitialDelayTimer, this, &USAmmoSystemComponent::OnStartDelayFinishedPassiveReload, PassiveReloadDelay);
+	const bool Success = TSAmmoCore<PolicyType>::ConsumeAmmo(AmmoState, AmmoConfig, Now, CanBePartial, NumToExpend, BulletsTrulyExpended, Listener);
 
-		// Update reload status and update HUDInfo via broadcast
-		PassiveCancelDelegate.Broadcast(CancelType);
-		PassiveStartDelegate.Broadcast(PassiveReloadDelay);
-		bIsReloading = true;
-		
-		UE_LOG(LogTemp, Log, TEXT("Set passive reload timers, with delay of %f seconds and per bullet tick of %f seconds"), PassiveReloadDelay, ReloadTimePassive);	
+	if (Success) {
+
+		ScheduleReloadDeadlineWithPolicy<PolicyType>();
+		UpdateReplicatedAmmoState();
 
-		ReloadSuccess = true;
-		
-		
 	}
 
-	return ReloadSuccess;
-	
+	return Success;
+
 }
 
 
-// Function dedicated to handling active magazine reload
-bool USAmmoSystemComponent::TriggerMagazineReload(bool OtherWeaponActionOccurring) {
+// Requests the start of a reload at the given time through the ammo core of the given reload policy
+template<typename PolicyType>
+bool USAmmoSystemComponent::TriggerReloadWithPolicy(bool WeaponIsBusy, UReloadCancelTrigger CancelType, double Now) {
 
-	bool ReloadSuccess = false;
+	FSAmmoCoreListener Listener(*this, bIsHUDVisible || PolicyType::bNeedsDeadlineWhenHidden);
 
-	if (CanTriggerMagazineReload(OtherWeaponActionOccurring)) {
-		
-		// Set timers for completion of the reload phases
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle_NewBulletsTimer, this, &USAmmoSystemComponent::OnBulletsInMagazineReload, BulletsReloadTimeMagazine);
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle_ReloadCompletion, this, &USAmmoSystemComponent::OnCompleteMagazineReload, (BulletsReloadTimeMagazine + WinddownReloadTimeMagazine));
+	const bool Success = TSAmmoCore<PolicyType>::Trigger(AmmoState, AmmoConfig, Now, WeaponIsBusy, static_cast<ESAmmoCancelTrigger>(CancelType), Listener);
 
-		// Update reload status and update HUDInfo, if bEnableMagazineReloadCancel then this action can be cancelled
-		bIsReloading = true;
+	ScheduleReloadDeadlineWithPolicy<PolicyType>();
+	UpdateReplicatedAmmoState();
 
-		UE_LOG(LogTemp, Log, TEXT("Set magazine reload timers, bIsReloading %u"), bIsReloading);
+	return Success;
 
-		ReloadSuccess = true;
+}
+
+
+// Requests the cancelling of the on-going reload at the given time through the ammo core of the given reload policy
+template<typename PolicyType>
+bool USAmmoSystemComponent::CancelReloadWithPolicy(UReloadCancelTrigger CancelType, double Now) {
+
+	FSAmmoCoreListener Listener(*this, bIsHUDVisible || PolicyType::bNeedsDeadlineWhenHidden);
+
+	const bool Success = TSAmmoCore<PolicyType>::Cancel(AmmoState, AmmoConfig, Now, static_cast<ESAmmoCancelTrigger>(CancelType), Listener);
+
+	ScheduleReloadDeadlineWithPolicy<PolicyType>();
+	UpdateReplicatedAmmoState();
+
+	return Success;
 
-		MagazineStartDelegate.Broadcast(BulletsReloadTimeMagazine);
-		
-	}
-	
-	return ReloadSuccess;
-	
 }
 
-// todo LOW PRIORITY: per-bullet rate of fire still on-going when weapon action reload triggers cancel, meaning that there's still a bit of delay when reload process is finished because an attack is used
-// Function dedicated to handling active bullet-per-bullet reload
-bool USAmmoSystemComponent::TriggerPerBulletReload(bool OtherWeaponActionOccurring) {
 
-	bool ReloadSuccess = false;
+// Processes every reload phase boundary up to the given time through the ammo core of the given reload policy
+template<typename PolicyType>
+void USAmmoSystemComponent::AdvanceReloadWithPolicy(double Now) {
 
-	if (CanTriggerPerBulletReload(OtherWeaponActionOccurring)) {
-		
-		// Set timer for the initial delay
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle_InitialDelayTimer, this, &USAmmoSystemComponent::OnStartDelayFinishedPerBulletReload, ReloadDelayTimeBullet);
-		
-		// Update reload status and update HUDInfo, reload cancelling always possible in Per-Bullet types
-		bIsReloading = true;
+	FSAmmoCoreListener Listener(*this, bIsHUDVisible || PolicyType::bNeedsDeadlineWhenHidden);
 
-		// Start "wind up" animation here too - see https://forums.unrealengine.com/t/elegant-solution-to-play-certain-animations-depending-on-what-weapon-a-player-is-using/27939/7 on how to handle
-	
-		UE_LOG(LogTemp, Log, TEXT("Set per-bullet initial delay timer with duration %f, bIsReloading %u"), ReloadDelayTimeBullet, bIsReloading);
+	TSAmmoCore<PolicyType>::Advance(AmmoState, AmmoConfig, Now, Listener);
 
-		ReloadSuccess = true;
-		
-		PerBulletStartDelegate.Broadcast(ReloadDelayTimeBullet);
-		
-	}	
+	UpdateReplicatedAmmoState();
 
-	return ReloadSuccess;
-	
 }
 
 
-// Function called once the initial delay for passive reload passes
-void USAmmoSystemComponent::OnStartDelayFinishedPassiveReload() {
+// Starts the automatic reload behaviour (if any) through the ammo core of the given reload policy
+template<typename PolicyType>
+void USAmmoSystemComponent::ActivateReloadWithPolicy() {
 
-	// Clear timer
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_InitialDelayTimer);
+	FSAmmoCoreListener Listener(*this, bIsHUDVisible || PolicyType::bNeedsDeadlineWhenHidden);
+
+	TSAmmoCore<PolicyType>::Activate(AmmoState, AmmoConfig, GetAmmoCoreTime(), Listener);
+
+	ScheduleReloadDeadlineWithPolicy<PolicyType>();
+	UpdateReplicatedAmmoState();
 
-	// Set bullets-in retriggerable timer
-	// Set looping timer for the introduction of ammo in the weapon
-	GetWorld()->GetTimerManager().SetTimer(TimerHandle_NewBulletsTimer, this, &USAmmoSystemComponent::OnBulletsInPassiveReload, ReloadTimePassive, true);
-	
-	// Update HUD Info via broadcast
-	PassiveReloadCycleStartDelegate.Broadcast(ReloadTimePassive);
-	
-	UE_LOG(LogTemp, Log, TEXT("Cleared passive initial delay timer, started passive bullets-in looping timer with duration %f"), ReloadTimePassive);
-	
 }
 
 
-// Function called every time ReloadTimePassive elapses in passive reload weapons
-void USAmmoSystemComponent::OnBulletsInPassiveReload() {
-	
-	// Increment one-by-one always, there is no need to track bullets expended but why not
-	BulletsExpended	+= 1;
-	BulletsCurrentlyActive += 1;
-	
-	// Update HUD Info via broadcast
-	AmmoChangedDelegate.Broadcast(BulletsCurrentlyActive, GetAvailableReloads());
-	BulletsAddedDelegate.Broadcast(1);	/*this is always 1 */
-	
-	UE_LOG(LogTemp, Log, TEXT("Loaded 1 bullet, current capacity %u out of %u maximum"), BulletsCurrentlyActive, MaximumPassiveCapacity);
-	
-	// If we have reached the maximum capacity, we cancel the reload automatically
-	if (BulletsCurrentlyActive == MaximumPassiveCapacity) {
+// Takes the server's state, replays the ammo actions (shots, reload triggers and cancels) it hasn't acknowledged yet on top of it, and rolls back to the result if it differs from the prediction (owning client only)
+template<typename PolicyType>
+void USAmmoSystemComponent::ReconcileReloadWithPolicy() {
+
+	const double Now = GetAmmoCoreTime();
+
+	// What the client predicted, brought up to now
+	AdvanceReloadWithPolicy<PolicyType>(Now);
+	FSReplicatedAmmoState PredictedState;
+	PredictedState.Pack(AmmoState);
+
+	// Server's state, plus whatever it hasn't seen yet; everything in here was already broadcast once, so it's replayed silently
+	ReplicatedAmmoState.Unpack(AmmoState);
+
+	// Acknowledgements may skip keys: a shot whose unreliable RPC got lost is dropped along with the actions the server did apply, so the ammo it took comes back here
+	const int32 AcknowledgedAction = ReplicatedAmmoState.LastAcknowledgedAmmoAction;
+	PendingAmmoActions.RemoveAll([AcknowledgedAction](const FSPredictedAmmoAction& Action) { return Action.ActionKey <= AcknowledgedAction; });
+
+	FSAmmoCoreListener SilentListener(*this, false);
+	uint8 BulletsTrulyExpended = 0;
+
+	for (const FSPredictedAmmoAction& Action : PendingAmmoActions) {
+
+		switch (Action.Type) {
+
+		case ESPredictedAmmoActionType::Consume:
+			TSAmmoCore<PolicyType>::ConsumeAmmo(AmmoState, AmmoConfig, Action.Time, Action.bCanBePartial, Action.NumToExpend, BulletsTrulyExpended, SilentListener);
+			break;
+
+		case ESPredictedAmmoActionType::Trigger:
+			TSAmmoCore<PolicyType>::Trigger(AmmoState, AmmoConfig, Action.Time, Action.bWeaponIsBusy, static_cast<ESAmmoCancelTrigger>(Action.CancelType), SilentListener);
+			break;
+
+		case ESPredictedAmmoActionType::Cancel:
+			TSAmmoCore<PolicyType>::Cancel(AmmoState, AmmoConfig, Action.Time, static_cast<ESAmmoCancelTrigger>(Action.CancelType), SilentListener);
+			break;
+
+		}
 
-		HandleReloadCancel(UReloadCancelTrigger::TriggerByLimitReached);
-		
 	}
-	// if there is no reason to cancel the reload, broadcast the start of a new reload cycle
-	else {
-		
-		PassiveReloadCycleStartDelegate.Broadcast(ReloadTimePassive);
-		
+
+	TSAmmoCore<PolicyType>::Advance(AmmoState, AmmoConfig, Now, SilentListener);
+
+	FSReplicatedAmmoState ReconciledState;
+	ReconciledState.Pack(AmmoState);
+
+	// The prediction was wrong, so the displayed values are too
+	if (!(ReconciledState == PredictedState)) {
+
+		UE_LOG(LogCoopAmmo, Verbose, TEXT("Ammo prediction rolled back to server action %d (%d still pending)"), AcknowledgedAction, PendingAmmoActions.Num());
+		COOP_TRACE_WEAPON(ReloadRolledBack, GetOwner(), AcknowledgedAction, PendingAmmoActions.Num());
+
+		QueueAmmoNotification(0);
+
 	}
-	
+
+	ScheduleReloadDeadlineWithPolicy<PolicyType>();
+
 }
 
 
-// Function called when the ammo is added to the currently available ammo
-void USAmmoSystemComponent::OnBulletsInMagazineReload() {
+// Schedules the next reload phase boundary of the given reload policy in the timing wheel, if there is one and someone needs it on time
+template<typename PolicyType>
+void USAmmoSystemComponent::ScheduleReloadDeadlineWithPolicy() {
 
-	// Decrement current available magazines, reset bullets available to maximum value
-	++MagazinesExpended;
-	BulletsCurrentlyActive = BulletPerMagazine;
+	if (!ReloadTimingWheel) {
 
-	// Clear timer
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_NewBulletsTimer);
+		return;
 
-	// Update HUD Info via broadcast
-	AmmoChangedDelegate.Broadcast(BulletsCurrentlyActive, GetAvailableReloads());
-	MagazineBulletsInDelegate.Broadcast(WinddownReloadTimeMagazine);
-	
-	UE_LOG(LogTemp, Log, TEXT("Cleared magazine bullet timer"));
-	
-}
+	}
 
+	const double NextDeadline = TSAmmoCore<PolicyType>::NextDeadline(AmmoState, AmmoConfig);
+	const bool bDeadlineNeeded = (NextDeadline != AmmoCoreNoDeadline) && (bIsHUDVisible || TSAmmoCore<PolicyType>::NeedsDeadlineWhenHidden());
 
-// Function called when the animation for magazine reload is complete
-void USAmmoSystemComponent::OnCompleteMagazineReload() {
+	if (!bDeadlineNeeded) {
 
-	// Make weapon available for other actions
-	bIsReloading = false;
+		ReloadTimingWheel->Cancel(ReloadDeadlineHandle);
+		ScheduledDeadline = AmmoCoreNoDeadline;
 
-	// Clear timer
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_ReloadCompletion);
+	}
+	// Only touch the wheel if the deadline actually moved (e.g.: firing a passive reload weapon restarts its delay, firing a magazine weapon doesn't)
+	else if (NextDeadline != ScheduledDeadline || !ReloadTimingWheel->IsScheduled(ReloadDeadlineHandle)) {
+
+		ScheduledDeadline = NextDeadline;
+		ReloadTimingWheel->Schedule(ReloadDeadlineHandle, this, NextDeadline);
+
+	}
 
-	// Update HUD Info via broadcast
-	MagazineCompleteDelegate.Broadcast();
-	
-	UE_LOG(LogTemp, Log, TEXT("Cleared magazine reload timer, bIsReloading %u"), bIsReloading);
-	
 }
 
 
-// Function called once the initial delay for per-bullet reload passes
-void USAmmoSystemComponent::OnStartDelayFinishedPerBulletReload() {
+// Returns the number of leftover bullets/magazines according to the given reload policy, -1 if there is no limit
+template<typename PolicyType>
+int32 USAmmoSystemComponent::GetAvailableReloadsWithPolicy() const {
 
-	// Clear timer
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_InitialDelayTimer);
+	return TSAmmoCore<PolicyType>::GetAvailableReloads(AmmoState, AmmoConfig);
 
-	// Set bullets-in retriggerable timer
-	// Set looping timer for the introduction of ammo in the weapon
-	GetWorld()->GetTimerManager().SetTimer(TimerHandle_NewBulletsTimer, this, &USAmmoSystemComponent::OnBulletsInPerBulletReload, ReloadTimeBullet, true);
-	
-	// Update HUD Info via broadcast
-	PerBulletReloadCycleStartDelegate.Broadcast(ReloadTimeBullet);
-	
-	UE_LOG(LogTemp, Log, TEXT("Cleared per-bullet initial delay timer, started per-bullet bullets-in looping timer with duration %f"), ReloadTimeBullet);
+}
+
+
+// Function called at every reload phase boundary (end of a delay, bullets in, completion), processes it and schedules the next one
+void USAmmoSystemComponent::OnReloadDeadline() {
+
+	// The boundary it was scheduled for must be processed regardless of clock adjustments in-between
+	const double Now = FMath::Max(GetAmmoCoreTime(), ScheduledDeadline);
+	ScheduledDeadline = AmmoCoreNoDeadline;
+
+	VisitAmmoCore([&](auto Policy) {
+
+		AdvanceReloadWithPolicy<decltype(Policy)>(Now);
+		ScheduleReloadDeadlineWithPolicy<decltype(Policy)>();
+
+	});
 	
 }
 
 
-// Function called after the initial delay for bullet-per-bullet reload has finished (section 1, wind up)
-void USAmmoSystemComponent::OnBulletsInPerBulletReload() {
+// Returns the current time of the reload clock, as used by the ammo core (see USReloadTimingWheelSubsystem::GetReloadTime)
+double USAmmoSystemComponent::GetAmmoCoreTime() const {
 
-	uint8 BulletsReloaded = 0;
+	return USReloadTimingWheelSubsystem::GetReloadTime(GetWorld());
 	
-	// check if we are attempting to reload more bullets than permitted; if true, just set the currently active bullets to maximum, otherwise, proceed as normal
-	if ((BulletsCurrentlyActive + BulletPerReload) > MaximumBulletCapacity) {
+}
+
+
+// Marks the ammo values as changed (with the given bullets added, if any) and makes sure they are flushed at the end of the frame
+void USAmmoSystemComponent::QueueAmmoNotification(int32 NumBulletsAdded) {
+
+	bAmmoChangedPending = true;
+	PendingBulletsAdded += NumBulletsAdded;
+
+	if (!IsComponentTickEnabled()) {
+
+		SetComponentTickEnabled(true);
 
-		BulletsReloaded = (MaximumBulletCapacity - BulletsCurrentlyActive);
-		BulletsExpended += BulletsReloaded;
-		BulletsCurrentlyActive = MaximumBulletCapacity;
-		
-	}
-	else {
-		
-		BulletsExpended	+= BulletPerReload;
-		BulletsCurrentlyActive += BulletPerReload;
-		BulletsReloaded = BulletPerReload;
-		
 	}
 
-	// Increment reload cycles
-	++PerBulletReloadCycles;
+}
 
-	// Update HUDInfo via broadcast
-	AmmoChangedDelegate.Broadcast(BulletsCurrentlyActive, GetAvailableReloads());
-	BulletsAddedDelegate.Broadcast(BulletsReloaded);
-	
-	bool MaximumBulletsPerLifeReached = (bCapBulletsPerLife && (BulletsExpended == BulletsPerLife));
-	bool MaximumBulletCapacityReached = (BulletsCurrentlyActive >= MaximumBulletCapacity);
-	
-	if (MaximumBulletsPerLifeReached || MaximumBulletCapacityReached) {
 
-		HandleReloadCancel(UReloadCancelTrigger::TriggerByLimitReached);
-		
+// Broadcasts the ammo changes accumulated during this frame as a single notification
+void USAmmoSystemComponent::FlushAmmoNotifications() {
+
+	if (bAmmoChangedPending && bIsAmmoCoreBound) {
+
+		bAmmoChangedPending = false;
+
+		// Values at the end of the frame, whatever happened in-between
+		BroadcastAmmoEvent(AmmoChangedEvent, AmmoChangedDelegate, AmmoState.BulletsCurrentlyActive, VisitAmmoCore([&](auto Policy) { return GetAvailableReloadsWithPolicy<decltype(Policy)>(); }));
+
 	}
-	// if there is no reason to cancel the reload, broadcast the start of a new reload cycle
-	else {
-		
-		PerBulletReloadCycleStartDelegate.Broadcast(ReloadTimeBullet);
-		
+
+	if (PendingBulletsAdded > 0) {
+
+		const uint8 NumBulletsAdded = static_cast<uint8>(FMath::Min(PendingBulletsAdded, static_cast<int32>(MAX_uint8)));
+		PendingBulletsAdded = 0;
+
+		BroadcastAmmoEvent(BulletsAddedEvent, BulletsAddedDelegate, NumBulletsAdded);
+
 	}
-	UE_LOG(LogTemp, Log, TEXT("Loaded %u bullets, current capacity %u out of %u maximum, %u bullets used out of %u maximum per this life"), BulletPerReload, BulletsCurrentlyActive, MaximumBulletCapacity, BulletsExpended, bCapBulletsPerLife ? BulletsPerLife : INT32_MAX);
-	
+
 }
 
 
-// Inner function that handles reload cancelling in passive reload type weapons, after the conditions have been checked
-bool USAmmoSystemComponent::CancelPassiveReload(UReloadCancelTrigger CancelType) {
+// Packs the ammo state into its replicated counterpart and marks it dirty if anything changed (server only)
+void USAmmoSystemComponent::UpdateReplicatedAmmoState() {
 
-	bool Success = false;
+	if (GetOwnerRole() == ROLE_Authority) {
+
+		FSReplicatedAmmoState NewReplicatedAmmoState;
+		NewReplicatedAmmoState.Pack(AmmoState);
+		NewReplicatedAmmoState.LastAcknowledgedAmmoAction = LastAcknowledgedAmmoAction;
+
+		if (!(NewReplicatedAmmoState == ReplicatedAmmoState)) {
+
+			ReplicatedAmmoState = NewReplicatedAmmoState;
+			MARK_PROPERTY_DIRTY_FROM_NAME(USAmmoSystemComponent, ReplicatedAmmoState, this);
+
+		}
 
-	if (CanCancelPassiveReload(CancelType)) {
-		
-		// Reset IsReloading and retrigger protection flags, clear timer
-		bIsReloading = false;
-		bReloadIsBeingCancelled = false;
-		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_InitialDelayTimer);
-		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_NewBulletsTimer);
-
-		// Update HUD info via broadcast
-		PassiveCancelDelegate.Broadcast(CancelType);
-		
-		Success = true;
-		
 	}
-	
-	// if the passive reload cancel operation was successful and the weapon has not been switched out, we want to trigger the reload anew immediately, so we can do it here
-	bool CanRetriggerImmediately = ((CancelType != UReloadCancelTrigger::TriggerByWeaponSwitch) && (CancelType != UReloadCancelTrigger::TriggerByLimitReached));
-	
-	if (!bIsReloading && CanRetriggerImmediately) {
-		
-		HandleReloadTrigger(false);
-		
+
+}
+
+
+// Takes the ammo state received from the server and reconciles the client's prediction with it
+void USAmmoSystemComponent::OnRep_ReplicatedAmmoState() {
+
+	bReceivedReplicatedAmmoState = true;
+
+	// Before BeginPlay there is no reload type yet, BeginPlay takes the state over instead
+	if (bIsAmmoCoreBound) {
+
+		VisitAmmoCore([&](auto Policy) { ReconcileReloadWithPolicy<decltype(Policy)>(); });
+
 	}
 
-	// no need to update HUD info
+}
+
+
+// Returns true on the client that owns the weapon, the only one predicting its ammo actions (the weapon itself is only a simulated proxy there)
+bool USAmmoSystemComponent::IsPredictingAmmo() const {
+
+	const AActor* Weapon = GetOwner();
+	const APawn* WeaponHolder = Weapon ? Cast<APawn>(Weapon->GetOwner()) : nullptr;
+
+	return GetOwnerRole() < ROLE_Authority && WeaponHolder && WeaponHolder->IsLocallyControlled();
 
-	return Success;
-	
 }
 
 
-// Inner function that handles reload cancelling in active magazine reload type weapons, after the conditions have been checked
-bool USAmmoSystemComponent::CancelMagazineReload(UReloadCancelTrigger CancelType) {
+// Returns the time at which an ammo action requested now happens, rounded to what the server receives so both sides run the exact same timeline
+double USAmmoSystemComponent::GetAmmoActionTime() const {
 
-	bool Success = false;
-	
-	if (CanCancelMagazineReload(CancelType)) {
-		
-		// Make weapon available for other actions
-		bIsReloading = false;
+	return FSNetReloadTime(GetAmmoCoreTime()).ToTime();
 
-		// Magazine Reload cancel is instantaneous so we don't need to set bReloadIsBeingCancelled
-	
-		// Clear timers
-		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_NewBulletsTimer);
-		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_ReloadCompletion);
+}
 
-		// update HUD info via broadcast
-		MagazineCancelDelegate.Broadcast();
 
-		Success = true;
-		
+// Records an ammo action predicted by the owning client (its key is assigned here) and sends it to the server
+void USAmmoSystemComponent::PredictAmmoAction(FSPredictedAmmoAction Action) {
+
+	Action.ActionKey = ++LastPredictedAmmoAction;
+	PendingAmmoActions.Add(Action);
+
+	// Shots can come every frame and must not fill the reliable buffer; only the reload triggers and cancels, which are rare and change the whole reload timeline, are sent reliably
+	switch (Action.Type) {
+
+	case ESPredictedAmmoActionType::Consume:
+		ServerConsumeAmmo(Action.bCanBePartial, Action.NumToExpend, FSNetReloadTime(Action.Time), Action.ActionKey);
+		break;
+
+	case ESPredictedAmmoActionType::Trigger:
+		ServerTriggerReload(Action.bWeaponIsBusy, Action.CancelType, FSNetReloadTime(Action.Time), Action.ActionKey);
+		break;
+
+	case ESPredictedAmmoActionType::Cancel:
+		ServerCancelReload(Action.CancelType, FSNetReloadTime(Action.Time), Action.ActionKey);
+		break;
+
 	}
 
-	return Success;
-	
 }
 
 
-// Inner function that handles reload cancelling in active per-bullet reload type weapons, after the conditions have been checked
-bool USAmmoSystemComponent::CancelPerBulletReload(UReloadCancelTrigger CancelType) {
+// Applies an ammo consumption (a shot) predicted by the owning client, at the time it happened there; sent once per shot, so it's unreliable (a lost one is given back to the client by the reconciliation, see ReconcileReloadWithPolicy)
+void USAmmoSystemComponent::ServerConsumeAmmo_Implementation(bool CanBePartial, uint8 NumToExpend, FSNetReloadTime ClientTime, int32 ActionKey) {
 
-	bool Success = false;
+	LastAcknowledgedAmmoAction = FMath::Max(LastAcknowledgedAmmoAction, ActionKey);
 
-	if (CanCancelPerBulletReload(CancelType)) {
-		
-		// If the reload cancel is not caused directly by the player (cancel via weapon action or reload key) or not caused by limit reaching, then cancel must be instantaneous, also stopping retriggering of reload cancel
-		bool bSkipCancelProcess = ((CancelType == UReloadCancelTrigger::TriggerByWeaponSwitch) || (CancelType == UReloadCancelTrigger::TriggerByExternal));
-	
-		UE_LOG(LogTemp, Log, TEXT("Per-bullet reload status, bSkipCancelProcess %u, bReloadIsBeingCancelled %u"), bSkipCancelProcess, bReloadIsBeingCancelled);
-		
-		// todo LOW PRIORITY: perhaps this could be nerfed as otherwise, weapon switching will yield an advantage vs letting the reload time finish?
-		if (bSkipCancelProcess) {
+	if (bIsAmmoCoreBound) {
+
+		const double ActionTime = GetPredictedActionTime(ClientTime);
+		uint8 BulletsTrulyExpended = 0;
+		VisitAmmoCore([&](auto Policy) { return ConsumeAmmoWithPolicy<decltype(Policy)>(CanBePartial, NumToExpend, BulletsTrulyExpended, ActionTime); });
 
-			// No need to set flag against retrigger because cancel is automatic
-		
-			// Clear timer for reloading and complete cancel instantly
-			GetWorld()->GetTimerManager().ClearTimer(TimerHandle_InitialDelayTimer);
-			GetWorld()->GetTimerManager().ClearTimer(TimerHandle_NewBulletsTimer);
-			OnCompleteWithCancelPerBulletReload();
-			
-			UE_LOG(LogTemp, Log, TEXT("Per-bullet reload cancelled without delay"));
-
-			Success = true;
-		}
-		else {
-		
-			if (PerBulletReloadCycles < 1) {
-
-				// do nothing, intentional
-				// we want to guarantee that section 2 of the reload is executed at least once before a reload cancel triggered by the weapon owner is accepted
-				// this is to prevent constant trigger and cancel of reloading when holding the weapon attack button endlessly
-
-				UE_LOG(LogTemp, Log, TEXT("Reload cancel request rejected, only %u reload cycles have been completed out of 1 minimum"), PerBulletReloadCycles);
-			
-			}
-			else if (!bReloadIsBeingCancelled) {
-
-				// Set protective flag against retrigger
-				bReloadIsBeingCancelled = true;
-			
-				// Clear timer for reloading and set timer for "freeing" up this weapon
-				GetWorld()->GetTimerManager().ClearTimer(TimerHandle_InitialDelayTimer);
-				GetWorld()->GetTimerManager().ClearTimer(TimerHandle_NewBulletsTimer);
-				GetWorld()->GetTimerManager().SetTimer(TimerHandle_ReloadCompletion, this, &USAmmoSystemComponent::OnCompleteWithSuccessPerBulletReload, ReloadEndTimeBullet);
-
-				// update HUD via broadcast (timed cancel)
-				PerBulletTimedCancelDelegate.Broadcast(ReloadEndTimeBullet);
-				
-				// start playing reload end animation
-				UE_LOG(LogTemp, Log, TEXT("Per-bullet reload cancelled with delay"));
-
-				Success = true;
-			
-			}
-		
-		}
-		
 	}
-	
-	return Success;
-	
+
+	UpdateReplicatedAmmoState();
+
 }
 
 
-// Inner function that handles the cancelling of the per-bullet reload proper in case it's a timed cancel
-void USAmmoSystemComponent::OnCompleteWithSuccessPerBulletReload() {
-		
-	// update HUD via broadcast (timed cancel)
-	PerBulletCompleteDelegate.Broadcast();
+// Applies a reload trigger predicted by the owning client, at the time it happened there
+void USAmmoSystemComponent::ServerTriggerReload_Implementation(bool WeaponIsBusy, UReloadCancelTrigger CancelType, FSNetReloadTime ClientTime, int32 ActionKey) {
+
+	// Acknowledged whatever the outcome, so the client knows to stop replaying it
+	LastAcknowledgedAmmoAction = FMath::Max(LastAcknowledgedAmmoAction, ActionKey);
+
+	if (bIsAmmoCoreBound) {
+
+		const double ActionTime = GetPredictedActionTime(ClientTime);
+		const bool Success = VisitAmmoCore([&](auto Policy) { return TriggerReloadWithPolicy<decltype(Policy)>(WeaponIsBusy, CancelType, ActionTime); });
+		COOP_TRACE_WEAPON(ReloadTriggered, GetOwner(), Success, static_cast<int32>(CancelType));
+
+	}
+
+	UpdateReplicatedAmmoState();
 
-	OnCompletePerBulletReload();
-	
 }
 
 
-// Inner function that handles the cancelling of the per-bullet reload proper in case it's an instant cancel
-void USAmmoSystemComponent::OnCompleteWithCancelPerBulletReload() {
+// Applies a reload cancel predicted by the owning client, at the time it happened there
+void USAmmoSystemComponent::ServerCancelReload_Implementation(UReloadCancelTrigger CancelType, FSNetReloadTime ClientTime, int32 ActionKey) {
 
-	// update HUD via broadcast (timed cancel)
-	PerBulletInstantCancelDelegate.Broadcast();
+	LastAcknowledgedAmmoAction = FMath::Max(LastAcknowledgedAmmoAction, ActionKey);
+
+	if (bIsAmmoCoreBound) {
+
+		const double ActionTime = GetPredictedActionTime(ClientTime);
+		const bool Success = VisitAmmoCore([&](auto Policy) { return CancelReloadWithPolicy<decltype(Policy)>(CancelType, ActionTime); });
+		COOP_TRACE_WEAPON(ReloadCancelled, GetOwner(), Success, static_cast<int32>(CancelType));
+
+	}
+
+	UpdateReplicatedAmmoState();
 
-	OnCompletePerBulletReload();
-	
 }
 
 
-// Inner function that handles the cancelling of the per-bullet reload proper after the animation has played
-void USAmmoSystemComponent::OnCompletePerBulletReload() {
-	
-	// Reset protection flags (IsReloading, retrigger and minimum cycles), clear timer and update HUD
-	bIsReloading = false;
-	bReloadIsBeingCancelled = false;
-	PerBulletReloadCycles = 0;
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_ReloadCompletion);
+// Returns the time at which the server applies an action predicted by the client: the client's own timestamp, as long as it's neither in the future, too far in the past nor before the previous action
+double USAmmoSystemComponent::GetPredictedActionTime(const FSNetReloadTime& ClientTime) {
+
+	const double Now = GetAmmoCoreTime();
+
+	LastPredictedActionTime = FMath::Max(FMath::Clamp(ClientTime.ToTime(), Now - MaxReloadPredictionRewind, Now), LastPredictedActionTime);
+
+	return LastPredictedActionTime;
 
-	UE_LOG(LogTemp, Log, TEXT("Per-bullet reload finished"));
-	
 }
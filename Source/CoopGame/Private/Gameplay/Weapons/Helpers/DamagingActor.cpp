@@ -9,6 +9,7 @@
 #include "Gameplay/Characters/TargetDummy.h"
 #include "Gameplay/Characters/SPlayerCharacter.h"
 #include "CoopGame/CoopGame.h"
+#include "General/SCosmeticEffectsSubsystem.h"
 
 
 
@@ -94,9 +95,11 @@ void ADamagingActor::OnHit(UPrimitiveComponent* HitComponent, AActor* OtherActor
 void ADamagingActor::Explode() {
 
 	IConsoleVariable* debugDrawVariable =
-		IConsoleManager::Get().FindConsoleVariable(TEXT("DebugWeaponDrawing"));
+		IConsoleManager::Get().FindConsoleVariable(TEXT("COOP.DebugWeapons"));
 
-	if (debugDrawVariable && debugDrawVariable->GetInt() > 0) {
+	const bool bPlayCosmetics = USCosmeticEffectsSubsystem::AreCosmeticsEnabled(GetWorld());
+
+	if (bPlayCosmetics && debugDrawVariable && debugDrawVariable->GetInt() > 0) {
 
 		DrawDebugSphere(GetWorld(), GetActorLocation(), ExplosionRadius, 12, FColor::Red, false, 5.0f, 0, 0);
 		
@@ -104,7 +107,11 @@ void ADamagingActor::Explode() {
 	
 	UGameplayStatics::ApplyRadialDamage(GetWorld(), BaseDamage, GetActorLocation(), ExplosionRadius, DamageType, TArray<AActor*>(), this, GetOwner()->GetInstigatorController(), true, COLLISION_WEAPON);
 
-	PlayExplosionEffects();
+	if (bPlayCosmetics) {
+
+		PlayExplosionEffects();
+
+	}
 	
 	this->Destroy();
 	
@@ -114,10 +121,11 @@ void ADamagingActor::Explode() {
 // Function that triggers the emitting of the particle effects and sound effects on explosion
 void ADamagingActor::PlayExplosionEffects() {
 
-	if (ExplosionParticle) {
+	USCosmeticEffectsSubsystem* CosmeticsSubsystem = GetWorld()->GetSubsystem<USCosmeticEffectsSubsystem>();
+	if (ExplosionParticle && CosmeticsSubsystem) {
 
-		UParticleSystemComponent* ExplosionVFX = UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplosionParticle, GetActorLocation(), GetActorRotation());
-		ExplosionVFX->SetWorldScale3D(ExplosionParticleScale);
+		// Explosions are the most important feedback there is, they're only dropped if nobody can see them
+		CosmeticsSubsystem->SpawnEmitterAtLocation(ExplosionParticle, GetActorLocation(), GetActorRotation(), ExplosionParticleScale, UCosmeticEffectPriority::High);
 		
 	}
 
@@ -0,0 +1,357 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "Gameplay/Weapons/Helpers/FireModes.h"
+#include "Gameplay/Weapons/Types/Shooting/SShootingWeapon.h"
+#include "General/SFireSchedulerSubsystem.h"
+#include "General/SLogCategories.h"
+
+
+
+// Time between fires of the modes that fire once per press (large number intentionally, it only makes sure a press never waits on the previous shot)
+static constexpr float SingleShotTimeBetweenFires = 1E7;
+
+
+
+// Builds the entry points of a fire mode policy (one shared instance per policy)
+template<typename PolicyType>
+static const FSFireModeBinding& BindFireMode() {
+
+	static const FSFireModeBinding Binding = { &PolicyType::Initialize, &PolicyType::Press, &PolicyType::Release, &PolicyType::Cancel };
+
+	return Binding;
+
+}
+
+
+
+/*
+ *
+ *	Automatic fire: repeated fire at RateOfFireAutomatic while held
+ *
+ */
+struct FSFireModes::FSAutomatic {
+
+	// Registers the weapon for repeated fire at its rate of fire
+	static void Initialize(ASShootingWeapon& Weapon) {
+
+		Weapon.TimeBetweenFires = 1 / Weapon.GetTuning(&USWeaponDefinition::RateOfFireAutomatic, Weapon.RateOfFireAutomatic);
+
+		if (Weapon.FireScheduler) {
+
+			Weapon.FireScheduler->RegisterWeapon(&Weapon, Weapon.TimeBetweenFires, 0, 0.0f);
+
+		}
+
+	}
+
+	// Starts repeated fire, delaying the first shot so a quick re-press doesn't beat the rate of fire
+	static void Press(ASShootingWeapon& Weapon) {
+
+		const float FirstDelay = FMath::Max(Weapon.LastFireTime + Weapon.TimeBetweenFires - Weapon.GetWorld()->TimeSeconds, 0.0f);
+
+		if (Weapon.FireScheduler) {
+
+			Weapon.FireScheduler->PressTrigger(&Weapon, FirstDelay);
+
+		}
+
+	}
+
+	// Stops repeated fire and clears the weapon "busy" status
+	static void Release(ASShootingWeapon& Weapon) {
+
+		if (Weapon.FireScheduler) {
+
+			Weapon.FireScheduler->ReleaseTrigger(&Weapon);
+
+		}
+
+		Weapon.bReloadBlockedByWeapon = false;
+
+	}
+
+	// Same as a release
+	static void Cancel(ASShootingWeapon& Weapon) {
+
+		Release(Weapon);
+
+	}
+
+};
+
+
+/*
+ *
+ *	Manual fire: one shot per press, then firing is blocked for TimeBetweenShotsManual
+ *
+ */
+struct FSFireModes::FSManual {
+
+	// Registers the weapon with its block between shots
+	static void Initialize(ASShootingWeapon& Weapon) {
+
+		Weapon.TimeBetweenFires = SingleShotTimeBetweenFires;
+
+		if (Weapon.FireScheduler) {
+
+			Weapon.FireScheduler->RegisterWeapon(&Weapon, Weapon.TimeBetweenFires, 0, Weapon.GetTuning(&USWeaponDefinition::TimeBetweenShotsManual, Weapon.TimeBetweenShotsManual));
+
+		}
+
+	}
+
+	// Fires once, right away
+	static void Press(ASShootingWeapon& Weapon) {
+
+		if (Weapon.FireScheduler) {
+
+			Weapon.FireScheduler->FireManualShot(&Weapon);
+
+		}
+
+	}
+
+	// Clears the weapon "busy" status
+	static void Release(ASShootingWeapon& Weapon) {
+
+		Weapon.bReloadBlockedByWeapon = false;
+
+	}
+
+	// Same as a release
+	static void Cancel(ASShootingWeapon& Weapon) {
+
+		Release(Weapon);
+
+	}
+
+};
+
+
+/*
+ *
+ *	Burst fire: repeated fire at RateOfFireBurst while held, blocked for TimeBetweenBursts after every ShotsInBurst shots
+ *
+ */
+struct FSFireModes::FSBurst {
+
+	// Registers the weapon for repeated fire with its burst size and the pause between bursts
+	static void Initialize(ASShootingWeapon& Weapon) {
+
+		Weapon.TimeBetweenFires = 1 / Weapon.GetTuning(&USWeaponDefinition::RateOfFireBurst, Weapon.RateOfFireBurst);
+
+		if (Weapon.FireScheduler) {
+
+			Weapon.FireScheduler->RegisterWeapon(&Weapon, Weapon.TimeBetweenFires, Weapon.GetTuning(&USWeaponDefinition::ShotsInBurst, Weapon.ShotsInBurst), Weapon.GetTuning(&USWeaponDefinition::TimeBetweenBursts, Weapon.TimeBetweenBursts));
+
+		}
+
+	}
+
+	// Starts repeated fire, like automatic fire
+	static void Press(ASShootingWeapon& Weapon) {
+
+		FSAutomatic::Press(Weapon);
+
+	}
+
+	// Stops repeated fire, like automatic fire
+	static void Release(ASShootingWeapon& Weapon) {
+
+		FSAutomatic::Release(Weapon);
+
+	}
+
+	// Same as a release
+	static void Cancel(ASShootingWeapon& Weapon) {
+
+		Release(Weapon);
+
+	}
+
+};
+
+
+/*
+ *
+ *	Charge fire: the shot charges while held and is fired on release, scaled by the charge
+ *
+ */
+struct FSFireModes::FSCharge {
+
+	// Registers the weapon with its cooldown between charged shots
+	static void Initialize(ASShootingWeapon& Weapon) {
+
+		Weapon.TimeBetweenFires = SingleShotTimeBetweenFires;
+
+		if (Weapon.FireScheduler) {
+
+			Weapon.FireScheduler->RegisterWeapon(&Weapon, Weapon.TimeBetweenFires, 0, Weapon.GetTuning(&USWeaponDefinition::ChargeCooldown, Weapon.ChargeCooldown));
+
+		}
+
+	}
+
+	// Starts charging; the weapon is "busy" while charging
+	static void Press(ASShootingWeapon& Weapon) {
+
+		Weapon.bIsCharging = true;
+		Weapon.ChargeStartTime = Weapon.GetWorld()->TimeSeconds;
+		Weapon.bReloadBlockedByWeapon = true;
+
+	}
+
+	// Fires the charged shot, if it was charged long enough
+	static void Release(ASShootingWeapon& Weapon) {
+
+		if (Weapon.bIsCharging) {
+
+			const float ChargeFraction = FMath::Clamp((Weapon.GetWorld()->TimeSeconds - Weapon.ChargeStartTime) / Weapon.GetTuning(&USWeaponDefinition::FullChargeTime, Weapon.FullChargeTime), 0.0f, 1.0f);
+
+			if (ChargeFraction >= Weapon.GetTuning(&USWeaponDefinition::MinimumChargeFraction, Weapon.MinimumChargeFraction) && Weapon.FireScheduler) {
+
+				// The damage scale only applies to this shot
+				Weapon.ShotDamageScale = ChargeFraction;
+				Weapon.FireScheduler->FireManualShot(&Weapon);
+				Weapon.ShotDamageScale = 1.0f;
+
+			}
+			else {
+
+				UE_LOG(LogCoopWeapon, Verbose, TEXT("Charge released at %.2f, below the minimum charge"), ChargeFraction);
+
+			}
+
+			// Once the shot is out, as firing marks the weapon "busy" again
+			Cancel(Weapon);
+
+		}
+
+	}
+
+	// Drops the charge without firing
+	static void Cancel(ASShootingWeapon& Weapon) {
+
+		Weapon.bIsCharging = false;
+		Weapon.bReloadBlockedByWeapon = false;
+
+	}
+
+};
+
+
+/*
+ *
+ *	Continuous fire: sustained fire at ContinuousTickRate ticks per second from the press to the release, ShotDamage being per second
+ *
+ */
+struct FSFireModes::FSContinuous {
+
+	// Registers the weapon for repeated fire at its tick rate; every tick deals the damage of its duration
+	static void Initialize(ASShootingWeapon& Weapon) {
+
+		Weapon.TimeBetweenFires = 1 / Weapon.GetTuning(&USWeaponDefinition::ContinuousTickRate, Weapon.ContinuousTickRate);
+		Weapon.ShotDamageScale = Weapon.TimeBetweenFires;
+
+		if (Weapon.FireScheduler) {
+
+			Weapon.FireScheduler->RegisterWeapon(&Weapon, Weapon.TimeBetweenFires, 0, 0.0f);
+
+		}
+
+	}
+
+	// Starts the stream right away, there is no rate of fire to respect between presses
+	static void Press(ASShootingWeapon& Weapon) {
+
+		if (Weapon.FireScheduler) {
+
+			Weapon.FireScheduler->PressTrigger(&Weapon, 0.0f);
+
+		}
+
+	}
+
+	// Stops the stream, like automatic fire
+	static void Release(ASShootingWeapon& Weapon) {
+
+		FSAutomatic::Release(Weapon);
+
+	}
+
+	// Same as a release
+	static void Cancel(ASShootingWeapon& Weapon) {
+
+		Release(Weapon);
+
+	}
+
+};
+
+
+/*
+ *
+ *	No valid weapon type configured: nothing is ever fired
+ *
+ */
+struct FSFireModes::FSInvalid {
+
+	// Leaves the weapon out of the fire scheduler
+	static void Initialize(ASShootingWeapon& Weapon) {
+
+		Weapon.TimeBetweenFires = SingleShotTimeBetweenFires;
+
+		UE_LOG(LogCoopWeapon, Error, TEXT("Invalid mode selected!"));
+
+	}
+
+	// Nothing to fire
+	static void Press(ASShootingWeapon& Weapon) {
+
+		UE_LOG(LogCoopWeapon, Error, TEXT("Invalid mode selected!"));
+
+	}
+
+	// Nothing to stop
+	static void Release(ASShootingWeapon& Weapon) {
+
+	}
+
+	// Nothing to stop
+	static void Cancel(ASShootingWeapon& Weapon) {
+
+	}
+
+};
+
+
+
+// Returns the entry points of the fire mode of the given weapon type
+const FSFireModeBinding& FSFireModes::Resolve(UShootingWeaponType WeaponType) {
+
+	// The only place in which the weapon type is looked at, everything afterwards goes straight to its policy
+	switch (WeaponType) {
+
+	case UShootingWeaponType::AutomaticFire:
+		return BindFireMode<FSAutomatic>();
+
+	case UShootingWeaponType::ManualFire:
+		return BindFireMode<FSManual>();
+
+	case UShootingWeaponType::BurstFire:
+		return BindFireMode<FSBurst>();
+
+	case UShootingWeaponType::ChargeFire:
+		return BindFireMode<FSCharge>();
+
+	case UShootingWeaponType::ContinuousFire:
+		return BindFireMode<FSContinuous>();
+
+	default:
+		return BindFireMode<FSInvalid>();
+
+	}
+
+}
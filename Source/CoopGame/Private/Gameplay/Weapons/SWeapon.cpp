@@ -5,6 +5,11 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "Gameplay/Characters/SPlayerCharacter.h"
+#include "Gameplay/Weapons/Helpers/AmmoCore.h"
+#include "General/SCosmeticEffectsSubsystem.h"
+#include "General/SCharacterPlayerController.h"
+#include "General/SLogCategories.h"
+#include "General/SWeaponTrace.h"
 
 
 
@@ -23,6 +28,15 @@ ASWeapon::ASWeapon() {
 
 	// active status is false by default
 	IsActive = false;
+
+	// inactive weapons hibernate by default
+	bHibernateWhenInactive = true;
+	ReactivationBudgetMs = 0.25f;
+	bIsHibernating = false;
+
+	// Spawned by the server and replicated along with its owner (see USCharacterEquipmentComponent), so its ammo state can reach the owning client
+	bReplicates = true;
+	bNetUseOwnerRelevancy = true;
 	
 }
 
@@ -30,7 +44,7 @@ ASWeapon::ASWeapon() {
 // Execute the pressing action of this weapon's primary action (to be fully overriden by child classes, no Super!)
 void ASWeapon::OnPrimaryWeaponActionPressed() {
 
-	UE_LOG(LogTemp, Log, TEXT("Pressed weapon primary button"));
+	UE_LOG(LogCoopWeapon, Verbose, TEXT("Pressed weapon primary button"));
 	
 }
 
@@ -38,7 +52,7 @@ void ASWeapon::OnPrimaryWeaponActionPressed() {
 // Execute the releasing action of this weapon's primary action (to be fully overriden by child classes, no Super!)
 void ASWeapon::OnPrimaryWeaponActionReleased() {
 	
-	UE_LOG(LogTemp, Log, TEXT("Released weapon primary button"));
+	UE_LOG(LogCoopWeapon, Verbose, TEXT("Released weapon primary button"));
 	
 }
 
@@ -46,7 +60,7 @@ void ASWeapon::OnPrimaryWeaponActionReleased() {
 // Execute the pressing action of this weapon's secondary action (to be fully overriden by child classes, no Super!)
 void ASWeapon::OnSecondaryWeaponActionPressed() {
 	
-	UE_LOG(LogTemp, Log, TEXT("Pressed weapon secondary button"));
+	UE_LOG(LogCoopWeapon, Verbose, TEXT("Pressed weapon secondary button"));
 	
 }
 
@@ -54,7 +68,7 @@ void ASWeapon::OnSecondaryWeaponActionPressed() {
 // Execute the releasing action of this weapon's secondary action (to be fully overriden by child classes, no Super!)
 void ASWeapon::OnSecondaryWeaponActionReleased() {
 	
-	UE_LOG(LogTemp, Log, TEXT("Released weapon secondary button"));
+	UE_LOG(LogCoopWeapon, Verbose, TEXT("Released weapon secondary button"));
 	
 }
 
@@ -62,7 +76,7 @@ void ASWeapon::OnSecondaryWeaponActionReleased() {
 // Call the weapon reload function
 void ASWeapon::OnReloadPressed() {
 
-	UE_LOG(LogTemp, Log, TEXT("Pressed reload button"));
+	UE_LOG(LogCoopWeapon, Verbose, TEXT("Pressed reload button"));
 	
 }
 
@@ -70,11 +84,18 @@ void ASWeapon::OnReloadPressed() {
 // Make the player camera's shake according to the weapon's parameters
 void ASWeapon::ShakePlayerCamera() {
 	
-	if (WeaponOwner) {
+	if (WeaponOwner && USCosmeticEffectsSubsystem::AreCosmeticsEnabled(GetWorld())) {
 
 		APlayerController* PC = Cast<APlayerController>(WeaponOwner->GetController());
+		ASCharacterPlayerController* CharacterPC = Cast<ASCharacterPlayerController>(PC);
+
+		// Shakes are folded into a single per-frame shake by our player controller; other controllers get one shake per request
+		if (CharacterPC) {
 
-		if (PC) {
+			CharacterPC->RequestCameraShake(UseCameraShake);
+
+		}
+		else if (PC) {
 
 			PC->ClientStartCameraShake(UseCameraShake);
 			
@@ -93,6 +114,9 @@ bool ASWeapon::ActivateWeapon() {
 
 	IsActive = true;
 
+	// wake the weapon up before anything else touches its components
+	SetHibernating(false);
+
 	// make weapon visible
 	MeshComp->SetCastShadow(true);
 	MeshComp->SetVisibility(true, true);
@@ -101,7 +125,8 @@ bool ASWeapon::ActivateWeapon() {
 
 		// set success flag
 		Success = true;
-		UE_LOG(LogTemp, Log, TEXT("Weapon %s activated"), *(FullWeaponName.ToString()));
+		UE_LOG(LogCoopWeapon, Verbose, TEXT("Weapon %s activated"), *(FullWeaponName.ToString()));
+		COOP_TRACE_WEAPON(WeaponActivated, this);
 		
 	}
 	
@@ -125,11 +150,19 @@ bool ASWeapon::DeactivateWeapon() {
 	// cancel any actions currently happening
 	CancelOngoingActions();
 
+	// put the weapon to sleep once nothing is going on anymore
+	if (bHibernateWhenInactive) {
+
+		SetHibernating(true);
+
+	}
+
 	if (!IsActive && !(MeshComp->IsVisible())) {
 
 		// set success flag
 		Success = true;
-		UE_LOG(LogTemp, Log, TEXT("Weapon %s deactivated"), *(FullWeaponName.ToString()));
+		UE_LOG(LogCoopWeapon, Verbose, TEXT("Weapon %s deactivated"), *(FullWeaponName.ToString()));
+		COOP_TRACE_WEAPON(WeaponDeactivated, this);
 		
 	}
 	
@@ -138,10 +171,60 @@ bool ASWeapon::DeactivateWeapon() {
 }
 
 
+// Puts the weapon to sleep or wakes it up (no-op if it already is in the requested state); waking up is timed against ReactivationBudgetMs
+void ASWeapon::SetHibernating(bool bHibernate) {
+
+	if (bHibernate != bIsHibernating) {
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		bIsHibernating = bHibernate;
+		SetComponentsHibernating(bHibernate);
+
+		if (!bHibernate) {
+
+			const double WakeUpTimeMs = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+			const bool bOverBudget = WakeUpTimeMs > ReactivationBudgetMs;
+
+			COOP_TRACE_WEAPON(WeaponWoken, this, FMath::RoundToInt(WakeUpTimeMs * 1000.0), bOverBudget);
+
+			if (bOverBudget) {
+
+				UE_LOG(LogCoopWeapon, Warning, TEXT("Weapon %s took %.3f ms to wake up, over its budget of %.3f ms"), *(FullWeaponName.ToString()), WakeUpTimeMs, ReactivationBudgetMs);
+
+			}
+
+		}
+
+	}
+
+}
+
+
+// Gets an inactive weapon ready to be switched to, so its activation is only a state flip (Super should always be called on child classes!)
+void ASWeapon::PrewarmWeapon() {
+
+	SetHibernating(false);
+
+}
+
+
+// Puts an inactive weapon back to sleep after a pre-warm that wasn't followed by a switch
+void ASWeapon::CoolDownWeapon() {
+
+	if (!IsActive && bHibernateWhenInactive) {
+
+		SetHibernating(true);
+
+	}
+
+}
+
+
 // Function to be defined by child classes for automatic activation of weapon stereotype/specific actions (Super should always be called on child classes!)
 void ASWeapon::TriggerAutomaticActions() {
 
-	UE_LOG(LogTemp, Log, TEXT("Activating automatic properties of weapon %s"), *(FullWeaponName.ToString()));
+	UE_LOG(LogCoopWeapon, Verbose, TEXT("Activating automatic properties of weapon %s"), *(FullWeaponName.ToString()));
 	
 }
 
@@ -149,7 +232,7 @@ void ASWeapon::TriggerAutomaticActions() {
 // Requests broadcast of information from the subcomponents after this weapon's activation has been confirmed to be successful and broadcast
 void ASWeapon::RequestSubcomponentBroadcast() {
 
-	UE_LOG(LogTemp, Log, TEXT("Subcomponent broadcast requested"));
+	UE_LOG(LogCoopWeapon, Verbose, TEXT("Subcomponent broadcast requested"));
 	
 }
 
@@ -162,6 +245,30 @@ UReloadType ASWeapon::GetReloadType() const {
 }
 
 
+// Takes a snapshot of this weapon's ammo state; returns false if the weapon has no ammo state (default, should be overwritten by child classes with an ammo system)
+bool ASWeapon::CaptureAmmoSnapshot(FSAmmoSnapshot& OutSnapshot) {
+
+	return false;
+
+}
+
+
+// Restores a snapshot of this weapon's ammo state; returns false if the weapon has no ammo state or the snapshot doesn't fit it (default, should be overwritten by child classes with an ammo system)
+bool ASWeapon::RestoreAmmoSnapshot(const FSAmmoSnapshot& Snapshot) {
+
+	return false;
+
+}
+
+
+// Starts this weapon's ammo state anew, as if the weapon had just been spawned; returns false if the weapon has no ammo state (default, should be overwritten by child classes with an ammo system)
+bool ASWeapon::ResetAmmoState() {
+
+	return false;
+
+}
+
+
 // Get the name of the socket to which the weapon shall attach to
 const FName& ASWeapon::GetCharacterSocketName() const {
 
@@ -186,9 +293,55 @@ bool ASWeapon::IsWeaponActive() const {
 }
 
 
+// Get the weapon's hibernation status
+bool ASWeapon::IsWeaponHibernating() const {
+
+	return bIsHibernating;
+	
+}
+
+
 // Function to be defined by child classes for cancelling of weapon stereotype/specific actions (Super should always be called on child classes!)
 void ASWeapon::CancelOngoingActions() {
 
-	UE_LOG(LogTemp, Log, TEXT("Cancelling actions of weapon %s"), *(FullWeaponName.ToString()));
+	UE_LOG(LogCoopWeapon, Verbose, TEXT("Cancelling actions of weapon %s"), *(FullWeaponName.ToString()));
 	
 }
+
+
+// Function to be extended by child classes to put their own components to sleep or wake them up (Super should always be called on child classes!)
+void ASWeapon::SetComponentsHibernating(bool bHibernating) {
+
+	SetActorTickEnabled(!bHibernating);
+
+	if (MeshComp) {
+
+		// the mesh stays registered (it's the root the weapon is attached by), it only stops ticking and updating its pose
+		MeshComp->SetComponentTickEnabled(!bHibernating);
+		MeshComp->bNoSkeletonUpdate = bHibernating;
+		MeshComp->bPauseAnims = bHibernating;
+
+	}
+
+}
+
+
+// Unregisters a non-essential component while hibernating and registers it back on wake-up
+void ASWeapon::SetComponentRegistered(UActorComponent* Component, bool bRegistered) {
+
+	if (Component && Component->IsRegistered() != bRegistered) {
+
+		if (bRegistered) {
+
+			Component->RegisterComponent();
+
+		}
+		else {
+
+			Component->UnregisterComponent();
+
+		}
+
+	}
+
+}
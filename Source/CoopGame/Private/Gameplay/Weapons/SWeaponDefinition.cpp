@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "Gameplay/Weapons/SWeaponDefinition.h"
+
+
+
+// Primary asset type of every weapon definition
+const FPrimaryAssetType USWeaponDefinition::PrimaryAssetType = TEXT("WeaponDefinition");
+
+// Bundle holding the assets needed in game (effects)
+const FName USWeaponDefinition::GameBundle = TEXT("Game");
+
+
+
+// Sets default values for this definition's properties
+USWeaponDefinition::USWeaponDefinition() {
+
+	// Same defaults as a shooting weapon without a definition
+	WeaponType = UShootingWeaponType::AutomaticFire;
+	BulletPerAttack = 1;
+	bCanPartialFire = false;
+	RateOfFireAutomatic = 10.0f;
+	TimeBetweenShotsManual = 2.0f;
+	ShotsInBurst = 5;
+	RateOfFireBurst = 10.0f;
+	TimeBetweenBursts = 1.0f;
+	FullChargeTime = 1.0f;
+	MinimumChargeFraction = 0.25f;
+	ChargeCooldown = 0.5f;
+	ContinuousTickRate = 20.0f;
+	BaseSpread = 0.0f;
+	SpreadPerShot = 0.0f;
+	MaxSpread = 0.0f;
+	RecoilPitchPerShot = 0.0f;
+	MaxRecoilPitch = 0.0f;
+	RecoilYawPerShot = 0.0f;
+	MaxRecoilYaw = 0.0f;
+	RecoilRecoveryHalfLife = 0.2f;
+	MuzzleEffectScale = FVector(1.0f);
+	MuzzleSocketName = FName("default_muzzle_socket");
+
+}
+
+
+// Identifies the definition to the asset manager
+FPrimaryAssetId USWeaponDefinition::GetPrimaryAssetId() const {
+
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+
+}
@@ -0,0 +1,285 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "Gameplay/Weapons/Types/Shooting/SBeamWeapon.h"
+#include "CoopGame/CoopGame.h"
+#include "Gameplay/Characters/SPlayerCharacter.h"
+#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "General/SCosmeticEffectsSubsystem.h"
+
+
+
+// Sets default values for this actor's properties
+ASBeamWeapon::ASBeamWeapon() {
+
+	WeaponType = UShootingWeaponType::ContinuousFire;
+	BeamRange = 3000.0f;
+	BeamRadius = 10.0f;
+	SweepsPerDamageBatch = 5;
+	BeamTargetName = FName("BeamEnd");
+	BeamVFXComp = nullptr;
+	SweepsInDamageBatch = 0;
+
+}
+
+
+// Execute the releasing action of this weapon's primary action
+void ASBeamWeapon::OnPrimaryWeaponActionReleased() {
+
+	Super::OnPrimaryWeaponActionReleased();
+
+	// Whatever was dealt since the last batch is applied right away
+	ApplyBeamDamage();
+	SetBeamEffectActive(false);
+
+}
+
+
+// Gets an inactive beam weapon ready to be switched to, its beam emitter included
+void ASBeamWeapon::PrewarmWeapon() {
+
+	Super::PrewarmWeapon();
+
+	SetupBeamEffect();
+
+}
+
+
+// Called when the game starts or when spawned
+void ASBeamWeapon::BeginPlay() {
+
+	Super::BeginPlay();
+
+	SetupBeamEffect();
+
+}
+
+
+// Called when the game ends or the weapon is destroyed
+void ASBeamWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+
+	// Damage still accumulated is only dealt if the weapon goes away mid-game, not when the whole world is torn down (PIE end, level transition, quit)
+	if (EndPlayReason == EEndPlayReason::Destroyed || EndPlayReason == EEndPlayReason::RemovedFromWorld) {
+
+		ApplyBeamDamage();
+
+	}
+
+	Super::EndPlay(EndPlayReason);
+
+}
+
+
+// Implements the cancelling of actions common to all beam weapons
+void ASBeamWeapon::CancelOngoingActions() {
+
+	// reload request cancel and primary action termination is already handled in the parent class
+	Super::CancelOngoingActions();
+
+	ApplyBeamDamage();
+	SetBeamEffectActive(false);
+
+}
+
+
+// Puts the beam emitter to sleep or wakes it up, along with the components common to all shooting weapons
+void ASBeamWeapon::SetComponentsHibernating(bool bHibernating) {
+
+	Super::SetComponentsHibernating(bHibernating);
+
+	SetComponentRegistered(BeamVFXComp, !bHibernating);
+
+}
+
+
+// Fires a sweep of the beam like any other shooting weapon; a sweep that is refused (out of ammo, reloading, firing blocked) turns the beam off and applies the damage dealt so far
+bool ASBeamWeapon::FireWeapon(bool bFiringBlocked, double ShotTime) {
+
+	const bool FiringSuccess = Super::FireWeapon(bFiringBlocked, ShotTime);
+
+	// The trigger may still be held, the beam comes back on with the next sweep that goes through (e.g.: once reloaded)
+	if (!FiringSuccess) {
+
+		ApplyBeamDamage();
+		SetBeamEffectActive(false);
+
+	}
+
+	return FiringSuccess;
+
+}
+
+
+// Implements the logic specific to this subclass of shooting weapon; in this case, a sweep of the beam whose damage is accumulated on the target
+bool ASBeamWeapon::HandleSpecificFiring(const uint8& BulletsConsumed) {
+
+	FHitResult Hit;
+	FVector ShotDirection;
+	FVector BeamEnd;
+
+	if (SweepBeam(Hit, ShotDirection, BeamEnd)) {
+
+		AccumulateBeamDamage(Hit, ShotDirection);
+
+	}
+
+	if (++SweepsInDamageBatch >= SweepsPerDamageBatch) {
+
+		ApplyBeamDamage();
+
+	}
+
+	// Only the target of the persistent emitter moves, nothing is spawned per sweep
+	if (USCosmeticEffectsSubsystem::AreCosmeticsEnabled(GetWorld())) {
+
+		SetBeamEffectActive(true);
+
+		if (BeamVFXComp) {
+
+			BeamVFXComp->SetVectorParameter(BeamTargetName, BeamEnd);
+
+		}
+
+	}
+
+	return true;
+
+}
+
+
+// Sweeps the beam from the owner's point of view; returns true if it touched anything, along with the hit and the beam's end
+bool ASBeamWeapon::SweepBeam(FHitResult& Hit, FVector& ShotDirection, FVector& BeamEnd) {
+
+	bool BlockingHit = false;
+
+	if (WeaponOwner) {
+
+		FVector EyeLocation;
+		FRotator EyeRotation;
+		WeaponOwner->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+
+		ShotDirection = GetShotAimRotation(EyeRotation).Vector();
+		BeamEnd = EyeLocation + (ShotDirection * BeamRange);
+
+		// Disable the sweep from detecting the weapon itself and its owner
+		FCollisionQueryParams QueryParams;
+		QueryParams.AddIgnoredActor(WeaponOwner);
+		QueryParams.AddIgnoredActor(this);
+		QueryParams.bReturnPhysicalMaterial = true;
+
+		if (BeamRadius > 0.0f) {
+
+			BlockingHit = GetWorld()->SweepSingleByChannel(Hit, EyeLocation, BeamEnd, FQuat::Identity, COLLISION_WEAPON, FCollisionShape::MakeSphere(BeamRadius), QueryParams);
+
+		}
+		else {
+
+			QueryParams.bTraceComplex = true;
+			BlockingHit = GetWorld()->LineTraceSingleByChannel(Hit, EyeLocation, BeamEnd, COLLISION_WEAPON, QueryParams);
+
+		}
+
+		if (BlockingHit) {
+
+			BeamEnd = Hit.ImpactPoint;
+
+		}
+
+	}
+	else {
+
+		ShotDirection = GetActorForwardVector();
+		BeamEnd = GetActorLocation();
+
+	}
+
+	return BlockingHit;
+
+}
+
+
+// Adds the damage of one sweep to the accumulated damage of the target that was hit
+void ASBeamWeapon::AccumulateBeamDamage(const FHitResult& Hit, const FVector& ShotDirection) {
+
+	AActor* HitActor = Hit.GetActor();
+
+	// Same surface rules as every shooting weapon; ShotDamageScale turns the damage per second into the damage of one sweep
+	const float SweepDamage = CalculateHitEffect(UPhysicalMaterial::DetermineSurfaceType(Hit.PhysMaterial.Get()));
+
+	if (HitActor && SweepDamage > 0.0f) {
+
+		FSBeamDamageEntry* Entry = PendingBeamDamage.FindByPredicate([HitActor](const FSBeamDamageEntry& Candidate) { return Candidate.Target.Get() == HitActor; });
+
+		if (!Entry) {
+
+			Entry = &PendingBeamDamage.AddDefaulted_GetRef();
+			Entry->Target = HitActor;
+			Entry->Damage = 0.0f;
+
+		}
+
+		Entry->Damage += SweepDamage;
+		Entry->Hit = Hit;
+		Entry->ShotDirection = ShotDirection;
+
+	}
+
+}
+
+
+// Applies the accumulated damage, once per target, and starts a new batch
+void ASBeamWeapon::ApplyBeamDamage() {
+
+	for (const FSBeamDamageEntry& Entry : PendingBeamDamage) {
+
+		AActor* Target = Entry.Target.Get();
+
+		if (Target) {
+
+			UGameplayStatics::ApplyPointDamage(Target, Entry.Damage, Entry.ShotDirection, Entry.Hit, GetInstigatorController(), this, DamageType);
+
+		}
+
+	}
+
+	PendingBeamDamage.Reset();
+	SweepsInDamageBatch = 0;
+
+}
+
+
+// Creates the persistent beam emitter and attaches it to the muzzle socket (done only once)
+void ASBeamWeapon::SetupBeamEffect() {
+
+	if (BeamEffect && !BeamVFXComp && USCosmeticEffectsSubsystem::AreCosmeticsEnabled(GetWorld())) {
+
+		// Not auto-destroyed nor auto-activated, the component lives as long as the weapon and is only activated while firing
+		BeamVFXComp = UGameplayStatics::SpawnEmitterAttached(BeamEffect, MeshComp, GetTuning(&USWeaponDefinition::MuzzleSocketName, MuzzleSocketName), FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::SnapToTarget, false, EPSCPoolMethod::None, false);
+
+	}
+
+}
+
+
+// Shows or hides the beam
+void ASBeamWeapon::SetBeamEffectActive(bool bActive) {
+
+	if (BeamVFXComp && BeamVFXComp->IsActive() != bActive) {
+
+		if (bActive) {
+
+			BeamVFXComp->ActivateSystem(true);
+
+		}
+		else {
+
+			BeamVFXComp->DeactivateSystem();
+
+		}
+
+	}
+
+}
@@ -8,6 +8,8 @@
 #include "Kismet/GameplayStatics.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
+#include "General/SCosmeticEffectsSubsystem.h"
+#include "General/SLogCategories.h"
 
 
 
@@ -15,6 +17,22 @@
 ASRaycastWeapon::ASRaycastWeapon() {
 	
 	TracerTargetName = FName("BeamEnd");
+	TracerEveryNRounds = 1;
+	TracerVFXComp = nullptr;
+	RoundsSinceLastTracer = 0;
+	bPiercingShot = false;
+	MaxPenetrations = 4;
+	PenetrationDamageFalloff = 0.7f;
+
+}
+
+
+// Called when the game starts or when spawned
+void ASRaycastWeapon::BeginPlay() {
+
+	Super::BeginPlay();
+
+	SetupTracerEffect();
 
 }
 
@@ -36,7 +54,7 @@ void ASRaycastWeapon::OnSecondaryWeaponActionPressed() {
 	}
 	else {
 		
-		UE_LOG(LogTemp, Error, TEXT("Secondary weapon action can't be performed, weapon inactive"));
+		UE_LOG(LogCoopWeapon, Error, TEXT("Secondary weapon action can't be performed, weapon inactive"));
 		
 	}
 }
@@ -68,10 +86,26 @@ void ASRaycastWeapon::CancelOngoingActions() {
 }
 
 
+// Puts the tracer emitter to sleep or wakes it up, along with the components common to all shooting weapons
+void ASRaycastWeapon::SetComponentsHibernating(bool bHibernating) {
+
+	Super::SetComponentsHibernating(bHibernating);
+
+	SetComponentRegistered(TracerVFXComp, !bHibernating);
+
+}
+
+
 // Implements the logic specific to this subclass of shooting weapon; in this case, it implements the raycast hit detection
 // the overload allows us to trace more than one ray at a time
 bool ASRaycastWeapon::HandleSpecificFiring(const uint8& BulletsConsumed) {
 
+	if (bPiercingShot) {
+
+		return FirePiercingShot();
+
+	}
+
 	bool BlockingHit = false;
 	FHitResult Hit;
 	FVector EyeLocation;
@@ -83,6 +117,7 @@ bool ASRaycastWeapon::HandleSpecificFiring(const uint8& BulletsConsumed) {
 		
 	// Default value for the smoke trail
 	FVector TracerParticleEnd = TraceEnd;
+	const bool bPlayCosmetics = USCosmeticEffectsSubsystem::AreCosmeticsEnabled(GetWorld());
 
 	// If the ray cast was blocked by any object, update the tracer particle target and apply damage 
 	if (BlockingHit) {
@@ -96,12 +131,20 @@ bool ASRaycastWeapon::HandleSpecificFiring(const uint8& BulletsConsumed) {
 		TracerParticleEnd = Hit.ImpactPoint;
 
 		// Play impact VFX
-		PlayImpactEffects(SurfaceType, Hit.ImpactPoint, Hit.ImpactNormal.Rotation());
+		if (bPlayCosmetics) {
+
+			PlayImpactEffects(SurfaceType, Hit.ImpactPoint, Hit.ImpactNormal.Rotation());
+
+		}
 			
 	}
 			
 	// Play specific VFX, sounds, etc
-	PlayTraceEffect(TracerParticleEnd);	
+	if (bPlayCosmetics) {
+
+		PlayTraceEffect(TracerParticleEnd);
+
+	}
 
 	return Success;
 	
@@ -119,6 +162,7 @@ bool ASRaycastWeapon::ExecuteRaycast(bool& BlockingHit, FHitResult& Hit, FVector
 
 		// Calculate the direction of the trace
 		WeaponOwner->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+		EyeRotation = GetShotAimRotation(EyeRotation);
 		TraceEnd = EyeLocation + (EyeRotation.Vector() * 10000.0f);
 		
 		// Disable the line trace from detecting the weapon itself and its owner, get exact result of collision against a mesh
@@ -140,29 +184,121 @@ bool ASRaycastWeapon::ExecuteRaycast(bool& BlockingHit, FHitResult& Hit, FVector
 }
 
 
-// Function that determine the damage and special effects that will effect the hit component (only doing damage rn)
-float ASRaycastWeapon::CalculateHitEffect(const EPhysicalSurface& HitSurfaceType) {
+// Casts a single multi-hit ray in the direction the player character is looking towards, collecting every hit (nearest first) up to the level's static geometry
+// Returns true if the raycast was successfully executed; also returns the trace direction and information about the player character (where it's looking towards)
+bool ASRaycastWeapon::ExecutePiercingRaycast(TArray<FHitResult>& Hits, FVector& EyeLocation, FRotator& EyeRotation, FVector& TraceEnd) {
+
+	bool Success = false;
+
+	if (WeaponOwner) {
+
+		// Calculate the direction of the trace
+		WeaponOwner->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+		EyeRotation = GetShotAimRotation(EyeRotation);
+		TraceEnd = EyeLocation + (EyeRotation.Vector() * 10000.0f);
+
+		// Disable the line trace from detecting the weapon itself and its owner, get exact result of collision against a mesh
+		FCollisionQueryParams QueryParams;
+		QueryParams.AddIgnoredActor(WeaponOwner);
+		QueryParams.AddIgnoredActor(this);
+		QueryParams.bTraceComplex = true;
+		QueryParams.bReturnPhysicalMaterial = true;
+
+		// Everything the weapon channel would hit is only touched, so the one query goes through it; the level's static geometry still stops the shot
+		FCollisionResponseParams ResponseParams;
+		ResponseParams.CollisionResponse.SetAllChannels(ECR_Overlap);
+		ResponseParams.CollisionResponse.SetResponse(ECC_WorldStatic, ECR_Block);
+
+		GetWorld()->LineTraceMultiByChannel(Hits, EyeLocation, TraceEnd, COLLISION_WEAPON, QueryParams, ResponseParams);
+
+		Success = true;
 
-	float FinalDamage = 0.0f;
-	
-	switch (HitSurfaceType) {
-				
-	case SURFACE_FLESHDEFAULT:
-		FinalDamage = ShotDamage * 1.0f;
-		break;
-				
-	case SURFACE_FLESHVULNERABLE:
-		FinalDamage = ShotDamage * 2.0f;
-		break;
-				
-	default:
-		FinalDamage = ShotDamage * 0.0f;
-		break;
-				
 	}
 
-	return FinalDamage;
-	
+	return Success;
+
+}
+
+
+// Fires a rail-gun shot: one multi-hit query, damage with falloff per penetration applied as one ordered batch, one impact effect per actor pierced and one tracer
+bool ASRaycastWeapon::FirePiercingShot() {
+
+	FVector EyeLocation;
+	FRotator EyeRotation;
+	FVector TraceEnd;
+
+	PiercingHits.Reset();
+	PiercedTargets.Reset();
+
+	bool Success = ExecutePiercingRaycast(PiercingHits, EyeLocation, EyeRotation, TraceEnd);
+
+	// The hits come nearest first; an actor hit on several components only counts (and is damaged) once
+	float PenetrationScale = 1.0f;
+	FVector TracerParticleEnd = TraceEnd;
+	int32 StoppingHitIndex = INDEX_NONE;
+
+	for (int32 HitIndex = 0; HitIndex < PiercingHits.Num(); ++HitIndex) {
+
+		const FHitResult& Hit = PiercingHits[HitIndex];
+		AActor* HitActor = Hit.GetActor();
+
+		if (Hit.bBlockingHit) {
+
+			// Static geometry, the shot ends here
+			TracerParticleEnd = Hit.ImpactPoint;
+			StoppingHitIndex = HitIndex;
+			break;
+
+		}
+
+		if (HitActor && !PiercedTargets.ContainsByPredicate([HitActor](const FSPiercedTarget& Pierced) { return Pierced.Target == HitActor; })) {
+
+			const EPhysicalSurface SurfaceType = UPhysicalMaterial::DetermineSurfaceType(Hit.PhysMaterial.Get());
+			PiercedTargets.Add({ HitActor, CalculateHitEffect(SurfaceType) * PenetrationScale, HitIndex });
+			PenetrationScale *= PenetrationDamageFalloff;
+
+			if (PiercedTargets.Num() >= MaxPenetrations) {
+
+				TracerParticleEnd = Hit.ImpactPoint;
+				break;
+
+			}
+
+		}
+
+	}
+
+	// Damage batch, nearest actor first
+	const FVector ShotDirection = EyeRotation.Vector();
+
+	for (const FSPiercedTarget& Pierced : PiercedTargets) {
+
+		UGameplayStatics::ApplyPointDamage(Pierced.Target, Pierced.Damage, ShotDirection, PiercingHits[Pierced.HitIndex], GetInstigatorController(), this, DamageType);
+
+	}
+
+	if (USCosmeticEffectsSubsystem::AreCosmeticsEnabled(GetWorld())) {
+
+		for (const FSPiercedTarget& Pierced : PiercedTargets) {
+
+			const FHitResult& Hit = PiercingHits[Pierced.HitIndex];
+			PlayImpactEffects(UPhysicalMaterial::DetermineSurfaceType(Hit.PhysMaterial.Get()), Hit.ImpactPoint, Hit.ImpactNormal.Rotation());
+
+		}
+
+		if (StoppingHitIndex != INDEX_NONE) {
+
+			const FHitResult& Hit = PiercingHits[StoppingHitIndex];
+			PlayImpactEffects(UPhysicalMaterial::DetermineSurfaceType(Hit.PhysMaterial.Get()), Hit.ImpactPoint, Hit.ImpactNormal.Rotation());
+
+		}
+
+		PlayTraceEffect(TracerParticleEnd);
+
+	}
+
+	return Success;
+
 }
 
 
@@ -187,10 +323,12 @@ void ASRaycastWeapon::PlayImpactEffects(EPhysicalSurface SurfaceType, const FVec
 				
 	}
 	
-	// Emit particle effect on hit
-	if (ImpactToPlay) {
+	// Emit particle effect on hit, flesh impacts give feedback to the shooter and are worth more than regular ones
+	USCosmeticEffectsSubsystem* CosmeticsSubsystem = GetWorld()->GetSubsystem<USCosmeticEffectsSubsystem>();
+	if (ImpactToPlay && CosmeticsSubsystem) {
 
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactToPlay, HitLocation, HitRotation);
+		UCosmeticEffectPriority ImpactPriority = (ImpactToPlay == FleshImpactEffect) ? UCosmeticEffectPriority::Normal : UCosmeticEffectPriority::Low;
+		CosmeticsSubsystem->SpawnEmitterAtLocation(ImpactToPlay, HitLocation, HitRotation, FVector(1.0f), ImpactPriority);
 				
 	}
 	
@@ -200,18 +338,51 @@ void ASRaycastWeapon::PlayImpactEffects(EPhysicalSurface SurfaceType, const FVec
 // Emit the tracer effect with the muzzle socket name as source location, then set target location via parameter setting
 void ASRaycastWeapon::PlayTraceEffect(const FVector& ShotTraceEnd) {
 
-	FVector MuzzleLocation = MeshComp->GetSocketLocation(MuzzleSocketName);
-	
-	if (TracerEffect) {
-			
-		UParticleSystemComponent* TracerParticle = UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), TracerEffect, MuzzleLocation);
+	USCosmeticEffectsSubsystem* CosmeticsSubsystem = GetWorld()->GetSubsystem<USCosmeticEffectsSubsystem>();
 
-		if (TracerParticle) {
+	if (TracerEffect && CosmeticsSubsystem) {
+
+		if (TracerVFXComp) {
+
+			// Decimation: only one out of every TracerEveryNRounds rounds gets a tracer
+			if (RoundsSinceLastTracer == 0) {
+
+				// The source follows the muzzle socket, only the target has to be updated before restarting the emitter
+				TracerVFXComp->SetVectorParameter(TracerTargetName, ShotTraceEnd);
+				CosmeticsSubsystem->RetriggerEmitter(TracerVFXComp, UCosmeticEffectPriority::Low);
+
+			}
+
+			RoundsSinceLastTracer = (RoundsSinceLastTracer + 1) % FMath::Max<uint8>(TracerEveryNRounds, 1);
+
+		}
+		else {
+
+			FVector MuzzleLocation = MeshComp->GetSocketLocation(GetTuning(&USWeaponDefinition::MuzzleSocketName, MuzzleSocketName));
+			UParticleSystemComponent* TracerParticle = CosmeticsSubsystem->SpawnEmitterAtLocation(TracerEffect, MuzzleLocation, FRotator::ZeroRotator, FVector(1.0f), UCosmeticEffectPriority::Low);
+
+			if (TracerParticle) {
+
+				TracerParticle->SetVectorParameter(TracerTargetName, ShotTraceEnd);
+
+			}
 
-			TracerParticle->SetVectorParameter(TracerTargetName, ShotTraceEnd);
-				
 		}
-		    
+
 	}
-	
-}
\ No newline at end of file
+
+}
+
+
+// Creates the persistent tracer emitter of automatic weapons and attaches it to the muzzle socket (done only once)
+void ASRaycastWeapon::SetupTracerEffect() {
+
+	// Manual and burst weapons fire too slowly for per-shot emitters to matter, so they keep spawning them
+	if (TracerEffect && !TracerVFXComp && GetTuning(&USWeaponDefinition::WeaponType, WeaponType) == UShootingWeaponType::AutomaticFire && USCosmeticEffectsSubsystem::AreCosmeticsEnabled(GetWorld())) {
+
+		// Not auto-destroyed nor auto-activated, the component lives as long as the weapon and is only re-triggered when a tracer is shown
+		TracerVFXComp = UGameplayStatics::SpawnEmitterAttached(TracerEffect, MeshComp, GetTuning(&USWeaponDefinition::MuzzleSocketName, MuzzleSocketName), FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::SnapToTarget, false, EPSCPoolMethod::None, false);
+
+	}
+
+}
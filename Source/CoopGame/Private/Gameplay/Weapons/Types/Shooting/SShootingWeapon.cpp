@@ -3,9 +3,15 @@
 
 
 #include "Gameplay/Weapons/Types/Shooting/SShootingWeapon.h"
+#include "CoopGame/CoopGame.h"
 #include "Kismet/GameplayStatics.h"
 #include "Gameplay/Weapons/Components/SAmmoSystemComponent.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "General/SCosmeticEffectsSubsystem.h"
+#include "General/SFireSchedulerSubsystem.h"
+#include "Gameplay/Weapons/SWeaponDefinition.h"
+#include "General/SLogCategories.h"
+#include "General/SWeaponTrace.h"
 
 
 
@@ -32,11 +38,35 @@ ASShootingWeapon::ASShootingWeapon() {
 	RateOfFireBurst = 10.0f;
 	TimeBetweenBursts = 1.0f;
 
+	// Charge shooting weapon properties
+	FullChargeTime = 1.0f;
+	MinimumChargeFraction = 0.25f;
+	ChargeCooldown = 0.5f;
+
+	// Continuous shooting weapon properties
+	ContinuousTickRate = 20.0f;
+
+	// Recoil and spread (none by default)
+	BaseSpread = 0.0f;
+	SpreadPerShot = 0.0f;
+	MaxSpread = 0.0f;
+	RecoilPitchPerShot = 0.0f;
+	MaxRecoilPitch = 0.0f;
+	RecoilYawPerShot = 0.0f;
+	MaxRecoilYaw = 0.0f;
+	RecoilRecoveryHalfLife = 0.2f;
+
 	// Others
 	bReloadTriggeredByButtonPress = true;
 	bReloadBlockedByWeapon = false;
-	bBlockFiring = false;
-	CurrentBurstCount = 0;
+	MuzzleVFXComp = nullptr;
+	WeaponDefinition = nullptr;
+	FireScheduler = nullptr;
+	FireSchedulerSlot = INDEX_NONE;
+	FireMode = nullptr;
+	bIsCharging = false;
+	ChargeStartTime = 0.0f;
+	ShotDamageScale = 1.0f;
 	
 }
 
@@ -45,37 +75,20 @@ void ASShootingWeapon::OnPrimaryWeaponActionPressed() {
 
 	Super::OnPrimaryWeaponActionPressed();
 	
-	if (IsActive) {
-		
-		// Determine if it's too soon to fire this weapon again and calculate the delay necessary so the RateOfFire isn't changed
-		// If the result is negative, then we have no delay
-		float FirstDelay = FMath::Max(LastFireTime + TimeBetweenFires - GetWorld()->TimeSeconds, 0.0f);
-	
-		switch (WeaponType) {
-		
-		case UShootingWeaponType::AutomaticFire:
-			StartFireAutomatic(FirstDelay);
-			break;
-		
-		case UShootingWeaponType::ManualFire:
-			StartFireManual();
-			break;
-		
-		case UShootingWeaponType::BurstFire:
-			StartFireBurst(FirstDelay);
-			break;
-		
-		default:
-			UE_LOG(LogTemp, Error, TEXT("Invalid mode selected!"));
-			break;
+	if (!IsActive) {
+
+		UE_LOG(LogCoopWeapon, Error, TEXT("Primary weapon action can't be performed, weapon inactive"));
+
+	}
+	else if (!FireMode) {
+
+		UE_LOG(LogCoopWeapon, Error, TEXT("Primary weapon action can't be performed, fire mode unresolved"));
 
-		}
-		
 	}
 	else {
-		
-		UE_LOG(LogTemp, Error, TEXT("Primary weapon action can't be performed, weapon inactive"));
-		
+
+		FireMode->Press(*this);
+
 	}
 
 }
@@ -86,28 +99,10 @@ void ASShootingWeapon::OnPrimaryWeaponActionReleased() {
 
 	Super::OnPrimaryWeaponActionReleased();
 
-	switch (WeaponType) {
-		
-	case UShootingWeaponType::AutomaticFire:
-		// Clear timer for automatic fire and weapon "busy" status
-		GetWorldTimerManager().ClearTimer(TimerHandle_TimeBetweenShots);
-		bReloadBlockedByWeapon = false;
-		break;
-		
-	case UShootingWeaponType::ManualFire:
-		// Clear weapon "busy" status
-		bReloadBlockedByWeapon = false;
-		break;
-		
-	case UShootingWeaponType::BurstFire:
-		// Clear timer for automatic fire and weapon "busy" status
-		GetWorldTimerManager().ClearTimer(TimerHandle_TimeBetweenShots);
-		bReloadBlockedByWeapon = false;
-		break;
-		
-	default:
-		UE_LOG(LogTemp, Error, TEXT("Invalid mode selected!"));
-		break;
+	// Stops repeated fire and clears the weapon "busy" status, or fires a charged shot
+	if (FireMode) {
+
+		FireMode->Release(*this);
 
 	}
 	
@@ -158,6 +153,8 @@ void ASShootingWeapon::RequestSubcomponentBroadcast() {
 
 	if (AmmoSysComp) {
 
+		// This weapon is now the one displayed in the HUD, so its ammo system may schedule and broadcast its timed events
+		AmmoSysComp->SetHUDVisibility(true);
 		AmmoSysComp->OnBroadcastRequested();
 		
 	}
@@ -165,6 +162,17 @@ void ASShootingWeapon::RequestSubcomponentBroadcast() {
 }
 
 
+// Gets an inactive shooting weapon ready to be switched to, its muzzle flash emitter included
+void ASShootingWeapon::PrewarmWeapon() {
+
+	Super::PrewarmWeapon();
+
+	// Only does something if the emitter couldn't be created in BeginPlay
+	SetupMuzzleEffect();
+
+}
+
+
 // Returns the reload type of this weapon (NoReload by default, should be overwritten by child classes if they have a reload system)
 UReloadType ASShootingWeapon::GetReloadType() const {
 
@@ -182,37 +190,97 @@ UReloadType ASShootingWeapon::GetReloadType() const {
 }
 
 
+// Takes a snapshot of this weapon's ammo state; returns false if the weapon has no ammo state (default, should be overwritten by child classes with an ammo system)
+bool ASShootingWeapon::CaptureAmmoSnapshot(FSAmmoSnapshot& OutSnapshot) {
+
+	bool Success = false;
+
+	if (AmmoSysComp) {
+
+		OutSnapshot = AmmoSysComp->CaptureAmmoSnapshot();
+		Success = true;
+
+	}
+
+	return Success;
+
+}
+
+
+// Restores a snapshot of this weapon's ammo state; returns false if the weapon has no ammo state or the snapshot doesn't fit it (default, should be overwritten by child classes with an ammo system)
+bool ASShootingWeapon::RestoreAmmoSnapshot(const FSAmmoSnapshot& Snapshot) {
+
+	return AmmoSysComp ? AmmoSysComp->RestoreAmmoSnapshot(Snapshot) : false;
+
+}
+
+
+// Starts this weapon's ammo state anew, as if the weapon had just been spawned; returns false if the weapon has no ammo state (default, should be overwritten by child classes with an ammo system)
+bool ASShootingWeapon::ResetAmmoState() {
+
+	bool Success = false;
+
+	if (AmmoSysComp) {
+
+		AmmoSysComp->ResetAmmoState();
+		Success = true;
+
+	}
+
+	return Success;
+
+}
+
+
+// Points the ammo system to the weapon definition, if any, once the components are initialized (before BeginPlay)
+void ASShootingWeapon::PostInitializeComponents() {
+
+	Super::PostInitializeComponents();
+
+	if (WeaponDefinition && AmmoSysComp) {
+
+		AmmoSysComp->ApplyWeaponDefinition(*WeaponDefinition);
+
+	}
+
+}
+
+
 // Called when the game starts or when spawned
 void ASShootingWeapon::BeginPlay() {
 
 	Super::BeginPlay();
 
-	// Calculate time between fires off the ROF
-	switch (WeaponType) {
-	case UShootingWeaponType::AutomaticFire:
-		TimeBetweenFires = 1 / RateOfFireAutomatic;
-		break;
-		
-	case UShootingWeaponType::ManualFire:
-		TimeBetweenFires = 1E7;			// Large number intentionally, TimeBetweenFires isn't used in manual weapons
-		break;
-		
-	case UShootingWeaponType::BurstFire:
-		TimeBetweenFires = 1 / RateOfFireBurst;
-		break;
-		
-	default:
-		UE_LOG(LogTemp, Error, TEXT("Invalid mode selected!"));
-		break;
-		
-	}
+	// The only place in which the weapon type is looked at, the fire mode sets up the time between fires and registers this weapon in the fire scheduler
+	FireScheduler = GetWorld()->GetSubsystem<USFireSchedulerSubsystem>();
+	FireMode = &FSFireModes::Resolve(GetTuning(&USWeaponDefinition::WeaponType, WeaponType));
+	FireMode->Initialize(*this);
 
 	// First set on LastFireTime (TimeBetweenFires subtracted so firing is possible immediately)
 	LastFireTime = GetWorld()->TimeSeconds - TimeBetweenFires;
+
+	// Attach the muzzle flash once so firing only has to re-trigger it
+	SetupMuzzleEffect();
+
+	SetupRecoil();
 	
 }
 
 
+// Called when the game ends or the weapon is destroyed
+void ASShootingWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+
+	if (FireScheduler) {
+
+		FireScheduler->UnregisterWeapon(this);
+
+	}
+
+	Super::EndPlay(EndPlayReason);
+
+}
+
+
 // Implements the cancelling of actions common to all shooting weapons
 void ASShootingWeapon::CancelOngoingActions() {
 	
@@ -222,92 +290,126 @@ void ASShootingWeapon::CancelOngoingActions() {
 		
 		// Cancel current reload (consider weapon busy status as false because we want to cancel ALWAYS)
 		AmmoSysComp->HandleReloadCancel(UReloadCancelTrigger::TriggerByWeaponSwitch);
+
+		// The weapon is no longer displayed in the HUD, nobody is interested in its timed events anymore
+		AmmoSysComp->SetHUDVisibility(false);
 		
 	}
 
-	// Simulate weapon action release
-	OnPrimaryWeaponActionReleased();
+	// Drop the weapon action without firing (a charged shot is lost)
+	if (FireMode) {
+
+		FireMode->Cancel(*this);
+
+	}
 	
 }
 
 
+// Puts the components common to all shooting weapons to sleep or wakes them up (the muzzle flash emitter is unregistered while hibernating)
+void ASShootingWeapon::SetComponentsHibernating(bool bHibernating) {
+
+	Super::SetComponentsHibernating(bHibernating);
+
+	// The ammo system needs nothing here: it no longer schedules deadlines once hidden from the HUD (see CancelOngoingActions) and derives passive reload progress from timestamps
+	SetComponentRegistered(MuzzleVFXComp, !bHibernating);
+
+}
+
+
 // Polymorphic function that handles the specifics of the weapon being fired (e.g: raycast vs actor spawning)
 bool ASShootingWeapon::HandleSpecificFiring(const uint8& BulletsConsumed) {
 
-	UE_LOG(LogTemp, Log, TEXT("Gun banged %u times"), BulletsConsumed);
+	UE_LOG(LogCoopWeapon, Verbose, TEXT("Gun banged %u times"), BulletsConsumed);
 	
 	return false;
 }
 
 
-// Function dedicated to handling automatic fire
-void ASShootingWeapon::StartFireAutomatic(float FirstDelay) {
+// Function that determine the damage and special effects that will effect the hit component (only doing damage rn)
+float ASShootingWeapon::CalculateHitEffect(const EPhysicalSurface& HitSurfaceType) {
 
-	// Start the auto-repeating timer for automatic fire
-	GetWorldTimerManager().SetTimer(TimerHandle_TimeBetweenShots, this, &ASShootingWeapon::FireWeapon, TimeBetweenFires, true, FirstDelay);
+	float FinalDamage = 0.0f;
+	
+	switch (HitSurfaceType) {
+				
+	case SURFACE_FLESHDEFAULT:
+		FinalDamage = ShotDamage * 1.0f;
+		break;
+				
+	case SURFACE_FLESHVULNERABLE:
+		FinalDamage = ShotDamage * 2.0f;
+		break;
+				
+	default:
+		FinalDamage = ShotDamage * 0.0f;
+		break;
+				
+	}
+
+	// Charged shots and continuous fire ticks deal a fraction of the weapon's damage
+	return FinalDamage * ShotDamageScale;
 	
 }
 
 
-// Function dedicated to handling manual fire with in-built delay and forced button pressing
-void ASShootingWeapon::StartFireManual() {
+// Returns the given aim rotation offset by the recoil and spread of the shot being fired
+FRotator ASShootingWeapon::GetShotAimRotation(const FRotator& AimRotation) const {
 
-	// Fire the weapon instantly and only once, then block firing immediately
-	FireWeapon();
-	bBlockFiring = true;
+	return FRotator(AimRotation.Pitch + CurrentShotRecoil.PitchOffset, AimRotation.Yaw + CurrentShotRecoil.YawOffset, AimRotation.Roll);
 
-	// Check if the timer is already running; if not, start the timer for clearing the block
-	// As the function here is only used here, there is no problem with this design; bBlockFiring will be set to true just before the timer is started, and as this is the only place where this variable is set to false, FireWeapon will be blocked successfully
-	if (!GetWorldTimerManager().IsTimerActive(TimerHandle_TimeBetweenShots)) {
-			
-		GetWorldTimerManager().SetTimer(TimerHandle_TimeBetweenShots, this, &ASShootingWeapon::ResetFiringBlock, TimeBetweenShotsManual);
-		
-	}
-	
 }
 
 
-// Function dedicated to handling burst fire (short bursts of automatic fire with in-built delay between them)
-void ASShootingWeapon::StartFireBurst(float FirstDelay) {
+// Returns the muzzle effect of the weapon definition (preloaded with its game bundle) if there is one, MuzzleEffect otherwise
+UParticleSystem* ASShootingWeapon::GetMuzzleEffect() const {
+
+	UParticleSystem* Effect = MuzzleEffect;
+
+	if (WeaponDefinition) {
+
+		Effect = WeaponDefinition->MuzzleEffect.Get();
+
+		// Only happens if the preload failed, the weapon goes without a muzzle flash rather than hitching on a synchronous load
+		if (!Effect && !WeaponDefinition->MuzzleEffect.IsNull()) {
+
+			UE_LOG(LogCoopWeapon, Warning, TEXT("Muzzle effect of %s wasn't preloaded, the weapon has no muzzle flash"), *GetNameSafe(WeaponDefinition));
+
+		}
+
+	}
+
+	return Effect;
 
-	// Start the auto-repeating timer for automatic fire
-	GetWorldTimerManager().SetTimer(TimerHandle_TimeBetweenShots, this, &ASShootingWeapon::FireWeapon, TimeBetweenFires, true, FirstDelay);
-	
 }
 
 
-// While the primary weapon action button is pressed, this function will be called continuously
-void ASShootingWeapon::FireWeapon() {
+// Called by the fire scheduler for every shot that comes due while the primary weapon action button is pressed, with the time the shot was due at; returns true if the shot counts towards a burst
+bool ASShootingWeapon::FireWeapon(bool bFiringBlocked, double ShotTime) {
 
+	bool FiringSuccess = false;
 	uint8 BulletsConsumed = 0;
 	
-	if (!bBlockFiring && AmmoSysComp && AmmoSysComp->ManageAmmoWhenUseRequested(bCanPartialFire, BulletPerAttack, BulletsConsumed)) {
+	if (!bFiringBlocked && AmmoSysComp && AmmoSysComp->ManageAmmoWhenUseRequested(GetTuning(&USWeaponDefinition::bCanPartialFire, bCanPartialFire), GetTuning(&USWeaponDefinition::BulletPerAttack, BulletPerAttack), BulletsConsumed)) {
 			
 		// Set the weapon state to "busy"
 		bReloadBlockedByWeapon = true;
 
+		// Driven by the scheduled shot time rather than the frame's, so the offsets don't depend on the frame rate
+		CurrentShotRecoil = FSRecoilCore::Fire(RecoilState, RecoilConfig, ShotTime);
+
 		// Polymorphic!
-		bool FiringSuccess = HandleSpecificFiring(BulletsConsumed);
-			
-		ShakePlayerCamera();
+		FiringSuccess = HandleSpecificFiring(BulletsConsumed);
+		COOP_TRACE_WEAPON(WeaponFired, this, BulletsConsumed);
 		
 		LastFireTime = GetWorld()->TimeSeconds;
-		
-		PlayMuzzleEffect();
 
-		if (FiringSuccess && WeaponType == UShootingWeaponType::BurstFire) {
+		// Cosmetic feedback is skipped entirely on dedicated servers
+		if (USCosmeticEffectsSubsystem::AreCosmeticsEnabled(GetWorld())) {
+
+			ShakePlayerCamera();
+			PlayMuzzleEffect();
 
-			++CurrentBurstCount;
-			
-		}
-		// If the burst limit of bullets has been reached, then block firing and start timer to reset firing block
-		// We can already reset the burst count back to 0 because the firing block is in place already
-		if (CurrentBurstCount >= ShotsInBurst) {
-		
-			bBlockFiring = true;
-			GetWorldTimerManager().SetTimer(TimerHandle_TimeBetweenBursts, this, &ASShootingWeapon::ResetFiringBlock, TimeBetweenBursts);
-			CurrentBurstCount = 0;
-		
 		}
 		
 	}
@@ -319,30 +421,44 @@ void ASShootingWeapon::FireWeapon() {
 		TriggerReloadViaWeaponAction();
 			
 	}
-	else if (bBlockFiring) {
+	else if (bFiringBlocked) {
 
 		// do nothing
-		UE_LOG(LogTemp, Log, TEXT("Weapon fire is blocked by the weapon itself"));
+		UE_LOG(LogCoopWeapon, Verbose, TEXT("Weapon fire is blocked by the weapon itself"));
+		COOP_TRACE_WEAPON(FireBlocked, this);
 		
 	}
+
+	return FiringSuccess;
 	
 }
 
 
-// Resets the block for manual and burst firing
-void ASShootingWeapon::ResetFiringBlock() {
+// Builds the recoil and spread configuration from the properties above, the pattern seeded by the weapon's class
+void ASShootingWeapon::SetupRecoil() {
 
-	bBlockFiring = false;
+	RecoilConfig.BaseSpread = GetTuning(&USWeaponDefinition::BaseSpread, BaseSpread);
+	RecoilConfig.SpreadPerShot = GetTuning(&USWeaponDefinition::SpreadPerShot, SpreadPerShot);
+	RecoilConfig.MaxSpread = GetTuning(&USWeaponDefinition::MaxSpread, MaxSpread);
+	RecoilConfig.RecoilPitchPerShot = GetTuning(&USWeaponDefinition::RecoilPitchPerShot, RecoilPitchPerShot);
+	RecoilConfig.MaxRecoilPitch = GetTuning(&USWeaponDefinition::MaxRecoilPitch, MaxRecoilPitch);
+	RecoilConfig.RecoilYawPerShot = GetTuning(&USWeaponDefinition::RecoilYawPerShot, RecoilYawPerShot);
+	RecoilConfig.MaxRecoilYaw = GetTuning(&USWeaponDefinition::MaxRecoilYaw, MaxRecoilYaw);
+	RecoilConfig.RecoveryHalfLife = GetTuning(&USWeaponDefinition::RecoilRecoveryHalfLife, RecoilRecoveryHalfLife);
+
+	// The class path is the same on every machine, so the server derives the same pattern as the client
+	RecoilConfig.PatternSeed = FCrc::StrCrc32(*GetClass()->GetPathName());
+
+	RecoilState = FSRecoilState();
+	CurrentShotRecoil = FSRecoilShot();
 
-	UE_LOG(LogTemp, Log, TEXT("Reset firing block"));
-	
 }
 
 
 // Triggers a reload via a Weapon action, always
 void ASShootingWeapon::TriggerReloadViaWeaponAction() {
 
-	UE_LOG(LogTemp, Log, TEXT("Triggering reload via weapon action"));
+	UE_LOG(LogCoopWeapon, Verbose, TEXT("Triggering reload via weapon action"));
 	
 	// Reload only possible if the weapon is not being fired
 	if (AmmoSysComp) {
@@ -361,13 +477,37 @@ void ASShootingWeapon::TriggerReloadViaWeaponAction() {
 }
 
 
+// Creates the persistent muzzle flash emitter and attaches it to the muzzle socket (done only once)
+void ASShootingWeapon::SetupMuzzleEffect() {
+
+	UParticleSystem* Effect = GetMuzzleEffect();
+
+	if (Effect && !MuzzleVFXComp && USCosmeticEffectsSubsystem::AreCosmeticsEnabled(GetWorld())) {
+
+		// Not auto-destroyed nor auto-activated, the component lives as long as the weapon and is only re-triggered when firing
+		MuzzleVFXComp = UGameplayStatics::SpawnEmitterAttached(Effect, MeshComp, GetTuning(&USWeaponDefinition::MuzzleSocketName, MuzzleSocketName), FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::SnapToTarget, false, EPSCPoolMethod::None, false);
+
+		if (MuzzleVFXComp) {
+
+			// Scale is absolute so it matches what used to be set per spawn, regardless of the weapon's attachment
+			MuzzleVFXComp->SetUsingAbsoluteScale(true);
+			MuzzleVFXComp->SetWorldScale3D(GetTuning(&USWeaponDefinition::MuzzleEffectScale, MuzzleEffectScale));
+			
+		}
+		
+	}
+	
+}
+
+
 // Emit the muzzle effect (happens in all shooting weapons)
 void ASShootingWeapon::PlayMuzzleEffect() {
 
-	if (MuzzleEffect) {
-			
-		UParticleSystemComponent* MuzzleVFX = UGameplayStatics::SpawnEmitterAttached(MuzzleEffect, MeshComp, MuzzleSocketName);
-		MuzzleVFX->SetWorldScale3D(MuzzleEffectScale);
+	USCosmeticEffectsSubsystem* CosmeticsSubsystem = GetWorld()->GetSubsystem<USCosmeticEffectsSubsystem>();
+	if (MuzzleVFXComp && CosmeticsSubsystem) {
+
+		// Restart the emitter from scratch, no attachment or transform work needed
+		CosmeticsSubsystem->RetriggerEmitter(MuzzleVFXComp, UCosmeticEffectPriority::Normal);
 			
 	}
 	
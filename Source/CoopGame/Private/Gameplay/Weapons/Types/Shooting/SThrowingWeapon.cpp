@@ -25,8 +25,9 @@ bool ASThrowingWeapon::HandleSpecificFiring(const uint8& BulletsConsumed) {
 		WeaponOwner->GetActorEyesViewPoint(EyeLocation, EyeRotation);
 
 		// Get the location of the muzzle
-		FVector MuzzleLocation = MeshComp->GetSocketLocation(MuzzleSocketName);
-		FRotator MuzzleRotation = MeshComp->GetSocketRotation(MuzzleSocketName);
+		const FName& MuzzleSocket = GetTuning(&USWeaponDefinition::MuzzleSocketName, MuzzleSocketName);
+		FVector MuzzleLocation = MeshComp->GetSocketLocation(MuzzleSocket);
+		FRotator MuzzleRotation = MeshComp->GetSocketRotation(MuzzleSocket);
 		FVector SpawnLocation = MuzzleLocation + (MuzzleRotation.Vector() * 50.0f);
 
 		// Spawn damage-dealing actor at location of muzzle and set damage and owner params
@@ -2,4 +2,267 @@
 
 
 #include "General/SCharacterPlayerController.h"
+#include "Camera/CameraShakeBase.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Gameplay/Characters/SPlayerCharacter.h"
+#include "Gameplay/Characters/Components/SCharacterEquipmentComponent.h"
+#include "Gameplay/Weapons/SWeapon.h"
+#include "Gameplay/Weapons/Components/SAmmoSystemComponent.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
 
+
+
+#if !UE_BUILD_SHIPPING
+// Saves the ammo checkpoint of the first local player
+static FAutoConsoleCommandWithWorld SaveAmmoCheckpointCommand(
+	TEXT("COOP.SaveAmmoCheckpoint"),
+	TEXT("Stores the ammo state of the first local player's loadout as their checkpoint (server or standalone only)"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+
+		ASCharacterPlayerController* PlayerController = Cast<ASCharacterPlayerController>(World->GetFirstPlayerController());
+
+		if (PlayerController) {
+
+			PlayerController->SaveAmmoCheckpoint();
+
+		}
+
+	})
+);
+
+// Loads the ammo checkpoint of the first local player
+static FAutoConsoleCommandWithWorld LoadAmmoCheckpointCommand(
+	TEXT("COOP.LoadAmmoCheckpoint"),
+	TEXT("Restores the ammo state of the first local player's loadout from their checkpoint (server or standalone only)"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+
+		ASCharacterPlayerController* PlayerController = Cast<ASCharacterPlayerController>(World->GetFirstPlayerController());
+
+		if (PlayerController) {
+
+			PlayerController->LoadAmmoCheckpoint();
+
+		}
+
+	})
+);
+#endif
+
+
+
+// Sets default values for this actor's properties
+ASCharacterPlayerController::ASCharacterPlayerController() {
+
+	MaxAggregatedShakeScale = 2.0f;
+
+}
+
+
+// Called every frame
+void ASCharacterPlayerController::Tick(float DeltaTime) {
+
+	Super::Tick(DeltaTime);
+
+	if (PendingShakeScales.Num() > 0) {
+
+		FlushCameraShakes();
+
+	}
+
+}
+
+
+// Adds a camera shake request to the current frame's aggregated shake state; the shake itself is only played when the controller ticks
+void ASCharacterPlayerController::RequestCameraShake(TSubclassOf<UCameraShakeBase> ShakeClass, float Scale) {
+
+	if (ShakeClass && Scale > 0.0f) {
+
+		float& PendingScale = PendingShakeScales.FindOrAdd(ShakeClass, 0.0f);
+		PendingScale = FMath::Min(PendingScale + Scale, MaxAggregatedShakeScale);
+
+	}
+
+}
+
+
+// Stores the ammo state of the controlled character's loadout as this player's checkpoint (server only); returns false if there is no loadout to take it from
+bool ASCharacterPlayerController::SaveAmmoCheckpoint() {
+
+	bool Success = false;
+	ASPlayerCharacter* PlayerCharacter = Cast<ASPlayerCharacter>(GetPawn());
+
+	if (HasAuthority() && PlayerCharacter && PlayerCharacter->CharEquipComp) {
+
+		TArray<FSAmmoSnapshot> Snapshots;
+		PlayerCharacter->CharEquipComp->CaptureLoadoutAmmo(Snapshots);
+
+		AmmoCheckpoint.Reset();
+		FMemoryWriter Writer(AmmoCheckpoint);
+		Writer << Snapshots;
+
+		Success = true;
+
+	}
+
+	return Success;
+
+}
+
+
+// Restores the ammo state of the controlled character's loadout from this player's checkpoint (server only); returns false if there is no checkpoint or it didn't fit the loadout
+bool ASCharacterPlayerController::LoadAmmoCheckpoint() {
+
+	bool Success = false;
+	ASPlayerCharacter* PlayerCharacter = Cast<ASPlayerCharacter>(GetPawn());
+
+	if (HasAuthority() && PlayerCharacter && PlayerCharacter->CharEquipComp && AmmoCheckpoint.Num() > 0) {
+
+		TArray<FSAmmoSnapshot> Snapshots;
+		FMemoryReader Reader(AmmoCheckpoint);
+		Reader << Snapshots;
+
+		Success = PlayerCharacter->CharEquipComp->RestoreLoadoutAmmo(Snapshots);
+
+	}
+
+	return Success;
+
+}
+
+
+// Keeps the weapons of the given loadout (the one of a dying character) for the next character this controller possesses (server only)
+void ASCharacterPlayerController::StowLoadout(USCharacterEquipmentComponent* EquipComp) {
+
+	if (HasAuthority() && EquipComp) {
+
+		// The weapons stay replicated to this player while nobody holds them
+		EquipComp->StowLoadout(this, StowedLoadout);
+
+	}
+
+}
+
+
+// Hands the stowed weapons over to the given loadout; returns false if there were none or none could be equipped (server only)
+bool ASCharacterPlayerController::UnstowLoadout(USCharacterEquipmentComponent* EquipComp) {
+
+	bool Success = false;
+
+	if (HasAuthority() && EquipComp && StowedLoadout.Num() > 0) {
+
+		Success = EquipComp->EquipStowedLoadout(StowedLoadout);
+
+		// Weapons the loadout didn't take would be left lying around otherwise
+		if (!Success) {
+
+			for (ASWeapon* Weapon : StowedLoadout) {
+
+				if (Weapon && !Weapon->WeaponOwner) {
+
+					Weapon->Destroy();
+
+				}
+
+			}
+
+		}
+
+		StowedLoadout.Reset();
+
+	}
+
+	return Success;
+
+}
+
+
+// Called when the controller is removed from play; destroys the weapons still stowed
+void ASCharacterPlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+
+	if (EndPlayReason == EEndPlayReason::Destroyed && HasAuthority()) {
+
+		for (ASWeapon* Weapon : StowedLoadout) {
+
+			if (Weapon) {
+
+				Weapon->Destroy();
+
+			}
+
+		}
+
+	}
+
+	StowedLoadout.Reset();
+
+	Super::EndPlay(EndPlayReason);
+
+}
+
+
+// Plays the aggregated shakes of the current frame, either locally or on the owning client, then clears them
+void ASCharacterPlayerController::FlushCameraShakes() {
+
+	const bool bIsLocal = IsLocalController();
+
+	for (const TPair<TSubclassOf<UCameraShakeBase>, float>& PendingShake : PendingShakeScales) {
+
+		if (bIsLocal) {
+
+			PlayAggregatedCameraShake(PendingShake.Key, PendingShake.Value);
+
+		}
+		else {
+
+			// The client does its own aggregation on top of this, so a remote player never receives more than one request per frame
+			ClientPlayAggregatedCameraShake(PendingShake.Key, PendingShake.Value);
+
+		}
+
+	}
+
+	PendingShakeScales.Reset();
+
+}
+
+
+// Plays an aggregated shake on this (local) controller's camera, re-using the live shake instance of that class if there is one
+void ASCharacterPlayerController::PlayAggregatedCameraShake(TSubclassOf<UCameraShakeBase> ShakeClass, float Scale) {
+
+	if (PlayerCameraManager) {
+
+		FSActiveCameraShake& ActiveShake = ActiveShakes.FindOrAdd(ShakeClass);
+		UCameraShakeBase* Shake = ActiveShake.Shake.Get();
+		const float Now = GetWorld()->TimeSeconds;
+
+		if (Shake && !Shake->IsFinished()) {
+
+			// Still running: the part of the current intensity that hasn't faded yet (linearly over a fixed duration, all of it for shakes without one) is carried over
+			const FCameraShakeDuration Duration = Shake->GetCameraShakeDuration();
+			const float RemainingFraction = (Duration.IsFixed() && Duration.Get() > 0.0f) ? FMath::Clamp(1.0f - (Now - ActiveShake.StartTime) / Duration.Get(), 0.0f, 1.0f) : 1.0f;
+
+			// The new intensity is added on top of what's left of the current one, and the shake is restarted in place
+			const float NewScale = FMath::Min(Shake->ShakeScale * RemainingFraction + Scale, MaxAggregatedShakeScale);
+			Shake->StartShake(PlayerCameraManager, NewScale, ECameraShakePlaySpace::CameraLocal);
+
+		}
+		else {
+
+			ActiveShake.Shake = PlayerCameraManager->StartCameraShake(ShakeClass, Scale);
+
+		}
+
+		ActiveShake.StartTime = Now;
+
+	}
+
+}
+
+
+// Plays an aggregated shake on the owning client (at most once per frame and shake class)
+void ASCharacterPlayerController::ClientPlayAggregatedCameraShake_Implementation(TSubclassOf<UCameraShakeBase> ShakeClass, float Scale) {
+
+	RequestCameraShake(ShakeClass, Scale);
+
+}
@@ -0,0 +1,314 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "General/SCosmeticEffectsSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "General/SLogCategories.h"
+
+
+
+// Budget configuration
+
+static TAutoConsoleVariable<int32> CVarCosmeticsMaxPerFrame(
+	TEXT("COOP.Cosmetics.MaxPerFrame"),
+	24,
+	TEXT("Maximum number of cosmetic effects that can be played in a single frame"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<int32> CVarCosmeticsMaxConcurrent(
+	TEXT("COOP.Cosmetics.MaxConcurrent"),
+	96,
+	TEXT("Maximum number of fire-and-forget cosmetic emitters alive at the same time"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarCosmeticsMaxDistance(
+	TEXT("COOP.Cosmetics.MaxDistance"),
+	8000.0f,
+	TEXT("Distance (in Unreal units) to the closest local view past which cosmetic effects are always dropped"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarCosmeticsDowngradeSignificance(
+	TEXT("COOP.Cosmetics.DowngradeSignificance"),
+	0.35f,
+	TEXT("Effects whose weighted significance is under this value are played at their lowest detail level"),
+	ECVF_Scalability);
+
+// Dump of the budget pressure of the current world
+static FAutoConsoleCommandWithWorld DumpCosmeticBudgetCommand(
+	TEXT("COOP.DumpCosmeticBudget"),
+	TEXT("Writes the current cosmetic effects budget pressure to the log"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+
+		USCosmeticEffectsSubsystem* CosmeticsSubsystem = World ? World->GetSubsystem<USCosmeticEffectsSubsystem>() : nullptr;
+
+		if (CosmeticsSubsystem) {
+
+			CosmeticsSubsystem->DumpBudgetPressure();
+
+		}
+		else {
+
+			UE_LOG(LogCoopCosmetics, Warning, TEXT("No cosmetic effects subsystem in this world"));
+
+		}
+
+	}));
+
+
+
+// Weight of each priority when comparing significance against the budget pressure (indexed by UCosmeticEffectPriority)
+static const float PriorityWeights[] = { 0.5f, 1.0f, 2.0f };
+
+// Distance (in Unreal units) under which an effect is always fully relevant, independently of the view direction
+static const float AlwaysRelevantDistance = 500.0f;
+
+// Significance multiplier for effects outside of the view cone (they may still be heard or partially visible)
+static const float OutOfViewSignificance = 0.25f;
+
+
+
+// Sets default values for this subsystem's properties
+USCosmeticEffectsSubsystem::USCosmeticEffectsSubsystem() {
+
+	BudgetFrameNumber = 0;
+	EffectsPlayedThisFrame = 0;
+
+	TotalRequested = 0;
+	TotalPlayed = 0;
+	TotalDowngraded = 0;
+	TotalDroppedIrrelevant = 0;
+	TotalDroppedLowValue = 0;
+	TotalDroppedCapped = 0;
+	PeakLiveEmitters = 0;
+	PeakEffectsPerFrame = 0;
+
+}
+
+
+// The subsystem is not created on dedicated servers, nobody would ever see the effects
+bool USCosmeticEffectsSubsystem::ShouldCreateSubsystem(UObject* Outer) const {
+
+#if WITH_COSMETICS
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+#else
+	return false;
+#endif
+
+}
+
+
+// Spawns a fire-and-forget emitter if the budget allows it, returns nullptr if the request was dropped (callers must always have nullptr checks!)
+UParticleSystemComponent* USCosmeticEffectsSubsystem::SpawnEmitterAtLocation(UParticleSystem* EmitterTemplate, const FVector& Location, const FRotator& Rotation, const FVector& Scale, UCosmeticEffectPriority Priority) {
+
+	UParticleSystemComponent* Emitter = nullptr;
+	bool bShouldDowngrade = false;
+
+	if (EmitterTemplate && EvaluateRequest(Location, Priority, true, bShouldDowngrade)) {
+
+		// Spawned inactive so the detail level can be set before the first particle is emitted; pooled as these are short-lived
+		Emitter = UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), EmitterTemplate, Location, Rotation, Scale, true, EPSCPoolMethod::AutoRelease, false);
+
+		if (Emitter) {
+
+			ApplyDowngrade(Emitter, bShouldDowngrade);
+			Emitter->ActivateSystem();
+
+			LiveEmitters.Add(Emitter);
+			PeakLiveEmitters = FMath::Max(PeakLiveEmitters, LiveEmitters.Num());
+
+		}
+
+	}
+
+	return Emitter;
+
+}
+
+
+// Restarts a persistent emitter component if the budget allows it, returns true if the emitter was re-activated
+bool USCosmeticEffectsSubsystem::RetriggerEmitter(UParticleSystemComponent* PersistentEmitter, UCosmeticEffectPriority Priority) {
+
+	bool Success = false;
+	bool bShouldDowngrade = false;
+
+	// Persistent emitters don't count towards the concurrent cap, they exist anyways
+	if (PersistentEmitter && EvaluateRequest(PersistentEmitter->GetComponentLocation(), Priority, false, bShouldDowngrade)) {
+
+		ApplyDowngrade(PersistentEmitter, bShouldDowngrade);
+		PersistentEmitter->Activate(true);
+
+		Success = true;
+
+	}
+
+	return Success;
+
+}
+
+
+// Writes the current and accumulated budget pressure to the log
+void USCosmeticEffectsSubsystem::DumpBudgetPressure() const {
+
+	const int32 MaxPerFrame = FMath::Max(CVarCosmeticsMaxPerFrame.GetValueOnGameThread(), 1);
+	const int32 MaxConcurrent = FMath::Max(CVarCosmeticsMaxConcurrent.GetValueOnGameThread(), 1);
+
+	int32 CurrentlyAlive = 0;
+	for (const TWeakObjectPtr<UParticleSystemComponent>& Emitter : LiveEmitters) {
+
+		if (Emitter.IsValid() && Emitter->IsActive()) {
+
+			++CurrentlyAlive;
+
+		}
+
+	}
+
+	UE_LOG(LogCoopCosmetics, Log, TEXT("Cosmetic budget: %d/%d emitters alive (peak %d), %d/%d effects this frame (peak %d)"), CurrentlyAlive, MaxConcurrent, PeakLiveEmitters, EffectsPlayedThisFrame, MaxPerFrame, PeakEffectsPerFrame);
+	UE_LOG(LogCoopCosmetics, Log, TEXT("Cosmetic budget: %d requested, %d played (%d downgraded), %d dropped as irrelevant, %d dropped as low-value, %d dropped by caps"), TotalRequested, TotalPlayed, TotalDowngraded, TotalDroppedIrrelevant, TotalDroppedLowValue, TotalDroppedCapped);
+
+}
+
+
+// Evaluates the request against the budget, returns true if the effect may play and signals whether it should be downgraded
+bool USCosmeticEffectsSubsystem::EvaluateRequest(const FVector& Location, UCosmeticEffectPriority Priority, bool bCountsAsConcurrent, bool& bShouldDowngrade) {
+
+	RefreshFrameBudget();
+	++TotalRequested;
+
+	const int32 MaxPerFrame = FMath::Max(CVarCosmeticsMaxPerFrame.GetValueOnGameThread(), 1);
+	const int32 MaxConcurrent = FMath::Max(CVarCosmeticsMaxConcurrent.GetValueOnGameThread(), 1);
+
+	const float Significance = CalculateSignificance(Location);
+	const float WeightedSignificance = Significance * PriorityWeights[static_cast<uint8>(Priority)];
+
+	// Budget pressure goes from 0 (nothing played) to 1 (one of the caps has been reached)
+	const float FramePressure = static_cast<float>(EffectsPlayedThisFrame) / MaxPerFrame;
+	const float ConcurrentPressure = bCountsAsConcurrent ? (static_cast<float>(LiveEmitters.Num()) / MaxConcurrent) : 0.0f;
+	const float Pressure = FMath::Max(FramePressure, ConcurrentPressure);
+
+	bool bCanPlay = false;
+
+	// Nobody can see the effect, never worth playing
+	if (Significance <= 0.0f) {
+
+		++TotalDroppedIrrelevant;
+
+	}
+	// Caps are hard for everything but high priority effects
+	else if (Pressure >= 1.0f && Priority != UCosmeticEffectPriority::High) {
+
+		++TotalDroppedCapped;
+
+	}
+	// The more pressure there is on the budget, the more significant an effect must be to be played (high priority effects are only dropped when nobody can see them)
+	else if (WeightedSignificance < Pressure && Priority != UCosmeticEffectPriority::High) {
+
+		++TotalDroppedLowValue;
+
+	}
+	else {
+
+		// Effects that barely made it or that are requested under heavy pressure are played at the lowest detail level
+		bShouldDowngrade = (WeightedSignificance < CVarCosmeticsDowngradeSignificance.GetValueOnGameThread()) || (Pressure >= 0.5f && Priority == UCosmeticEffectPriority::Low);
+
+		++EffectsPlayedThisFrame;
+		++TotalPlayed;
+		TotalDowngraded += bShouldDowngrade ? 1 : 0;
+		PeakEffectsPerFrame = FMath::Max(PeakEffectsPerFrame, EffectsPlayedThisFrame);
+
+		bCanPlay = true;
+
+	}
+
+	return bCanPlay;
+
+}
+
+
+// Returns the significance of a location (0 = irrelevant, 1 = fully relevant) relative to the closest local player view
+float USCosmeticEffectsSubsystem::CalculateSignificance(const FVector& Location) const {
+
+	float Significance = 0.0f;
+	const float MaxDistance = FMath::Max(CVarCosmeticsMaxDistance.GetValueOnGameThread(), 1.0f);
+
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator) {
+
+		APlayerController* PC = Iterator->Get();
+
+		// Only local views matter, effects are never seen by the server on behalf of a remote client
+		if (PC && PC->IsLocalController()) {
+
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			const FVector ToEffect = Location - ViewLocation;
+			const float Distance = ToEffect.Size();
+
+			float ViewSignificance = 0.0f;
+
+			if (Distance <= AlwaysRelevantDistance) {
+
+				ViewSignificance = 1.0f;
+
+			}
+			else if (Distance < MaxDistance) {
+
+				// Linear falloff with distance, heavily reduced when the effect is behind or to the side of the view
+				const float DistanceFactor = 1.0f - (Distance / MaxDistance);
+				const bool bInView = (FVector::DotProduct(ToEffect / Distance, ViewRotation.Vector()) > 0.5f);
+				ViewSignificance = DistanceFactor * (bInView ? 1.0f : OutOfViewSignificance);
+
+			}
+
+			Significance = FMath::Max(Significance, ViewSignificance);
+
+		}
+
+	}
+
+	return Significance;
+
+}
+
+
+// Resets the per-frame counters and discards emitters that are no longer alive, done once per frame at most
+void USCosmeticEffectsSubsystem::RefreshFrameBudget() {
+
+	if (BudgetFrameNumber != GFrameCounter) {
+
+		BudgetFrameNumber = GFrameCounter;
+		EffectsPlayedThisFrame = 0;
+
+		// Pooled emitters are deactivated (not destroyed) when they finish, so both cases must be checked
+		LiveEmitters.RemoveAllSwap([](const TWeakObjectPtr<UParticleSystemComponent>& Emitter) {
+
+			return !Emitter.IsValid() || !Emitter->IsActive();
+
+		});
+
+	}
+
+}
+
+
+// Forces an emitter to its lowest detail level, or resets it to automatic LOD selection
+void USCosmeticEffectsSubsystem::ApplyDowngrade(UParticleSystemComponent* Emitter, bool bShouldDowngrade) const {
+
+	// Always set explicitly, as pooled and persistent emitters may have been downgraded before
+	Emitter->bOverrideLODMethod = bShouldDowngrade;
+
+	if (bShouldDowngrade && Emitter->Template) {
+
+		Emitter->LODMethod = PARTICLESYSTEMLODMETHOD_DirectSet;
+		Emitter->SetLODLevel(FMath::Max(Emitter->Template->LODDistances.Num() - 1, 0));
+
+	}
+
+}
@@ -0,0 +1,233 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "General/SFireSchedulerSubsystem.h"
+#include "Gameplay/Weapons/Types/Shooting/SShootingWeapon.h"
+#include "Engine/World.h"
+
+
+
+// Shortest time between two shots of repeated fire, so a misconfigured weapon can't stall the fire pass
+static constexpr float MinimumFireInterval = 0.001f;
+
+
+
+// Sets default values for this subsystem's properties
+USFireSchedulerSubsystem::USFireSchedulerSubsystem() {
+
+	NumTriggersHeld = 0;
+
+}
+
+
+// Adds a weapon and its fire parameters to the scheduler and stores its slot in the weapon; ShotsInBurst is 0 for weapons that don't fire in bursts, BlockDuration is the time firing stays blocked after a manual shot or a completed burst
+void USFireSchedulerSubsystem::RegisterWeapon(ASShootingWeapon* Weapon, float FireInterval, uint8 ShotsInBurst, float BlockDuration) {
+
+	if (Weapon && FindSlot(Weapon) == INDEX_NONE) {
+
+		Weapon->FireSchedulerSlot = Weapons.Add(Weapon);
+		TriggersHeld.Add(false);
+		NextFireTimes.Add(0.0);
+		BlockedUntilTimes.Add(0.0);
+		FireIntervals.Add(FMath::Max(FireInterval, MinimumFireInterval));
+		BlockDurations.Add(BlockDuration);
+		ShotsInBursts.Add(ShotsInBurst);
+		BurstCounts.Add(0);
+
+	}
+
+}
+
+
+// Removes a weapon from the scheduler
+void USFireSchedulerSubsystem::UnregisterWeapon(ASShootingWeapon* Weapon) {
+
+	const int32 Slot = FindSlot(Weapon);
+
+	if (Slot != INDEX_NONE) {
+
+		if (TriggersHeld[Slot]) {
+
+			--NumTriggersHeld;
+
+		}
+
+		// The last slot takes the place of the removed one, the arrays stay dense
+		Weapons.RemoveAtSwap(Slot, 1, false);
+		TriggersHeld.RemoveAtSwap(Slot, 1, false);
+		NextFireTimes.RemoveAtSwap(Slot, 1, false);
+		BlockedUntilTimes.RemoveAtSwap(Slot, 1, false);
+		FireIntervals.RemoveAtSwap(Slot, 1, false);
+		BlockDurations.RemoveAtSwap(Slot, 1, false);
+		ShotsInBursts.RemoveAtSwap(Slot, 1, false);
+		BurstCounts.RemoveAtSwap(Slot, 1, false);
+
+		if (Weapons.IsValidIndex(Slot)) {
+
+			Weapons[Slot]->FireSchedulerSlot = Slot;
+
+		}
+
+		Weapon->FireSchedulerSlot = INDEX_NONE;
+
+	}
+
+}
+
+
+// Starts repeated fire (automatic, burst) for the weapon, the first shot being due after the given delay
+void USFireSchedulerSubsystem::PressTrigger(const ASShootingWeapon* Weapon, float FirstDelay) {
+
+	const int32 Slot = FindSlot(Weapon);
+
+	if (Slot != INDEX_NONE) {
+
+		if (!TriggersHeld[Slot]) {
+
+			TriggersHeld[Slot] = true;
+			++NumTriggersHeld;
+
+		}
+
+		NextFireTimes[Slot] = GetWorld()->GetTimeSeconds() + FirstDelay;
+
+	}
+
+}
+
+
+// Stops repeated fire for the weapon
+void USFireSchedulerSubsystem::ReleaseTrigger(const ASShootingWeapon* Weapon) {
+
+	const int32 Slot = FindSlot(Weapon);
+
+	if (Slot != INDEX_NONE && TriggersHeld[Slot]) {
+
+		TriggersHeld[Slot] = false;
+		--NumTriggersHeld;
+
+	}
+
+}
+
+
+// Fires a single shot of the weapon right away, then blocks its firing for its block duration (unless it was already blocked)
+void USFireSchedulerSubsystem::FireManualShot(const ASShootingWeapon* Weapon) {
+
+	const int32 Slot = FindSlot(Weapon);
+
+	if (Slot != INDEX_NONE) {
+
+		const double Now = GetWorld()->GetTimeSeconds();
+		const bool bFiringBlocked = BlockedUntilTimes[Slot] > Now;
+
+		Weapons[Slot]->FireWeapon(bFiringBlocked, Now);
+
+		// A press during the block doesn't extend it
+		if (!bFiringBlocked) {
+
+			BlockedUntilTimes[Slot] = Now + BlockDurations[Slot];
+
+		}
+
+	}
+
+}
+
+
+// Collects the due shots of every weapon in one pass, then fires them
+void USFireSchedulerSubsystem::Tick(float DeltaTime) {
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const int32 NumSlots = Weapons.Num();
+
+	// Only the trigger and timing arrays are touched here
+	for (int32 Slot = 0; Slot < NumSlots; ++Slot) {
+
+		if (TriggersHeld[Slot]) {
+
+			double& NextFireTime = NextFireTimes[Slot];
+
+			while (NextFireTime <= Now) {
+
+				DueShots.Add({ Slot, Weapons[Slot], NextFireTime });
+				NextFireTime += FireIntervals[Slot];
+
+			}
+
+		}
+
+	}
+
+	// Firing handlers may release triggers or remove weapons, so every shot is checked against its slot's current state
+	for (const FSDueShot& DueShot : DueShots) {
+
+		if (Weapons.IsValidIndex(DueShot.Slot) && Weapons[DueShot.Slot] == DueShot.Weapon && TriggersHeld[DueShot.Slot]) {
+
+			DispatchShot(DueShot.Slot, DueShot.ShotTime);
+
+		}
+
+	}
+
+	DueShots.Reset();
+
+}
+
+
+// Only ticks while a trigger is held
+bool USFireSchedulerSubsystem::IsTickable() const {
+
+	return NumTriggersHeld > 0;
+
+}
+
+
+// The class default object never ticks
+ETickableTickType USFireSchedulerSubsystem::GetTickableTickType() const {
+
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+
+}
+
+
+// Ticks with its own world
+UWorld* USFireSchedulerSubsystem::GetTickableGameObjectWorld() const {
+
+	return GetWorld();
+
+}
+
+
+// Stat for the fire pass
+TStatId USFireSchedulerSubsystem::GetStatId() const {
+
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USFireSchedulerSubsystem, STATGROUP_Tickables);
+
+}
+
+
+// Returns the slot of a registered weapon, INDEX_NONE otherwise
+int32 USFireSchedulerSubsystem::FindSlot(const ASShootingWeapon* Weapon) const {
+
+	return (Weapon && Weapons.IsValidIndex(Weapon->FireSchedulerSlot) && Weapons[Weapon->FireSchedulerSlot] == Weapon) ? Weapon->FireSchedulerSlot : INDEX_NONE;
+
+}
+
+
+// Hands a shot to the weapon's firing handler, then updates the burst counter and firing block of its slot
+void USFireSchedulerSubsystem::DispatchShot(int32 Slot, double ShotTime) {
+
+	const bool bFiringBlocked = BlockedUntilTimes[Slot] > ShotTime;
+	const bool bShotCounts = Weapons[Slot]->FireWeapon(bFiringBlocked, ShotTime);
+
+	// Once the burst is complete, firing is blocked until the end of the pause between bursts
+	if (bShotCounts && ShotsInBursts[Slot] > 0 && ++BurstCounts[Slot] >= ShotsInBursts[Slot]) {
+
+		BlockedUntilTimes[Slot] = ShotTime + BlockDurations[Slot];
+		BurstCounts[Slot] = 0;
+
+	}
+
+}
@@ -0,0 +1,13 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "General/SLogCategories.h"
+
+
+
+DEFINE_LOG_CATEGORY(LogCoopWeapon);
+DEFINE_LOG_CATEGORY(LogCoopAmmo);
+DEFINE_LOG_CATEGORY(LogCoopEquipment);
+DEFINE_LOG_CATEGORY(LogCoopHUD);
+DEFINE_LOG_CATEGORY(LogCoopCosmetics);
@@ -0,0 +1,340 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "General/SReloadTimingWheelSubsystem.h"
+#include "Gameplay/Weapons/Components/SAmmoSystemComponent.h"
+#include "GameFramework/GameStateBase.h"
+#include "Engine/World.h"
+
+
+
+// Wheel geometry
+
+// Ticks per second of the reload clock
+static constexpr double ReloadTicksPerSecond = 128.0;
+
+// Slots of the first level (must be a power of 2) and of each coarser level (idem), in bits
+static constexpr int32 FirstLevelBits = 8;
+static constexpr int32 CoarseLevelBits = 6;
+
+// Number of slots of the first level and of each coarser level
+static constexpr int32 FirstLevelSlots = 1 << FirstLevelBits;
+static constexpr int32 CoarseLevelSlots = 1 << CoarseLevelBits;
+
+// Index of the first slot of each coarser level in the slot heads, and of the overflow list
+static constexpr int32 SecondLevelStart = FirstLevelSlots;
+static constexpr int32 ThirdLevelStart = SecondLevelStart + CoarseLevelSlots;
+static constexpr int32 OverflowSlot = ThirdLevelStart + CoarseLevelSlots;
+
+// Ticks covered by the first level, the first two, and all three
+static constexpr int64 FirstLevelSpan = int64(1) << FirstLevelBits;
+static constexpr int64 SecondLevelSpan = int64(1) << (FirstLevelBits + CoarseLevelBits);
+static constexpr int64 ThirdLevelSpan = int64(1) << (FirstLevelBits + 2 * CoarseLevelBits);
+
+
+
+// Sets default values for this subsystem's properties
+USReloadTimingWheelSubsystem::USReloadTimingWheelSubsystem() {
+
+	FreeListHead = INDEX_NONE;
+	SlotHeads.Init(INDEX_NONE, OverflowSlot + 1);
+	CurrentTick = 0;
+	NumScheduled = 0;
+
+}
+
+
+// Returns the time of the reload clock of the given world: the server's world time (the same as the local one on the server and in standalone)
+double USReloadTimingWheelSubsystem::GetReloadTime(const UWorld* World) {
+
+	// Replicated phase timestamps are in server time, so clients have to read the same clock to make sense of them
+	const AGameStateBase* GameState = World->GetGameState();
+
+	return GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+
+}
+
+
+// Schedules a call to the ammo system's OnReloadDeadline at the given time (reload clock), replacing whatever the handle was scheduled for
+void USReloadTimingWheelSubsystem::Schedule(FSReloadTimerHandle& Handle, USAmmoSystemComponent* AmmoSystem, double Deadline) {
+
+	Cancel(Handle);
+
+	// An empty wheel has nothing to drain, it can simply jump to the present
+	if (NumScheduled == 0) {
+
+		CurrentTick = FMath::Max(CurrentTick, static_cast<int64>(FMath::FloorToDouble(GetReloadTime(GetWorld()) * ReloadTicksPerSecond)));
+
+	}
+
+	if (FreeListHead == INDEX_NONE) {
+
+		FSReloadTimerEntry& NewEntry = Entries.AddDefaulted_GetRef();
+		NewEntry.Serial = 0;
+		NewEntry.Next = INDEX_NONE;
+		FreeListHead = Entries.Num() - 1;
+
+	}
+
+	const int32 EntryIndex = FreeListHead;
+	FSReloadTimerEntry& Entry = Entries[EntryIndex];
+	FreeListHead = Entry.Next;
+
+	// Rounded up, so a deadline is never dispatched early; anything already due goes into the very next tick
+	Entry.AmmoSystem = AmmoSystem;
+	Entry.Deadline = Deadline;
+	Entry.DeadlineTick = FMath::Max(static_cast<int64>(FMath::CeilToDouble(Deadline * ReloadTicksPerSecond)), CurrentTick + 1);
+
+	Link(EntryIndex);
+	++NumScheduled;
+
+	Handle.Index = EntryIndex;
+	Handle.Serial = Entry.Serial;
+
+}
+
+
+// Cancels the deadline of the handle, if it is still scheduled
+void USReloadTimingWheelSubsystem::Cancel(FSReloadTimerHandle& Handle) {
+
+	if (IsScheduled(Handle)) {
+
+		Release(Handle.Index);
+
+	}
+
+	Handle.Invalidate();
+
+}
+
+
+// Returns true if the handle's deadline is still waiting to be dispatched
+bool USReloadTimingWheelSubsystem::IsScheduled(const FSReloadTimerHandle& Handle) const {
+
+	return Handle.IsValid() && Entries.IsValidIndex(Handle.Index) && Entries[Handle.Index].Serial == Handle.Serial && Entries[Handle.Index].SlotHeadIndex != INDEX_NONE;
+
+}
+
+
+// Drains the wheel up to the current time and dispatches the due deadlines, grouped by weapon
+void USReloadTimingWheelSubsystem::Tick(float DeltaTime) {
+
+	AdvanceTo(static_cast<int64>(FMath::FloorToDouble(GetReloadTime(GetWorld()) * ReloadTicksPerSecond)));
+
+	if (DueTimers.Num() > 0) {
+
+		// All the deadlines of a weapon are processed back to back, in order
+		DueTimers.Sort([](const FSDueReloadTimer& A, const FSDueReloadTimer& B) { return (A.Weapon != B.Weapon) ? (A.Weapon < B.Weapon) : (A.Deadline < B.Deadline); });
+
+		// Dispatched callbacks may schedule again, which never touches the due deadlines
+		for (const FSDueReloadTimer& DueTimer : DueTimers) {
+
+			USAmmoSystemComponent* AmmoSystem = DueTimer.AmmoSystem.Get();
+
+			if (AmmoSystem) {
+
+				AmmoSystem->OnReloadDeadline();
+
+			}
+
+		}
+
+		DueTimers.Reset();
+
+	}
+
+}
+
+
+// Only ticks while there is something to drain
+bool USReloadTimingWheelSubsystem::IsTickable() const {
+
+	return NumScheduled > 0;
+
+}
+
+
+// The class default object never ticks
+ETickableTickType USReloadTimingWheelSubsystem::GetTickableTickType() const {
+
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+
+}
+
+
+// Ticks with its own world
+UWorld* USReloadTimingWheelSubsystem::GetTickableGameObjectWorld() const {
+
+	return GetWorld();
+
+}
+
+
+// Stat for the drain
+TStatId USReloadTimingWheelSubsystem::GetStatId() const {
+
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USReloadTimingWheelSubsystem, STATGROUP_Tickables);
+
+}
+
+
+// Puts an entry in the slot matching its deadline tick, relative to the current tick
+void USReloadTimingWheelSubsystem::Link(int32 EntryIndex) {
+
+	FSReloadTimerEntry& Entry = Entries[EntryIndex];
+	const int64 Delta = Entry.DeadlineTick - CurrentTick;
+
+	if (Delta < FirstLevelSpan) {
+
+		Entry.SlotHeadIndex = static_cast<int32>(Entry.DeadlineTick & (FirstLevelSlots - 1));
+
+	}
+	else if (Delta < SecondLevelSpan) {
+
+		Entry.SlotHeadIndex = SecondLevelStart + static_cast<int32>((Entry.DeadlineTick >> FirstLevelBits) & (CoarseLevelSlots - 1));
+
+	}
+	else if (Delta < ThirdLevelSpan) {
+
+		Entry.SlotHeadIndex = ThirdLevelStart + static_cast<int32>((Entry.DeadlineTick >> (FirstLevelBits + CoarseLevelBits)) & (CoarseLevelSlots - 1));
+
+	}
+	else {
+
+		Entry.SlotHeadIndex = OverflowSlot;
+
+	}
+
+	int32& SlotHead = SlotHeads[Entry.SlotHeadIndex];
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = SlotHead;
+
+	if (SlotHead != INDEX_NONE) {
+
+		Entries[SlotHead].Prev = EntryIndex;
+
+	}
+
+	SlotHead = EntryIndex;
+
+}
+
+
+// Takes an entry out of its slot's list
+void USReloadTimingWheelSubsystem::Unlink(int32 EntryIndex) {
+
+	FSReloadTimerEntry& Entry = Entries[EntryIndex];
+
+	if (Entry.Prev != INDEX_NONE) {
+
+		Entries[Entry.Prev].Next = Entry.Next;
+
+	}
+	else {
+
+		SlotHeads[Entry.SlotHeadIndex] = Entry.Next;
+
+	}
+
+	if (Entry.Next != INDEX_NONE) {
+
+		Entries[Entry.Next].Prev = Entry.Prev;
+
+	}
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+	Entry.SlotHeadIndex = INDEX_NONE;
+
+}
+
+
+// Returns an entry to the free list, making its handles stale
+void USReloadTimingWheelSubsystem::Release(int32 EntryIndex) {
+
+	Unlink(EntryIndex);
+
+	FSReloadTimerEntry& Entry = Entries[EntryIndex];
+	Entry.AmmoSystem = nullptr;
+	++Entry.Serial;
+	Entry.Next = FreeListHead;
+	FreeListHead = EntryIndex;
+
+	--NumScheduled;
+
+}
+
+
+// Re-inserts every entry of a list according to its deadline (cascades a slot of a coarser level down)
+void USReloadTimingWheelSubsystem::Cascade(int32 SlotHeadIndex) {
+
+	int32 EntryIndex = SlotHeads[SlotHeadIndex];
+	SlotHeads[SlotHeadIndex] = INDEX_NONE;
+
+	while (EntryIndex != INDEX_NONE) {
+
+		const int32 NextIndex = Entries[EntryIndex].Next;
+		Link(EntryIndex);
+		EntryIndex = NextIndex;
+
+	}
+
+}
+
+
+// Advances the wheel up to the given tick, collecting the due deadlines
+void USReloadTimingWheelSubsystem::AdvanceTo(int64 TargetTick) {
+
+	while (CurrentTick < TargetTick && NumScheduled > 0) {
+
+		++CurrentTick;
+
+		// Coarser levels are cascaded down whenever the finer one wraps around, coarsest first
+		if ((CurrentTick & (FirstLevelSlots - 1)) == 0) {
+
+			const int64 SecondLevelTick = CurrentTick >> FirstLevelBits;
+
+			if ((SecondLevelTick & (CoarseLevelSlots - 1)) == 0) {
+
+				const int64 ThirdLevelTick = SecondLevelTick >> CoarseLevelBits;
+
+				if ((ThirdLevelTick & (CoarseLevelSlots - 1)) == 0) {
+
+					Cascade(OverflowSlot);
+
+				}
+
+				Cascade(ThirdLevelStart + static_cast<int32>(ThirdLevelTick & (CoarseLevelSlots - 1)));
+
+			}
+
+			Cascade(SecondLevelStart + static_cast<int32>(SecondLevelTick & (CoarseLevelSlots - 1)));
+
+		}
+
+		// Every entry of the current first level slot is due now
+		int32 EntryIndex = SlotHeads[CurrentTick & (FirstLevelSlots - 1)];
+
+		while (EntryIndex != INDEX_NONE) {
+
+			const FSReloadTimerEntry& Entry = Entries[EntryIndex];
+			const int32 NextIndex = Entry.Next;
+
+			FSDueReloadTimer& DueTimer = DueTimers.AddDefaulted_GetRef();
+			DueTimer.AmmoSystem = Entry.AmmoSystem;
+			DueTimer.Weapon = Entry.AmmoSystem.IsValid() ? Entry.AmmoSystem->GetOwner() : nullptr;
+			DueTimer.Deadline = Entry.Deadline;
+
+			Release(EntryIndex);
+			EntryIndex = NextIndex;
+
+		}
+
+	}
+
+	// Nothing left to drain, the wheel simply jumps to the present
+	CurrentTick = FMath::Max(CurrentTick, TargetTick);
+
+}
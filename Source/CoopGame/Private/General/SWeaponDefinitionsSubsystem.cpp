@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "General/SWeaponDefinitionsSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Gameplay/Weapons/SWeaponDefinition.h"
+#include "General/SLogCategories.h"
+
+
+
+// Starts preloading the weapon definitions
+void USWeaponDefinitionsSubsystem::Initialize(FSubsystemCollectionBase& Collection) {
+
+	Super::Initialize(Collection);
+
+	if (UAssetManager::IsValid()) {
+
+		WeaponDefinitionsHandle = UAssetManager::Get().LoadPrimaryAssetsWithType(USWeaponDefinition::PrimaryAssetType, { USWeaponDefinition::GameBundle });
+
+	}
+
+	if (WeaponDefinitionsHandle.IsValid()) {
+
+		WorldInitializationHandle = FWorldDelegates::OnPostWorldInitialization.AddUObject(this, &USWeaponDefinitionsSubsystem::OnPostWorldInitialization);
+
+	}
+	else {
+
+		UE_LOG(LogCoopWeapon, Log, TEXT("No weapon definitions left to preload (none found, or all already loaded)"));
+
+	}
+
+}
+
+
+// Releases the weapon definitions
+void USWeaponDefinitionsSubsystem::Deinitialize() {
+
+	FWorldDelegates::OnPostWorldInitialization.Remove(WorldInitializationHandle);
+
+	if (WeaponDefinitionsHandle.IsValid()) {
+
+		WeaponDefinitionsHandle->ReleaseHandle();
+		WeaponDefinitionsHandle.Reset();
+
+	}
+
+	Super::Deinitialize();
+
+}
+
+
+// Waits for the preload to complete once a world is initialized, before any of its actors is
+void USWeaponDefinitionsSubsystem::OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues InitializationValues) {
+
+	// Only the first world usually has to wait (if at all), the preload is done by the time the next one is loaded
+	if (WeaponDefinitionsHandle.IsValid() && WeaponDefinitionsHandle->IsLoadingInProgress()) {
+
+		UE_LOG(LogCoopWeapon, Log, TEXT("Waiting for the weapon definitions to be preloaded before initializing %s"), *GetNameSafe(World));
+		WeaponDefinitionsHandle->WaitUntilComplete();
+
+	}
+
+}
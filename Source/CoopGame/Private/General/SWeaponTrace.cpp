@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "General/SWeaponTrace.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformMisc.h"
+
+
+
+#if COOP_WEAPON_TRACE
+
+FSWeaponTraceRecord FSWeaponTrace::Records[FSWeaponTrace::Capacity];
+volatile int32 FSWeaponTrace::RecordCount = 0;
+
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpWeaponTraceCommand(
+	TEXT("COOP.DumpWeaponTrace"),
+	TEXT("Writes the most recent weapon trace records to the console. Usage: COOP.DumpWeaponTrace [Count]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar) {
+
+		FSWeaponTrace::Dump(Ar, (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 64);
+
+	})
+);
+
+
+// Returns the display name of a weapon trace event
+static const TCHAR* GetWeaponTraceEventName(ESWeaponTraceEvent Event) {
+
+	switch (Event) {
+
+	case ESWeaponTraceEvent::WeaponFired:
+		return TEXT("WeaponFired");
+
+	case ESWeaponTraceEvent::FireBlocked:
+		return TEXT("FireBlocked");
+
+	case ESWeaponTraceEvent::ReloadTriggered:
+		return TEXT("ReloadTriggered");
+
+	case ESWeaponTraceEvent::ReloadCancelled:
+		return TEXT("ReloadCancelled");
+
+	case ESWeaponTraceEvent::WeaponActivated:
+		return TEXT("WeaponActivated");
+
+	case ESWeaponTraceEvent::WeaponDeactivated:
+		return TEXT("WeaponDeactivated");
+
+	case ESWeaponTraceEvent::WeaponSwitched:
+		return TEXT("WeaponSwitched");
+
+	case ESWeaponTraceEvent::ReloadRolledBack:
+		return TEXT("ReloadRolledBack");
+
+	case ESWeaponTraceEvent::WeaponWoken:
+		return TEXT("WeaponWoken");
+
+	default:
+		return TEXT("Unknown");
+
+	}
+
+}
+
+
+// Records an event in the trace
+void FSWeaponTrace::Record(ESWeaponTraceEvent Event, const UObject* Source, int32 ValueA, int32 ValueB) {
+
+	// Claiming a slot is the only synchronization between writers
+	const uint32 Sequence = static_cast<uint32>(FPlatformAtomics::InterlockedIncrement(&RecordCount));
+	FSWeaponTraceRecord& Slot = Records[(Sequence - 1) & (Capacity - 1)];
+
+	// Invalidate the slot while it's being written, then publish it
+	Slot.Sequence = 0;
+	FPlatformMisc::MemoryBarrier();
+
+	Slot.Cycles = FPlatformTime::Cycles64();
+	Slot.Source = Source ? Source->GetFName() : NAME_None;
+	Slot.Event = Event;
+	Slot.ValueA = ValueA;
+	Slot.ValueB = ValueB;
+
+	FPlatformMisc::MemoryBarrier();
+	Slot.Sequence = Sequence;
+
+}
+
+
+// Writes the most recent records of the trace (at most MaxRecords) to the given output device, oldest first
+void FSWeaponTrace::Dump(FOutputDevice& Ar, int32 MaxRecords) {
+
+	const uint32 TotalRecords = static_cast<uint32>(FPlatformAtomics::AtomicRead(&RecordCount));
+	const uint32 RecordsToDump = FMath::Min(static_cast<uint32>(FMath::Max(MaxRecords, 0)), FMath::Min(TotalRecords, Capacity));
+	const uint64 NowCycles = FPlatformTime::Cycles64();
+
+	Ar.Logf(TEXT("Weapon trace: %u records written, showing the last %u"), TotalRecords, RecordsToDump);
+
+	for (uint32 Sequence = TotalRecords - RecordsToDump + 1; Sequence <= TotalRecords; ++Sequence) {
+
+		const FSWeaponTraceRecord& Slot = Records[(Sequence - 1) & (Capacity - 1)];
+
+		// Copy the record, then make sure it wasn't overwritten or still being written while it was copied
+		const uint32 SequenceBefore = Slot.Sequence;
+		FPlatformMisc::MemoryBarrier();
+		const FSWeaponTraceRecord Copy = Slot;
+		FPlatformMisc::MemoryBarrier();
+
+		if (SequenceBefore != Sequence || Slot.Sequence != Sequence) {
+
+			continue;
+
+		}
+
+		const double SecondsAgo = FPlatformTime::ToSeconds64(NowCycles - Copy.Cycles);
+		Ar.Logf(TEXT("[%u] -%.3fs %s %s (%d, %d)"), Sequence, SecondsAgo, GetWeaponTraceEventName(Copy.Event), *Copy.Source.ToString(), Copy.ValueA, Copy.ValueB);
+
+	}
+
+}
+
+#endif // COOP_WEAPON_TRACE
@@ -0,0 +1,292 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "Gameplay/Weapons/Helpers/AmmoCore.h"
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+
+
+
+/*
+ *
+ * Headless throughput and fuzz test of the ammo core (CoopGame.Ammo.CoreFuzz, one variant per number of transitions).
+ * It drives random sequences of fire, reload, cancel, weapon switch and time advances through the passive, magazine and per-bullet reload policies with simulated time,
+ * checks the state invariants after every transition (any broken one fails the test) and reports the transitions per second of each policy. Nothing in it needs a world or a renderer,
+ * so it can gate a build agent, e.g.: UE4Editor-Cmd CoopGame -nullrhi -unattended -ExecCmds="Automation RunTests CoopGame.Ammo.CoreFuzz; Quit"
+ *
+ */
+
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+ *
+ *	Ammo core listener that checks the values it receives instead of broadcasting them
+ *
+ */
+struct FSAmmoFuzzListener {
+
+	void OnAmmoChanged(int32 BulletsCurrentlyActive, int32 AvailableReloads) { bValuesOutOfRange |= (BulletsCurrentlyActive < 0 || BulletsCurrentlyActive > MaximumBullets || AvailableReloads < -1); ++EventCount; }
+	void OnBulletsAdded(uint8 NumBulletsAdded) { bValuesOutOfRange |= (NumBulletsAdded == 0); ++EventCount; }
+
+	template<typename PolicyType> void OnReloadStarted(PolicyType, float FirstDelay) { ++EventCount; }
+	template<typename PolicyType> void OnReloadCycleStarted(PolicyType, float CycleDuration) { ++EventCount; }
+	template<typename PolicyType> void OnReloadCompleted(PolicyType) { ++EventCount; }
+	template<typename PolicyType> void OnReloadCancelled(PolicyType, ESAmmoCancelTrigger CancelType) { ++EventCount; }
+	void OnMagazineBulletsIn(float TimeToCompletion) { ++EventCount; }
+	void OnReloadCancelledWithWinddown(float TimeToCompletion) { ++EventCount; }
+
+	int32 MaximumBullets = 0;
+	bool bValuesOutOfRange = false;
+	int64 EventCount = 0;
+
+};
+
+
+// Builds a random but valid reload configuration
+static FSAmmoConfig MakeFuzzConfig(FRandomStream& Random) {
+
+	FSAmmoConfig Config;
+
+	Config.MaximumBullets = Random.RandRange(1, 30);
+	Config.PassiveReloadDelay = Random.FRandRange(0.01f, 2.0f);
+	Config.ReloadTimePassive = Random.FRandRange(0.01f, 1.0f);
+	Config.bEnableMagazineReloadCancel = Random.FRand() < 0.5f;
+	Config.BulletsReloadTimeMagazine = Random.FRandRange(0.01f, 3.0f);
+	Config.WinddownReloadTimeMagazine = Random.FRandRange(0.01f, 1.0f);
+	Config.bCapMagazinesPerLife = Random.FRand() < 0.5f;
+	Config.MagazinesPerLife = Random.RandRange(1, 10);
+	Config.BulletPerReload = static_cast<uint8>(Random.RandRange(1, 4));
+	Config.ReloadDelayTimeBullet = Random.FRandRange(0.01f, 1.0f);
+	Config.ReloadTimeBullet = Random.FRandRange(0.01f, 1.0f);
+	Config.ReloadEndTimeBullet = Random.FRandRange(0.01f, 1.0f);
+	Config.bCapBulletsPerLife = Random.FRand() < 0.5f;
+	Config.BulletsPerLife = Config.MaximumBullets + Random.RandRange(0, 100);
+
+	return Config;
+
+}
+
+
+// Returns a description of the first invariant broken by the state, or an empty string if there is none
+template<typename PolicyType>
+static FString CheckAmmoInvariants(const FSAmmoState& State, const FSAmmoConfig& Config, double Now) {
+
+	const double NextDeadline = TSAmmoCore<PolicyType>::NextDeadline(State, Config);
+
+	if (State.BulletsCurrentlyActive < 0 || State.BulletsCurrentlyActive > Config.MaximumBullets) {
+
+		return FString::Printf(TEXT("bullets %d out of [0, %d]"), State.BulletsCurrentlyActive, Config.MaximumBullets);
+
+	}
+
+	if (State.IsReloading() != (NextDeadline != AmmoCoreNoDeadline)) {
+
+		return FString::Printf(TEXT("reloading %d but next deadline %f"), State.IsReloading(), NextDeadline);
+
+	}
+
+	// Every boundary up to now must have been processed
+	if (State.IsReloading() && NextDeadline < Now - 1e-6) {
+
+		return FString::Printf(TEXT("deadline %f already passed at %f"), NextDeadline, Now);
+
+	}
+
+	if (State.bReloadIsBeingCancelled && State.Phase != ESAmmoPhase::Winddown) {
+
+		return FString::Printf(TEXT("cancel underway in phase %d"), static_cast<int32>(State.Phase));
+
+	}
+
+	if (!State.IsReloading() && (State.PerBulletReloadCycles != 0 || State.bReloadIsBeingCancelled)) {
+
+		return FString::Printf(TEXT("idle with %d reload cycles, cancel underway %d"), State.PerBulletReloadCycles, State.bReloadIsBeingCancelled);
+
+	}
+
+	if (Config.bCapMagazinesPerLife && State.MagazinesExpended > Config.MagazinesPerLife) {
+
+		return FString::Printf(TEXT("magazines %d over the cap of %d"), State.MagazinesExpended, Config.MagazinesPerLife);
+
+	}
+
+	if (Config.bCapBulletsPerLife && TIsSame<PolicyType, FSPerBulletReloadPolicy>::Value && State.BulletsExpended > Config.BulletsPerLife) {
+
+		return FString::Printf(TEXT("bullets loaded %d over the cap of %d"), State.BulletsExpended, Config.BulletsPerLife);
+
+	}
+
+	if (TIsSame<PolicyType, FSMagazineReloadPolicy>::Value && State.Phase == ESAmmoPhase::Winddown && State.BulletsCurrentlyActive != Config.MaximumBullets) {
+
+		return FString::Printf(TEXT("magazine wind-down with %d out of %d bullets"), State.BulletsCurrentlyActive, Config.MaximumBullets);
+
+	}
+
+	if (TSAmmoCore<PolicyType>::GetAvailableReloads(State, Config) < -1) {
+
+		return TEXT("negative available reloads");
+
+	}
+
+	return FString();
+
+}
+
+
+// Runs the given number of random transitions through the ammo core of the given policy; returns false (and adds an error to the test) on the first broken invariant
+template<typename PolicyType>
+static bool FuzzAmmoPolicy(const TCHAR* PolicyName, int32 Transitions, int32 Seed, FAutomationTestBase& Test) {
+
+	typedef TSAmmoCore<PolicyType> FCore;
+
+	FRandomStream Random(Seed);
+	FSAmmoConfig Config = MakeFuzzConfig(Random);
+	FSAmmoState State;
+	FSAmmoFuzzListener Listener;
+	Listener.MaximumBullets = Config.MaximumBullets;
+
+	FCore::Initialize(State, Config);
+	FCore::Activate(State, Config, 0.0, Listener);
+
+	static const ESAmmoCancelTrigger CancelTriggers[] = { ESAmmoCancelTrigger::TriggerByWeaponAction, ESAmmoCancelTrigger::TriggerByReload, ESAmmoCancelTrigger::TriggerByLimitReached, ESAmmoCancelTrigger::TriggerByExternal, ESAmmoCancelTrigger::GenericPassiveTrigger };
+
+	double Now = 0.0;
+	bool bHolstered = false;
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 Transition = 0; Transition < Transitions; ++Transition) {
+
+		const int32 Action = Random.RandRange(0, 9);
+		const ESAmmoCancelTrigger CancelType = CancelTriggers[Random.RandRange(0, UE_ARRAY_COUNT(CancelTriggers) - 1)];
+
+		// Time always moves on a bit, and sometimes a lot
+		Now += (Action == 0) ? Random.FRandRange(0.0f, 5.0f) : Random.FRandRange(0.0f, 0.05f);
+
+		// Life is reset every now and then, like a respawn would
+		if (Random.RandRange(0, 9999) == 0) {
+
+			Config = MakeFuzzConfig(Random);
+			Listener.MaximumBullets = Config.MaximumBullets;
+			FCore::Initialize(State, Config);
+
+		}
+		else if (bHolstered) {
+
+			// Nothing happens to a holstered weapon, until it's drawn again
+			if (Action <= 2) {
+
+				bHolstered = false;
+				FCore::Activate(State, Config, Now, Listener);
+
+			}
+
+		}
+		else if (Action <= 4) {
+
+			FCore::Advance(State, Config, Now, Listener);
+			const bool bWasReloading = State.IsReloading();
+
+			uint8 BulletsTrulyExpended = 0;
+			const uint8 NumToExpend = static_cast<uint8>(Random.RandRange(1, 3));
+			const int32 BulletsBefore = State.BulletsCurrentlyActive;
+			const bool bFired = FCore::ConsumeAmmo(State, Config, Now, Random.FRand() < 0.5f, NumToExpend, BulletsTrulyExpended, Listener);
+
+			if (bFired && PolicyType::bBlocksFiring && bWasReloading) {
+
+				Test.AddError(FString::Printf(TEXT("%s: fired while reloading at transition %d (seed %d)"), PolicyName, Transition, Seed));
+				return false;
+
+			}
+
+			if (bFired && (BulletsTrulyExpended == 0 || BulletsTrulyExpended > NumToExpend || BulletsTrulyExpended > BulletsBefore)) {
+
+				Test.AddError(FString::Printf(TEXT("%s: expended %u of %u requested with %d available at transition %d (seed %d)"), PolicyName, BulletsTrulyExpended, NumToExpend, BulletsBefore, Transition, Seed));
+				return false;
+
+			}
+
+		}
+		else if (Action <= 6) {
+
+			FCore::Trigger(State, Config, Now, Random.FRand() < 0.2f, CancelType, Listener);
+
+		}
+		else if (Action <= 8) {
+
+			FCore::Advance(State, Config, Now, Listener);
+			FCore::Cancel(State, Config, Now, CancelType, Listener);
+
+		}
+		else {
+
+			FCore::Advance(State, Config, Now, Listener);
+			FCore::Cancel(State, Config, Now, ESAmmoCancelTrigger::TriggerByWeaponSwitch, Listener);
+			bHolstered = true;
+
+		}
+
+		// Catch up with the deadlines before checking, as the owner's timer would
+		FCore::Advance(State, Config, Now, Listener);
+
+		const FString BrokenInvariant = CheckAmmoInvariants<PolicyType>(State, Config, Now);
+
+		if (!BrokenInvariant.IsEmpty() || Listener.bValuesOutOfRange) {
+
+			Test.AddError(FString::Printf(TEXT("%s: invariant broken at transition %d (seed %d): %s"), PolicyName, Transition, Seed, BrokenInvariant.IsEmpty() ? TEXT("event values out of range") : *BrokenInvariant));
+			return false;
+
+		}
+
+	}
+
+	const double ElapsedTime = FMath::Max(FPlatformTime::Seconds() - StartTime, 1.0e-9);
+	Test.AddInfo(FString::Printf(TEXT("%s: %d transitions, %lld events, %.0f simulated seconds in %.3f s (%.2f M transitions/s)"), PolicyName, Transitions, Listener.EventCount, Now, ElapsedTime, (Transitions / ElapsedTime) / 1.0e6));
+
+	return true;
+
+}
+
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FSAmmoCoreFuzzTest, "CoopGame.Ammo.CoreFuzz", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// One variant per number of transitions (each policy gets that many), with a fixed seed so a failure can be reproduced
+void FSAmmoCoreFuzzTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const {
+
+	OutBeautifiedNames.Add(TEXT("Transitions100K"));
+	OutTestCommands.Add(TEXT("100000 1337"));
+
+	OutBeautifiedNames.Add(TEXT("Transitions3M"));
+	OutTestCommands.Add(TEXT("3000000 7331"));
+
+}
+
+
+// Fuzzes every reload policy with the number of transitions and seed of the variant ("Transitions Seed")
+bool FSAmmoCoreFuzzTest::RunTest(const FString& Parameters) {
+
+	FString TransitionsString;
+	FString SeedString;
+
+	if (!Parameters.Split(TEXT(" "), &TransitionsString, &SeedString)) {
+
+		TransitionsString = Parameters;
+
+	}
+
+	const int32 Transitions = FMath::Max(FCString::Atoi(*TransitionsString), 1);
+	const int32 Seed = FCString::Atoi(*SeedString);
+
+	// Every policy is fuzzed even if a previous one failed, so a single run reports all of them
+	bool bSuccess = FuzzAmmoPolicy<FSPassiveReloadPolicy>(TEXT("Passive"), Transitions, Seed, *this);
+	bSuccess &= FuzzAmmoPolicy<FSMagazineReloadPolicy>(TEXT("Magazine"), Transitions, Seed, *this);
+	bSuccess &= FuzzAmmoPolicy<FSPerBulletReloadPolicy>(TEXT("Per-bullet"), Transitions, Seed, *this);
+
+	return bSuccess;
+
+}
+
+#endif
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/SAmmoEventsTestListener.h"
+#include "Gameplay/Weapons/Components/SAmmoSystemComponent.h"
+
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Number of broadcasts timed for each way of broadcasting the ammo changed event
+static const int32 AmmoEventIterations = 100000;
+
+
+
+// Runs the broadcast AmmoEventIterations times and returns its average cost in nanoseconds
+static double MeasureAmmoEventNanoseconds(TFunctionRef<void(int32)> Broadcast) {
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < AmmoEventIterations; ++Iteration) {
+
+		Broadcast(Iteration);
+
+	}
+
+	return ((FPlatformTime::Seconds() - StartTime) * 1.0e9) / AmmoEventIterations;
+
+}
+
+
+/*
+ *
+ * Compares the cost of an ammo changed broadcast through the native event and through the Blueprint delegate, each with a single listener, and the one of the bridge the ammo system
+ * broadcasts its events through when nothing listens (native broadcast, Blueprint delegate skipped because unbound). The costs are reported; the test fails if a listener misses a
+ * broadcast or if the unbound bridge reaches anything
+ *
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSAmmoEventsBenchmarkTest, "CoopGame.Ammo.EventBroadcastCost", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSAmmoEventsBenchmarkTest::RunTest(const FString& Parameters) {
+
+	USAmmoSystemComponent* AmmoSystem = NewObject<USAmmoSystemComponent>(GetTransientPackage());
+	USAmmoEventsTestListener* Listener = NewObject<USAmmoEventsTestListener>(GetTransientPackage());
+
+	// Same as the ammo system's own broadcasts: the Blueprint delegate is only broadcast when bound
+	const double UnboundBridgeCost = MeasureAmmoEventNanoseconds([AmmoSystem](int32 Iteration) {
+
+		AmmoSystem->AmmoChangedEvent.Broadcast(Iteration, -1);
+		if (AmmoSystem->AmmoChangedDelegate.IsBound()) {
+
+			AmmoSystem->AmmoChangedDelegate.Broadcast(Iteration, -1);
+
+		}
+
+	});
+	TestEqual(TEXT("Broadcasts received through the unbound bridge"), Listener->NumBroadcasts, 0);
+
+	AmmoSystem->AmmoChangedEvent.AddUObject(Listener, &USAmmoEventsTestListener::OnAmmoChanged);
+	const double NativeCost = MeasureAmmoEventNanoseconds([AmmoSystem](int32 Iteration) { AmmoSystem->AmmoChangedEvent.Broadcast(Iteration, -1); });
+	AmmoSystem->AmmoChangedEvent.RemoveAll(Listener);
+	TestEqual(TEXT("Broadcasts received through the native event"), Listener->NumBroadcasts, AmmoEventIterations);
+
+	Listener->NumBroadcasts = 0;
+	AmmoSystem->AmmoChangedDelegate.AddDynamic(Listener, &USAmmoEventsTestListener::OnAmmoChanged);
+	const double DynamicCost = MeasureAmmoEventNanoseconds([AmmoSystem](int32 Iteration) { AmmoSystem->AmmoChangedDelegate.Broadcast(Iteration, -1); });
+	AmmoSystem->AmmoChangedDelegate.RemoveAll(Listener);
+	TestEqual(TEXT("Broadcasts received through the Blueprint delegate"), Listener->NumBroadcasts, AmmoEventIterations);
+
+	AddInfo(FString::Printf(TEXT("Ammo event broadcast over %d iterations: native (1 listener) %.1f ns, Blueprint delegate (1 listener) %.1f ns, native + unbound Blueprint bridge (0 listeners) %.1f ns"), AmmoEventIterations, NativeCost, DynamicCost, UnboundBridgeCost));
+
+	Listener->MarkPendingKill();
+	AmmoSystem->MarkPendingKill();
+
+	return !HasAnyErrors();
+
+}
+
+#endif
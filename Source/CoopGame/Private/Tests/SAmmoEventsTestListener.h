@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "SAmmoEventsTestListener.generated.h"
+
+
+
+/*
+ *
+ * Listener of the ammo changed events used by the ammo event broadcast test: it only counts the broadcasts it receives, so the measured cost is the one of the broadcast itself.
+ * It has to be a UObject so it can be bound to the Blueprint delegate as well as to the native event
+ *
+ */
+UCLASS(Transient)
+class USAmmoEventsTestListener : public UObject {
+
+	GENERATED_BODY()
+
+
+public:
+
+	// Number of ammo changed broadcasts received so far
+	int32 NumBroadcasts = 0;
+
+	// Counts an ammo changed broadcast
+	UFUNCTION()
+	void OnAmmoChanged(int32 newBulletsCurrentlyAvailable, int32 newAvailableReloads) {
+
+		++NumBroadcasts;
+
+	}
+
+};
@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/STestWorld.h"
+#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "GameFramework/DamageType.h"
+#include "Gameplay/Characters/SPlayerCharacter.h"
+#include "Gameplay/EnvHazards/SBoomBarrel.h"
+#include "Gameplay/Weapons/SWeaponDefinition.h"
+#include "Gameplay/Weapons/Types/Shooting/SRaycastWeapon.h"
+#include "Gameplay/Weapons/Helpers/AmmoCore.h"
+
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Counts the particle system components living in the given world
+static int32 CountEmittersInWorld(const UWorld* World) {
+
+	int32 NumEmitters = 0;
+
+	for (TObjectIterator<UParticleSystemComponent> It; It; ++It) {
+
+		if (!It->IsPendingKill() && It->GetWorld() == World) {
+
+			++NumEmitters;
+
+		}
+
+	}
+
+	return NumEmitters;
+
+}
+
+
+// Spawns a raycast weapon of the given type with every effect set, held by the given character and ready to fire
+static ASRaycastWeapon* SpawnTestWeapon(UWorld* World, ASPlayerCharacter* Shooter, UShootingWeaponType WeaponType, UParticleSystem* Effect) {
+
+	USWeaponDefinition* Definition = NewObject<USWeaponDefinition>(GetTransientPackage());
+	Definition->WeaponType = WeaponType;
+	Definition->ReloadType = UReloadType::ActiveMagazineReload;
+	Definition->BulletPerMagazine = 30;
+	Definition->BulletsReloadTimeMagazine = 1.0f;
+	Definition->WinddownReloadTimeMagazine = 0.5f;
+	Definition->MuzzleEffect = Effect;
+
+	ASRaycastWeapon* Weapon = World->SpawnActorDeferred<ASRaycastWeapon>(ASRaycastWeapon::StaticClass(), Shooter->GetActorTransform(), Shooter, Shooter);
+	if (Weapon) {
+
+		FSTestWorld::SetObjectProperty(Weapon, TEXT("WeaponDefinition"), Definition);
+		FSTestWorld::SetObjectProperty(Weapon, TEXT("TracerEffect"), Effect);
+		FSTestWorld::SetObjectProperty(Weapon, TEXT("DefaultImpactEffect"), Effect);
+		FSTestWorld::SetObjectProperty(Weapon, TEXT("FleshImpactEffect"), Effect);
+		UGameplayStatics::FinishSpawningActor(Weapon, Shooter->GetActorTransform());
+
+		Weapon->WeaponOwner = Shooter;
+		Weapon->ActivateWeapon();
+
+	}
+
+	return Weapon;
+
+}
+
+
+/*
+ *
+ * Fires a manual and an automatic raycast weapon and detonates an explosive barrel in a dedicated server world, with every effect of theirs set, and checks that not a single
+ * particle system component was created: nobody can see them on a dedicated server, so all the cosmetic work must be skipped (see USCosmeticEffectsSubsystem::AreCosmeticsEnabled)
+ *
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSDedicatedServerSpawnsNoEmittersTest, "CoopGame.Cosmetics.DedicatedServerSpawnsNoEmitters", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+bool FSDedicatedServerSpawnsNoEmittersTest::RunTest(const FString& Parameters) {
+
+	FSTestWorld TestWorld(NM_DedicatedServer);
+	UWorld* World = TestWorld.World;
+
+	if (World->GetNetMode() != NM_DedicatedServer) {
+
+		AddError(TEXT("Couldn't create a dedicated server world"));
+		return false;
+
+	}
+
+	UParticleSystem* Effect = NewObject<UParticleSystem>(GetTransientPackage());
+	const int32 InitialNumEmitters = CountEmittersInWorld(World);
+
+	ASPlayerCharacter* Shooter = World->SpawnActor<ASPlayerCharacter>(ASPlayerCharacter::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+	if (!Shooter) {
+
+		AddError(TEXT("Couldn't spawn the shooting character"));
+		return false;
+
+	}
+
+	// The barrel is put right in the line of fire
+	FActorSpawnParameters BarrelSpawnParameters;
+	BarrelSpawnParameters.bDeferConstruction = true;
+	ASBoomBarrel* Barrel = World->SpawnActor<ASBoomBarrel>(ASBoomBarrel::StaticClass(), Shooter->GetActorForwardVector() * 300.0f, FRotator::ZeroRotator, BarrelSpawnParameters);
+	if (Barrel) {
+
+		FSTestWorld::SetObjectProperty(Barrel, TEXT("ExplosionParticle"), Effect);
+		UGameplayStatics::FinishSpawningActor(Barrel, Barrel->GetActorTransform());
+
+	}
+
+	ASRaycastWeapon* ManualWeapon = SpawnTestWeapon(World, Shooter, UShootingWeaponType::ManualFire, Effect);
+	ASRaycastWeapon* AutomaticWeapon = SpawnTestWeapon(World, Shooter, UShootingWeaponType::AutomaticFire, Effect);
+	if (!Barrel || !ManualWeapon || !AutomaticWeapon) {
+
+		AddError(TEXT("Couldn't spawn the barrel and weapons"));
+		return false;
+
+	}
+
+	// A manual shot is fired on the press itself, the automatic weapon keeps firing for as long as the world is ticked
+	ManualWeapon->OnPrimaryWeaponActionPressed();
+	ManualWeapon->OnPrimaryWeaponActionReleased();
+	AutomaticWeapon->OnPrimaryWeaponActionPressed();
+	TestWorld.Tick(30);
+	AutomaticWeapon->OnPrimaryWeaponActionReleased();
+
+	UGameplayStatics::ApplyDamage(Barrel, 1000.0f, nullptr, nullptr, UDamageType::StaticClass());
+	TestWorld.Tick(2);
+
+	// Make sure everything did happen, otherwise the absence of emitters would prove nothing
+	FSAmmoSnapshot ManualAmmo;
+	FSAmmoSnapshot AutomaticAmmo;
+	TestTrue(TEXT("Manual weapon fired"), ManualWeapon->CaptureAmmoSnapshot(ManualAmmo) && ManualAmmo.BulletsCurrentlyActive < 30);
+	TestTrue(TEXT("Automatic weapon fired"), AutomaticWeapon->CaptureAmmoSnapshot(AutomaticAmmo) && AutomaticAmmo.BulletsCurrentlyActive < 30);
+
+	FBoolProperty* IsAliveProperty = FindFProperty<FBoolProperty>(ASBoomBarrel::StaticClass(), TEXT("bIsAlive"));
+	TestTrue(TEXT("Barrel exploded"), IsAliveProperty && !IsAliveProperty->GetPropertyValue_InContainer(Barrel));
+
+	TestEqual(TEXT("Particle system components created on the dedicated server"), CountEmittersInWorld(World) - InitialNumEmitters, 0);
+
+	return !HasAnyErrors();
+
+}
+
+#endif
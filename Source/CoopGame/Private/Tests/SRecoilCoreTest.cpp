@@ -0,0 +1,184 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "Gameplay/Weapons/Helpers/RecoilCore.h"
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Seed of the jittery frame sequence
+static const int32 RecoilFrameSeed = 0x0BAD5EED;
+
+
+
+// Returns true if both states are bit for bit the same (no tolerance, the simulation is meant to be exact)
+static bool AreRecoilStatesIdentical(const FSRecoilState& A, const FSRecoilState& B) {
+
+	return A.AccumulatedSpread == B.AccumulatedSpread && A.RecoilPitch == B.RecoilPitch && A.RecoilYaw == B.RecoilYaw && A.ShotIndex == B.ShotIndex && A.Step == B.Step;
+
+}
+
+
+// Scheduled times of a firing session: a long automatic burst, a faster one after a short pause, then single shots after a long one; none of them on a frame boundary
+static TArray<double> BuildRecoilShotTimes() {
+
+	TArray<double> ShotTimes;
+
+	for (int32 Shot = 0; Shot < 40; ++Shot) {
+
+		ShotTimes.Add(0.0137 + Shot * 0.1);
+
+	}
+
+	for (int32 Shot = 0; Shot < 15; ++Shot) {
+
+		ShotTimes.Add(4.7311 + Shot * 0.0667);
+
+	}
+
+	for (int32 Shot = 0; Shot < 5; ++Shot) {
+
+		ShotTimes.Add(7.9023 + Shot * 0.4519);
+
+	}
+
+	return ShotTimes;
+
+}
+
+
+// Fires the shots the way the weapon does, frame after frame: at the end of every frame, the shots that came due during it are fired at their scheduled time, in order
+static FSRecoilState FireOverFrames(const FSRecoilConfig& Config, const TArray<double>& ShotTimes, const TArray<double>& FrameTimes, TArray<FSRecoilShot>& OutShots) {
+
+	FSRecoilState State;
+	int32 NextShot = 0;
+
+	for (const double FrameTime : FrameTimes) {
+
+		while (NextShot < ShotTimes.Num() && ShotTimes[NextShot] <= FrameTime) {
+
+			OutShots.Add(FSRecoilCore::Fire(State, Config, ShotTimes[NextShot]));
+			++NextShot;
+
+		}
+
+	}
+
+	return State;
+
+}
+
+
+// Frame end times at a fixed rate, up to the given time
+static TArray<double> BuildFixedFrameTimes(double FrameRate, double EndTime) {
+
+	TArray<double> FrameTimes;
+
+	for (int32 Frame = 1; Frame / FrameRate <= EndTime + 1.0 / FrameRate; ++Frame) {
+
+		FrameTimes.Add(Frame / FrameRate);
+
+	}
+
+	return FrameTimes;
+
+}
+
+
+/*
+ *
+ * Checks that the recoil and spread simulation doesn't depend on the frame rate: the same shots fired through frames at 60 Hz, 144 Hz and a jittery 20 to 240 Hz must give bit for bit
+ * the same offsets and end state, and so must firing the same shot times into a fresh state with no frames at all (which is how the state is rebuilt from the shot times alone).
+ * Also checks that the accumulated spread and recoil stay within their maximums, the sideways kick included
+ *
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSRecoilCoreTest, "CoopGame.Weapons.RecoilDeterminism", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSRecoilCoreTest::RunTest(const FString& Parameters) {
+
+	FSRecoilConfig Config;
+	Config.BaseSpread = 0.5f;
+	Config.SpreadPerShot = 0.35f;
+	Config.MaxSpread = 4.0f;
+	Config.RecoilPitchPerShot = 0.8f;
+	Config.MaxRecoilPitch = 12.0f;
+	Config.RecoilYawPerShot = 0.6f;
+	Config.MaxRecoilYaw = 2.5f;
+	Config.RecoveryHalfLife = 0.25f;
+	Config.PatternSeed = 0xC0FFEEu;
+
+	const TArray<double> ShotTimes = BuildRecoilShotTimes();
+	const double EndTime = ShotTimes.Last();
+
+	// Incremental state, at 60 Hz
+	TArray<FSRecoilShot> ReferenceShots;
+	const FSRecoilState ReferenceState = FireOverFrames(Config, ShotTimes, BuildFixedFrameTimes(60.0, EndTime), ReferenceShots);
+	TestEqual(TEXT("Shots fired at 60 Hz"), ReferenceShots.Num(), ShotTimes.Num());
+
+	// Same shots through other frame sequences
+	FRandomStream Random(RecoilFrameSeed);
+	TArray<double> JitteryFrameTimes;
+	for (double FrameTime = 0.0; FrameTime <= EndTime;) {
+
+		FrameTime += Random.FRandRange(1.0f / 240.0f, 1.0f / 20.0f);
+		JitteryFrameTimes.Add(FrameTime);
+
+	}
+
+	// Rebuilt from the shot times alone, a single "frame" at the end
+	const TArray<double> NoFrameTimes = { EndTime };
+
+	const TPair<const TCHAR*, TArray<double>> FrameSequences[] = {
+
+		TPair<const TCHAR*, TArray<double>>(TEXT("144 Hz"), BuildFixedFrameTimes(144.0, EndTime)),
+		TPair<const TCHAR*, TArray<double>>(TEXT("jittery frame rate"), JitteryFrameTimes),
+		TPair<const TCHAR*, TArray<double>>(TEXT("rebuilt from the shot times"), NoFrameTimes)
+
+	};
+
+	for (const TPair<const TCHAR*, TArray<double>>& FrameSequence : FrameSequences) {
+
+		TArray<FSRecoilShot> Shots;
+		const FSRecoilState State = FireOverFrames(Config, ShotTimes, FrameSequence.Value, Shots);
+
+		TestTrue(*FString::Printf(TEXT("State at 60 Hz and %s identical"), FrameSequence.Key), AreRecoilStatesIdentical(State, ReferenceState));
+		TestEqual(*FString::Printf(TEXT("Shots fired with the %s"), FrameSequence.Key), Shots.Num(), ReferenceShots.Num());
+
+		for (int32 Shot = 0; Shot < FMath::Min(Shots.Num(), ReferenceShots.Num()); ++Shot) {
+
+			if (Shots[Shot].PitchOffset != ReferenceShots[Shot].PitchOffset || Shots[Shot].YawOffset != ReferenceShots[Shot].YawOffset) {
+
+				AddError(FString::Printf(TEXT("Offsets of shot %d differ between 60 Hz and %s"), Shot, FrameSequence.Key));
+				break;
+
+			}
+
+		}
+
+	}
+
+	// Bounds, shot after shot
+	FSRecoilState BoundedState;
+	for (const double ShotTime : ShotTimes) {
+
+		FSRecoilCore::Fire(BoundedState, Config, ShotTime);
+
+		if (BoundedState.AccumulatedSpread > Config.MaxSpread - Config.BaseSpread || BoundedState.RecoilPitch > Config.MaxRecoilPitch || FMath::Abs(BoundedState.RecoilYaw) > Config.MaxRecoilYaw) {
+
+			AddError(FString::Printf(TEXT("Recoil out of bounds after shot %u: spread %f, pitch %f, yaw %f"), BoundedState.ShotIndex, BoundedState.AccumulatedSpread, BoundedState.RecoilPitch, BoundedState.RecoilYaw));
+			break;
+
+		}
+
+	}
+
+	return !HasAnyErrors();
+
+}
+
+#endif
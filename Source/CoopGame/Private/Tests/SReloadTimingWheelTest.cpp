@@ -0,0 +1,340 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "Tests/STestWorld.h"
+#include "General/SReloadTimingWheelSubsystem.h"
+
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Geometry of the wheel (see SReloadTimingWheelSubsystem.cpp): ticks per second, and ticks covered by the first level, the first two, and all three
+static constexpr double WheelTicksPerSecond = 128.0;
+static constexpr int64 WheelFirstLevelSpan = int64(1) << 8;
+static constexpr int64 WheelSecondLevelSpan = int64(1) << 14;
+static constexpr int64 WheelThirdLevelSpan = int64(1) << 20;
+
+// Number of schedule/cancel/advance rounds of the randomized part, and its seed
+static const int32 WheelFuzzRounds = 400;
+static const int32 WheelFuzzSeed = 0x5EED;
+
+
+
+// Lists the given deadlines (in ticks) for comparison
+static FString DescribeTicks(const TArray<double>& Ticks) {
+
+	FString Description;
+
+	for (const double Tick : Ticks) {
+
+		Description += FString::Printf(TEXT("%s%.2f"), Description.IsEmpty() ? TEXT("") : TEXT(", "), Tick);
+
+	}
+
+	return Description;
+
+}
+
+
+/*
+ *
+ * Deterministic test of the reload timing wheel, driven tick by tick without any real time involved: deadlines must come due exactly at their tick and in order when they cross the
+ * boundaries between levels, deadlines further than the third level must wait in the overflow list and be re-inserted from it (back into it if still too far), cancelling or rescheduling
+ * an entry linked in the middle of a slot list must leave its neighbours in place and make its old handle stale. A seeded random sequence of all of the above is then checked against a
+ * plain model, and the wheel is finally ticked with its world to make sure it drains itself and stops ticking once empty
+ *
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSReloadTimingWheelTest, "CoopGame.Ammo.ReloadTimingWheel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+bool FSReloadTimingWheelTest::RunTest(const FString& Parameters) {
+
+	FSTestWorld TestWorld(NM_Standalone);
+
+	// Every part starts from an empty wheel at tick 0 (the test world's clock hasn't moved)
+	auto CreateWheel = [&TestWorld]() { return NewObject<USReloadTimingWheelSubsystem>(TestWorld.World); };
+
+	auto ScheduleAtTick = [](USReloadTimingWheelSubsystem* Wheel, FSReloadTimerHandle& Handle, double Tick) { Wheel->Schedule(Handle, nullptr, Tick / WheelTicksPerSecond); };
+
+	// Advances the wheel up to the given tick and returns the deadlines (in ticks) it collected, in collection order
+	auto AdvanceTo = [](USReloadTimingWheelSubsystem* Wheel, int64 TargetTick) {
+
+		Wheel->AdvanceTo(TargetTick);
+
+		TArray<double> DueTicks;
+		for (const auto& DueTimer : Wheel->DueTimers) {
+
+			DueTicks.Add(DueTimer.Deadline * WheelTicksPerSecond);
+
+		}
+		Wheel->DueTimers.Reset();
+
+		return DueTicks;
+
+	};
+
+	auto TestDue = [this, &AdvanceTo](const TCHAR* What, USReloadTimingWheelSubsystem* Wheel, int64 TargetTick, const TArray<double>& ExpectedTicks) {
+
+		TestEqual(What, DescribeTicks(AdvanceTo(Wheel, TargetTick)), DescribeTicks(ExpectedTicks));
+
+	};
+
+
+	// Cascading: a deadline is due exactly at its tick whichever level it was first put in, including right on the boundaries between levels
+	{
+
+		USReloadTimingWheelSubsystem* Wheel = CreateWheel();
+		const TArray<double> Ticks = { WheelFirstLevelSpan - 1, WheelFirstLevelSpan, 300, WheelSecondLevelSpan - 1, WheelSecondLevelSpan, WheelSecondLevelSpan + 300, WheelThirdLevelSpan - 1 };
+
+		TArray<FSReloadTimerHandle> Handles;
+		Handles.SetNum(Ticks.Num());
+		for (int32 Index = 0; Index < Ticks.Num(); ++Index) {
+
+			ScheduleAtTick(Wheel, Handles[Index], Ticks[Index]);
+
+		}
+
+		TArray<double> SortedTicks = Ticks;
+		SortedTicks.Sort();
+
+		for (const double Tick : SortedTicks) {
+
+			TestDue(TEXT("Cascading, nothing due before the deadline"), Wheel, static_cast<int64>(Tick) - 1, {});
+			TestDue(TEXT("Cascading, due at the deadline"), Wheel, static_cast<int64>(Tick), { Tick });
+
+		}
+
+		for (const FSReloadTimerHandle& Handle : Handles) {
+
+			TestFalse(TEXT("Cascading, dispatched handle still scheduled"), Wheel->IsScheduled(Handle));
+
+		}
+		TestEqual(TEXT("Cascading, deadlines left"), Wheel->NumScheduled, 0);
+
+	}
+
+
+	// Overflow: deadlines beyond the third level wait in the overflow list, and go back into it when it is cascaded while they are still too far
+	{
+
+		USReloadTimingWheelSubsystem* Wheel = CreateWheel();
+		const int32 OverflowSlotIndex = Wheel->SlotHeads.Num() - 1;
+		const double NearTick = WheelThirdLevelSpan + 5;
+		const double FarTick = 2 * WheelThirdLevelSpan + 7;
+
+		FSReloadTimerHandle NearHandle;
+		FSReloadTimerHandle FarHandle;
+		ScheduleAtTick(Wheel, NearHandle, NearTick);
+		ScheduleAtTick(Wheel, FarHandle, FarTick);
+
+		TestEqual(TEXT("Overflow, near deadline in the overflow list"), Wheel->Entries[NearHandle.Index].SlotHeadIndex, OverflowSlotIndex);
+		TestEqual(TEXT("Overflow, far deadline in the overflow list"), Wheel->Entries[FarHandle.Index].SlotHeadIndex, OverflowSlotIndex);
+
+		TestDue(TEXT("Overflow, nothing due when the overflow list is cascaded"), Wheel, WheelThirdLevelSpan, {});
+		TestNotEqual(TEXT("Overflow, near deadline taken out of the overflow list"), Wheel->Entries[NearHandle.Index].SlotHeadIndex, OverflowSlotIndex);
+		TestEqual(TEXT("Overflow, far deadline re-inserted into the overflow list"), Wheel->Entries[FarHandle.Index].SlotHeadIndex, OverflowSlotIndex);
+
+		TestDue(TEXT("Overflow, near deadline not due early"), Wheel, static_cast<int64>(NearTick) - 1, {});
+		TestDue(TEXT("Overflow, near deadline due"), Wheel, static_cast<int64>(NearTick), { NearTick });
+		TestDue(TEXT("Overflow, far deadline not due early"), Wheel, static_cast<int64>(FarTick) - 1, {});
+		TestDue(TEXT("Overflow, far deadline due"), Wheel, static_cast<int64>(FarTick), { FarTick });
+		TestFalse(TEXT("Overflow, far handle still scheduled"), Wheel->IsScheduled(FarHandle));
+
+	}
+
+
+	// Cancel and reschedule: entries sharing a slot are linked together, taking one out (in the middle or at the head) must leave the others due on time
+	{
+
+		USReloadTimingWheelSubsystem* Wheel = CreateWheel();
+
+		// The same tick, and a tick a lap later that lands on the same first level slot once cascaded; the fractions keep the deadlines apart without changing their tick
+		FSReloadTimerHandle FirstHandle;
+		FSReloadTimerHandle MiddleHandle;
+		FSReloadTimerHandle LastHandle;
+		FSReloadTimerHandle NextLapHandle;
+		ScheduleAtTick(Wheel, FirstHandle, 39.25);
+		ScheduleAtTick(Wheel, MiddleHandle, 39.5);
+		ScheduleAtTick(Wheel, LastHandle, 39.75);
+		ScheduleAtTick(Wheel, NextLapHandle, 40 + WheelFirstLevelSpan);
+
+		const FSReloadTimerHandle StaleMiddleHandle = MiddleHandle;
+		Wheel->Cancel(MiddleHandle);
+		TestFalse(TEXT("Cancel, cancelled handle still scheduled"), Wheel->IsScheduled(StaleMiddleHandle));
+		TestFalse(TEXT("Cancel, handle still set after cancelling"), MiddleHandle.IsValid());
+
+		// The cancelled entry is reused right away, its old handle must not see the new deadline
+		FSReloadTimerHandle ReusedHandle;
+		ScheduleAtTick(Wheel, ReusedHandle, 60);
+		TestEqual(TEXT("Cancel, freed entry reused"), ReusedHandle.Index, StaleMiddleHandle.Index);
+		TestFalse(TEXT("Cancel, stale handle sees the reused entry"), Wheel->IsScheduled(StaleMiddleHandle));
+
+		// The head of the slot list moves to another slot
+		const FSReloadTimerHandle StaleLastHandle = LastHandle;
+		ScheduleAtTick(Wheel, LastHandle, 20);
+		TestFalse(TEXT("Reschedule, old handle still scheduled"), Wheel->IsScheduled(StaleLastHandle));
+		TestTrue(TEXT("Reschedule, new handle scheduled"), Wheel->IsScheduled(LastHandle));
+
+		TestDue(TEXT("Reschedule, rescheduled deadline due"), Wheel, 20, { 20.0 });
+		TestDue(TEXT("Cancel, linked neighbour due"), Wheel, 40, { 39.25 });
+		TestDue(TEXT("Cancel, reused entry due"), Wheel, 60, { 60.0 });
+		TestDue(TEXT("Cancel, next lap due"), Wheel, 40 + WheelFirstLevelSpan, { static_cast<double>(40 + WheelFirstLevelSpan) });
+		TestEqual(TEXT("Cancel, deadlines left"), Wheel->NumScheduled, 0);
+
+	}
+
+
+	// Firing order: whatever the scheduling order, deadlines are collected by tick, and a deadline between two ticks is never collected before it
+	{
+
+		USReloadTimingWheelSubsystem* Wheel = CreateWheel();
+
+		const TArray<double> Ticks = { 10.0, 3.0, 7.0, 5.25, 1.0, 9.0 };
+		for (const double Tick : Ticks) {
+
+			FSReloadTimerHandle Handle;
+			ScheduleAtTick(Wheel, Handle, Tick);
+
+		}
+
+		TestDue(TEXT("Firing order, up to tick 5"), Wheel, 5, { 1.0, 3.0 });
+		TestDue(TEXT("Firing order, up to tick 10"), Wheel, 10, { 5.25, 7.0, 9.0, 10.0 });
+
+	}
+
+
+	// Randomized schedules, cancels, reschedules and advances, checked against a plain list of deadlines; every deadline is on its own tick, so the collection order is fully defined
+	{
+
+		USReloadTimingWheelSubsystem* Wheel = CreateWheel();
+		FRandomStream Random(WheelFuzzSeed);
+
+		const int64 Spans[] = { WheelFirstLevelSpan, WheelSecondLevelSpan, WheelThirdLevelSpan, 3 * WheelThirdLevelSpan };
+		TMap<int64, FSReloadTimerHandle> Scheduled;
+		int64 CurrentTick = 0;
+
+		auto PickFreeTick = [&]() {
+
+			int64 Tick;
+			do {
+
+				Tick = CurrentTick + 1 + Random.RandRange(0, static_cast<int32>(Spans[Random.RandRange(0, 3)]) - 2);
+
+			} while (Scheduled.Contains(Tick));
+
+			return Tick;
+
+		};
+
+		// Advances the wheel and checks it collected exactly the model's deadlines up to there, in order
+		auto AdvanceAndCheck = [&](int64 TargetTick) {
+
+			TArray<double> ExpectedTicks;
+			for (auto It = Scheduled.CreateIterator(); It; ++It) {
+
+				if (It.Key() <= TargetTick) {
+
+					ExpectedTicks.Add(static_cast<double>(It.Key()));
+					TestTrue(TEXT("Fuzz, handle scheduled until due"), Wheel->IsScheduled(It.Value()));
+					It.RemoveCurrent();
+
+				}
+
+			}
+			ExpectedTicks.Sort();
+
+			TestEqual(*FString::Printf(TEXT("Fuzz, due up to tick %lld"), TargetTick), DescribeTicks(AdvanceTo(Wheel, TargetTick)), DescribeTicks(ExpectedTicks));
+			CurrentTick = TargetTick;
+
+		};
+
+		for (int32 Round = 0; Round < WheelFuzzRounds && !HasAnyErrors(); ++Round) {
+
+			const int32 NumToSchedule = Random.RandRange(1, 4);
+			for (int32 Index = 0; Index < NumToSchedule; ++Index) {
+
+				const int64 Tick = PickFreeTick();
+				ScheduleAtTick(Wheel, Scheduled.Add(Tick), static_cast<double>(Tick));
+
+			}
+
+			// Cancels or reschedules one of the deadlines
+			if (Random.FRand() < 0.3f) {
+
+				TArray<int64> Keys;
+				Scheduled.GetKeys(Keys);
+				const int64 Tick = Keys[Random.RandRange(0, Keys.Num() - 1)];
+
+				FSReloadTimerHandle Handle = Scheduled.FindAndRemoveChecked(Tick);
+				const FSReloadTimerHandle StaleHandle = Handle;
+
+				if (Random.FRand() < 0.5f) {
+
+					Wheel->Cancel(Handle);
+
+				}
+				else {
+
+					const int64 NewTick = PickFreeTick();
+					ScheduleAtTick(Wheel, Handle, static_cast<double>(NewTick));
+					Scheduled.Add(NewTick, Handle);
+
+				}
+
+				TestFalse(TEXT("Fuzz, stale handle still scheduled"), Wheel->IsScheduled(StaleHandle));
+
+			}
+
+			// Mostly short steps (a few frames), sometimes long ones across several cascades
+			const int64 Step = (Random.FRand() < 0.05f) ? Random.RandRange(0, static_cast<int32>(WheelThirdLevelSpan)) : Random.RandRange(0, 300);
+			AdvanceAndCheck(CurrentTick + Step);
+
+			TestEqual(TEXT("Fuzz, deadlines scheduled"), Wheel->NumScheduled, Scheduled.Num());
+
+		}
+
+		int64 LastTick = CurrentTick;
+		for (const TPair<int64, FSReloadTimerHandle>& Entry : Scheduled) {
+
+			LastTick = FMath::Max(LastTick, Entry.Key);
+
+		}
+		AdvanceAndCheck(LastTick);
+		TestEqual(TEXT("Fuzz, deadlines left"), Wheel->NumScheduled, 0);
+
+	}
+
+
+	// Tick: the wheel drains itself with its world's clock, and stops ticking once empty
+	{
+
+		USReloadTimingWheelSubsystem* Wheel = CreateWheel();
+
+		FSReloadTimerHandle EarlyHandle;
+		FSReloadTimerHandle LateHandle;
+		Wheel->Schedule(EarlyHandle, nullptr, 0.25);
+		Wheel->Schedule(LateHandle, nullptr, 0.5);
+		TestTrue(TEXT("Tick, ticking while scheduled"), Wheel->IsTickable());
+
+		// Frames of 1/64 s, two ticks of the wheel each
+		TestWorld.Tick(15, 1.0f / 64.0f);
+		TestTrue(TEXT("Tick, early deadline dispatched early"), Wheel->IsScheduled(EarlyHandle));
+
+		TestWorld.Tick(1, 1.0f / 64.0f);
+		TestFalse(TEXT("Tick, early deadline not dispatched"), Wheel->IsScheduled(EarlyHandle));
+		TestTrue(TEXT("Tick, late deadline dispatched early"), Wheel->IsScheduled(LateHandle));
+
+		TestWorld.Tick(16, 1.0f / 64.0f);
+		TestFalse(TEXT("Tick, late deadline not dispatched"), Wheel->IsScheduled(LateHandle));
+		TestFalse(TEXT("Tick, ticking while empty"), Wheel->IsTickable());
+
+	}
+
+	return !HasAnyErrors();
+
+}
+
+#endif
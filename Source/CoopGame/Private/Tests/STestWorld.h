@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Tickable.h"
+#include "UObject/UnrealType.h"
+
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+ *
+ * Transient game world for the automation tests of the module: created with the given net mode and already playing, so actors spawned in it begin play right away; the world and its context
+ * are destroyed with it. The net mode is simulated the same way play-in-editor does it, which is only possible in editor builds: elsewhere the world takes the net mode of the running process,
+ * so tests that depend on it must check World->GetNetMode() before going any further.
+ *
+ */
+struct FSTestWorld {
+
+	// Creates the world and starts play in it
+	explicit FSTestWorld(ENetMode NetMode) {
+
+#if WITH_EDITOR
+		const EWorldType::Type WorldType = EWorldType::PIE;
+#else
+		const EWorldType::Type WorldType = EWorldType::Game;
+#endif
+
+		World = UWorld::CreateWorld(WorldType, false);
+
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(WorldType);
+		WorldContext.SetCurrentWorld(World);
+
+#if WITH_EDITOR
+		World->SetPlayInEditorInitialNetMode(NetMode);
+#endif
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+
+	}
+
+	// Destroys the world and its context
+	~FSTestWorld() {
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+
+	}
+
+	// Advances the world by the given number of frames, tickable objects (e.g.: the world's subsystems) included
+	void Tick(int32 NumFrames, float DeltaSeconds = 1.0f / 60.0f) {
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame) {
+
+			World->Tick(LEVELTICK_All, DeltaSeconds);
+			FTickableGameObject::TickObjects(World, LEVELTICK_All, false, DeltaSeconds);
+
+		}
+
+	}
+
+	// Sets an object property that can't be reached from outside its class (e.g.: an EditDefaultsOnly asset of a weapon), returns false if the object has no such property
+	static bool SetObjectProperty(UObject* Object, FName PropertyName, UObject* Value) {
+
+		bool Success = false;
+
+		FObjectPropertyBase* Property = Object ? FindFProperty<FObjectPropertyBase>(Object->GetClass(), PropertyName) : nullptr;
+		if (Property) {
+
+			Property->SetObjectPropertyValue_InContainer(Object, Value);
+			Success = true;
+
+		}
+
+		return Success;
+
+	}
+
+	UWorld* World;
+
+};
+
+#endif
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/STestWorld.h"
+#include "Kismet/GameplayStatics.h"
+#include "Gameplay/Weapons/SWeaponDefinition.h"
+#include "Gameplay/Weapons/Types/Shooting/SRaycastWeapon.h"
+#include "Gameplay/Weapons/Helpers/AmmoCore.h"
+
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+ *
+ * Spawns a raycast weapon with a weapon definition whose tuning differs from every default of the weapon itself, and checks that the weapon's recoil and its ammo system are set up
+ * from the definition: the weapon reads its tuning through the shared definition rather than from its own properties
+ *
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSWeaponReadsDefinitionTuningTest, "CoopGame.Weapons.ReadsDefinitionTuning", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+bool FSWeaponReadsDefinitionTuningTest::RunTest(const FString& Parameters) {
+
+	FSTestWorld TestWorld(NM_Standalone);
+	UWorld* World = TestWorld.World;
+
+	USWeaponDefinition* Definition = NewObject<USWeaponDefinition>(GetTransientPackage());
+	Definition->WeaponType = UShootingWeaponType::ManualFire;
+	Definition->BaseSpread = 1.5f;
+	Definition->MaxSpread = 4.0f;
+	Definition->RecoilPitchPerShot = 0.75f;
+	Definition->RecoilRecoveryHalfLife = 0.4f;
+	Definition->ReloadType = UReloadType::ActivePerBulletReload;
+	Definition->MaximumBulletCapacity = 7;
+	Definition->BulletPerReload = 1;
+
+	ASRaycastWeapon* Weapon = World->SpawnActorDeferred<ASRaycastWeapon>(ASRaycastWeapon::StaticClass(), FTransform::Identity);
+	if (!Weapon) {
+
+		AddError(TEXT("Couldn't spawn the weapon"));
+		return false;
+
+	}
+
+	FSTestWorld::SetObjectProperty(Weapon, TEXT("WeaponDefinition"), Definition);
+	UGameplayStatics::FinishSpawningActor(Weapon, FTransform::Identity);
+
+	const FSRecoilConfig& RecoilConfig = Weapon->GetRecoilConfig();
+	TestEqual(TEXT("Base spread"), RecoilConfig.BaseSpread, Definition->BaseSpread);
+	TestEqual(TEXT("Maximum spread"), RecoilConfig.MaxSpread, Definition->MaxSpread);
+	TestEqual(TEXT("Recoil pitch per shot"), RecoilConfig.RecoilPitchPerShot, Definition->RecoilPitchPerShot);
+	TestEqual(TEXT("Recoil recovery half-life"), RecoilConfig.RecoveryHalfLife, Definition->RecoilRecoveryHalfLife);
+
+	TestEqual(TEXT("Reload type"), Weapon->GetReloadType(), Definition->ReloadType);
+
+	// A freshly spawned weapon starts at its maximum capacity
+	FSAmmoSnapshot Snapshot;
+	TestTrue(TEXT("Weapon has an ammo state"), Weapon->CaptureAmmoSnapshot(Snapshot));
+	TestEqual(TEXT("Bullets available"), Snapshot.BulletsCurrentlyActive, static_cast<int32>(Definition->MaximumBulletCapacity));
+
+	return !HasAnyErrors();
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/STestWorld.h"
+#include "Gameplay/Characters/SPlayerCharacter.h"
+#include "Gameplay/Characters/Components/SCharacterEquipmentComponent.h"
+#include "Gameplay/Weapons/Types/Shooting/SRaycastWeapon.h"
+#include "Gameplay/Weapons/Types/Shooting/SBeamWeapon.h"
+
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Number of switches timed for each kind of target weapon
+static const int32 SwitchLatencyIterations = 200;
+
+// Average time a switch to a pre-warmed weapon may take, in milliseconds (the switch is only a state flip, it must stay well under what waking a weapon up is allowed, see ASWeapon::ReactivationBudgetMs)
+static const double PrewarmedSwitchBudgetMs = 0.5;
+
+
+
+// Switches back and forth between the first two slots, the target weapon being readied by Prepare (outside of the timing); returns the average latency of a switch in milliseconds
+static double MeasureSwitchLatencyMs(USCharacterEquipmentComponent* EquipComp, TFunctionRef<void(ASWeapon*)> Prepare, int32& OutSwitches) {
+
+	double TotalTime = 0.0;
+	OutSwitches = 0;
+
+	for (int32 Iteration = 0; Iteration < SwitchLatencyIterations; ++Iteration) {
+
+		const int32 TargetSlotIndex = (EquipComp->GetCurrentSlotIndex() == 0) ? 1 : 0;
+		Prepare(EquipComp->GetWeaponInSlot(TargetSlotIndex));
+
+		const double StartTime = FPlatformTime::Seconds();
+		if (EquipComp->ChangeToWeaponSlot(TargetSlotIndex)) {
+
+			TotalTime += FPlatformTime::Seconds() - StartTime;
+			++OutSwitches;
+
+		}
+
+	}
+
+	return (OutSwitches > 0) ? (TotalTime * 1000.0) / OutSwitches : 0.0;
+
+}
+
+
+/*
+ *
+ * Gives a character a loadout of two weapons and times ChangeToWeaponSlot() back and forth between them, first with the target weapon hibernating and then with it pre-warmed, which is what
+ * the equipment component does with the weapon most likely to be switched to next. Both latencies are reported; the test fails if a switch to a pre-warmed weapon is over PrewarmedSwitchBudgetMs
+ *
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSWeaponSwitchLatencyTest, "CoopGame.Equipment.SwitchLatency", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+bool FSWeaponSwitchLatencyTest::RunTest(const FString& Parameters) {
+
+	FSTestWorld TestWorld(NM_Standalone);
+	UWorld* World = TestWorld.World;
+
+	// Nobody possesses the character, so it doesn't spawn its default loadout
+	ASPlayerCharacter* Character = World->SpawnActor<ASPlayerCharacter>(ASPlayerCharacter::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+	USCharacterEquipmentComponent* EquipComp = Character ? Character->CharEquipComp : nullptr;
+	if (!EquipComp) {
+
+		AddError(TEXT("Couldn't spawn the character"));
+		return false;
+
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.Owner = Character;
+	SpawnParameters.Instigator = Character;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	// A loadout holds a single weapon of each class
+	TArray<ASWeapon*> Weapons;
+	Weapons.Add(World->SpawnActor<ASRaycastWeapon>(ASRaycastWeapon::StaticClass(), Character->GetActorTransform(), SpawnParameters));
+	Weapons.Add(World->SpawnActor<ASBeamWeapon>(ASBeamWeapon::StaticClass(), Character->GetActorTransform(), SpawnParameters));
+
+	if (!Weapons[0] || !Weapons[1] || !EquipComp->EquipStowedLoadout(Weapons) || !EquipComp->GetWeaponInSlot(1)) {
+
+		AddError(TEXT("Couldn't give the character a loadout of two weapons"));
+		return false;
+
+	}
+
+	int32 HibernatedSwitches = 0;
+	int32 PrewarmedSwitches = 0;
+	const double HibernatedLatencyMs = MeasureSwitchLatencyMs(EquipComp, [](ASWeapon* Target) { Target->SetHibernating(true); }, HibernatedSwitches);
+	const double PrewarmedLatencyMs = MeasureSwitchLatencyMs(EquipComp, [](ASWeapon* Target) { Target->PrewarmWeapon(); }, PrewarmedSwitches);
+
+	AddInfo(FString::Printf(TEXT("Weapon switch over %d iterations: to a hibernated weapon %.4f ms, to a pre-warmed weapon %.4f ms"), SwitchLatencyIterations, HibernatedLatencyMs, PrewarmedLatencyMs));
+
+	TestEqual(TEXT("Switches to a hibernated weapon"), HibernatedSwitches, SwitchLatencyIterations);
+	TestEqual(TEXT("Switches to a pre-warmed weapon"), PrewarmedSwitches, SwitchLatencyIterations);
+
+	if (PrewarmedLatencyMs > PrewarmedSwitchBudgetMs) {
+
+		AddError(FString::Printf(TEXT("A switch to a pre-warmed weapon took %.4f ms on average, over its budget of %.4f ms"), PrewarmedLatencyMs, PrewarmedSwitchBudgetMs));
+
+	}
+
+	return !HasAnyErrors();
+
+}
+
+#endif
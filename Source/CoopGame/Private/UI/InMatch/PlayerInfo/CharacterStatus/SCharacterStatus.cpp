@@ -5,6 +5,7 @@
 #include "UI/InMatch/PlayerInfo/CharacterStatus/SCharacterStatus.h"
 #include "Components/TextBlock.h"
 #include "Components/ProgressBar.h"
+#include "General/SLogCategories.h"
 
 
 
@@ -87,7 +88,7 @@ void USCharacterStatus::ProcessHP(float DeltaTime) {
 		else {
 			
 			HPBar->SetPercent(0.0f);
-			UE_LOG(LogTemp, Error, TEXT("MaximumHP is 0!"));
+			UE_LOG(LogCoopHUD, Error, TEXT("MaximumHP is 0!"));
 			
 		}
 		
@@ -112,7 +113,7 @@ void USCharacterStatus::ProcessATP(float DeltaTime) {
 		else {
 			
 			ATPBar->SetPercent(0.0f);
-			UE_LOG(LogTemp, Error, TEXT("MaximumATP is 0!"));
+			UE_LOG(LogCoopHUD, Error, TEXT("MaximumATP is 0!"));
 			
 		}
 		
@@ -8,6 +8,7 @@
 #include "Gameplay/Weapons/Components/SAmmoSystemComponent.h"
 #include "Gameplay/Weapons/Types/Shooting/SShootingWeapon.h"
 #include "Gameplay/Weapons/Helpers/WeaponUtilities.h"
+#include "General/SLogCategories.h"
 
 
 
@@ -92,7 +93,7 @@ void USCrosshair::HideAllReloadWidgets() {
 }
 
 
-// Auxiliary function for processing the unbinding of the previous weapon's reload system delegates
+// Auxiliary function for processing the unbinding of the previous weapon's reload system events
 void USCrosshair::UnbindReloadDelegates(USAmmoSystemComponent* AmmoSysComp) {
 
 	if (AmmoSysComp) {
@@ -123,153 +124,97 @@ void USCrosshair::UnbindReloadDelegates(USAmmoSystemComponent* AmmoSysComp) {
 }
 
 
-// Auxiliary function for unbinding all passive reload system delegates
+// Auxiliary function for unbinding all passive reload system events
 void USCrosshair::UnbindPassiveReloadDelegates(USAmmoSystemComponent* AmmoSysComp) {
 
 	if (AmmoSysComp) {
 		
-		// Bullets added delegate (for +1 pop-up once bullets-in)
-		if (AmmoSysComp->BulletsAddedDelegate.IsBound()) {
-
-			AmmoSysComp->BulletsAddedDelegate.RemoveDynamic(this, &USCrosshair::K2_OnBulletsAdded);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous bullets added delegate bound? %u"), AmmoSysComp->BulletsAddedDelegate.IsBound());
+		// Bullets added event (for +1 pop-up once bullets-in)
+		AmmoSysComp->BulletsAddedEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous bullets added event bound? %u"), AmmoSysComp->BulletsAddedEvent.IsBound());
 
 	
-		// Passive start delegate (for initial delay animation and successive bullets-in)
-		if (AmmoSysComp->PassiveStartDelegate.IsBound()) {
-
-			AmmoSysComp->PassiveStartDelegate.RemoveDynamic(this, &USCrosshair::USCrosshair::K2_OnPassiveReloadStarted);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous passive start delegate bound? %u"), AmmoSysComp->PassiveStartDelegate.IsBound());
+		// Passive start event (for initial delay animation and successive bullets-in)
+		AmmoSysComp->PassiveStartEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous passive start event bound? %u"), AmmoSysComp->PassiveStartEvent.IsBound());
 
 
-		// Passive reload cycle start delegate (looping section)
-		if (AmmoSysComp->PassiveReloadCycleStartDelegate.IsBound()) {
-
-			AmmoSysComp->PassiveReloadCycleStartDelegate.RemoveDynamic(this, &USCrosshair::K2_OnPassiveReloadCycleStarted);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous passive reload cycle start delegate bound? %u"), AmmoSysComp->PassiveReloadCycleStartDelegate.IsBound());
+		// Passive reload cycle start event (looping section)
+		AmmoSysComp->PassiveReloadCycleStartEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous passive reload cycle start event bound? %u"), AmmoSysComp->PassiveReloadCycleStartEvent.IsBound());
 		
 		
-		// Passive cancel delegate (for reload cancel animation to be triggered)
-		if (AmmoSysComp->PassiveCancelDelegate.IsBound()) {
-
-			AmmoSysComp->PassiveCancelDelegate.RemoveDynamic(this, &USCrosshair::K2_OnPassiveReloadCancelled);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous passive cancel delegate bound? %u"), AmmoSysComp->PassiveCancelDelegate.IsBound());
+		// Passive cancel event (for reload cancel animation to be triggered)
+		AmmoSysComp->PassiveCancelEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous passive cancel event bound? %u"), AmmoSysComp->PassiveCancelEvent.IsBound());
 		
 	}
 	
 }
 
 
-// Auxiliary function for unbinding all magazine reload system delegates
+// Auxiliary function for unbinding all magazine reload system events
 void USCrosshair::UnbindMagazineReloadDelegates(USAmmoSystemComponent* AmmoSysComp) {
 
 	if (AmmoSysComp) {
 		
-		// Magazine start delegate (start of bullets-in animation)
-		if (AmmoSysComp->MagazineStartDelegate.IsBound()) {
-
-			AmmoSysComp->MagazineStartDelegate.RemoveDynamic(this, &USCrosshair::K2_OnMagazineReloadStarted);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous magazine start delegate bound? %u"), AmmoSysComp->MagazineStartDelegate.IsBound());
+		// Magazine start event (start of bullets-in animation)
+		AmmoSysComp->MagazineStartEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous magazine start event bound? %u"), AmmoSysComp->MagazineStartEvent.IsBound());
 
 	
-		// Magazine bullets-in delegate (start of wind-down animation)
-		if (AmmoSysComp->MagazineBulletsInDelegate.IsBound()) {
-
-			AmmoSysComp->MagazineBulletsInDelegate.RemoveDynamic(this, &USCrosshair::K2_OnMagazineReloadBulletsIn);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous magazine bullets-in delegate bound? %u"), AmmoSysComp->MagazineBulletsInDelegate.IsBound());
+		// Magazine bullets-in event (start of wind-down animation)
+		AmmoSysComp->MagazineBulletsInEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous magazine bullets-in event bound? %u"), AmmoSysComp->MagazineBulletsInEvent.IsBound());
 
 	
-		// Magazine complete delegate (start of fade-out animation)
-		if (AmmoSysComp->MagazineCompleteDelegate.IsBound()) {
-
-			AmmoSysComp->MagazineCompleteDelegate.RemoveDynamic(this, &USCrosshair::K2_OnMagazineReloadComplete);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous magazine complete delegate bound? %u"), AmmoSysComp->MagazineCompleteDelegate.IsBound());
+		// Magazine complete event (start of fade-out animation)
+		AmmoSysComp->MagazineCompleteEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous magazine complete event bound? %u"), AmmoSysComp->MagazineCompleteEvent.IsBound());
 
 	
-		// Magazine cancel delegate (for reload cancel animation to be triggered)
-		if (AmmoSysComp->MagazineCancelDelegate.IsBound()) {
-
-			AmmoSysComp->MagazineCancelDelegate.RemoveDynamic(this, &USCrosshair::K2_OnMagazineReloadCancelled);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous magazine cancel delegate bound? %u"), AmmoSysComp->MagazineCancelDelegate.IsBound());
+		// Magazine cancel event (for reload cancel animation to be triggered)
+		AmmoSysComp->MagazineCancelEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous magazine cancel event bound? %u"), AmmoSysComp->MagazineCancelEvent.IsBound());
 		
 	}
 	
 }
 
 
-// Auxiliary function for unbinding all per-bullet reload system delegates
+// Auxiliary function for unbinding all per-bullet reload system events
 void USCrosshair::UnbindPerBulletReloadDelegates(USAmmoSystemComponent* AmmoSysComp) {
 
 	if (AmmoSysComp) {
 		
-		// Bullets added delegate (for +x pop-up once bullets-in)
-		if (AmmoSysComp->BulletsAddedDelegate.IsBound()) {
-
-			AmmoSysComp->BulletsAddedDelegate.RemoveDynamic(this, &USCrosshair::K2_OnBulletsAdded);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous bullets added delegate bound? %u"), AmmoSysComp->BulletsAddedDelegate.IsBound());
+		// Bullets added event (for +x pop-up once bullets-in)
+		AmmoSysComp->BulletsAddedEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous bullets added event bound? %u"), AmmoSysComp->BulletsAddedEvent.IsBound());
 	
 
-		// Per-bullet start delegate (start of readying-up animation)
-		if (AmmoSysComp->PerBulletStartDelegate.IsBound()) {
-
-			AmmoSysComp->PerBulletStartDelegate.RemoveDynamic(this, &USCrosshair::K2_OnPerBulletReloadStarted);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous per-bullet start delegate bound? %u"), AmmoSysComp->PerBulletStartDelegate.IsBound());
+		// Per-bullet start event (start of readying-up animation)
+		AmmoSysComp->PerBulletStartEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous per-bullet start event bound? %u"), AmmoSysComp->PerBulletStartEvent.IsBound());
 
 		
-		// Per-bullet reload cycle start delegate (looping section)
-		if (AmmoSysComp->PerBulletReloadCycleStartDelegate.IsBound()) {
-
-			AmmoSysComp->PerBulletReloadCycleStartDelegate.RemoveDynamic(this, &USCrosshair::K2_OnPerBulletReloadCycleStarted);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous per-bullet reload cycle start delegate bound? %u"), AmmoSysComp->PerBulletReloadCycleStartDelegate.IsBound());
+		// Per-bullet reload cycle start event (looping section)
+		AmmoSysComp->PerBulletReloadCycleStartEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous per-bullet reload cycle start event bound? %u"), AmmoSysComp->PerBulletReloadCycleStartEvent.IsBound());
 		
 	
-		// Per-bullet timed cancel delegate (start of wind-down animation)
-		if (AmmoSysComp->PerBulletTimedCancelDelegate.IsBound()) {
-
-			AmmoSysComp->PerBulletTimedCancelDelegate.RemoveDynamic(this, &USCrosshair::K2_OnPerBulletCancelledWithTime);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous per-bullet timed cancel delegate bound? %u"), AmmoSysComp->PerBulletTimedCancelDelegate.IsBound());
-
+		// Per-bullet timed cancel event (start of wind-down animation)
+		AmmoSysComp->PerBulletTimedCancelEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous per-bullet timed cancel event bound? %u"), AmmoSysComp->PerBulletTimedCancelEvent.IsBound());
 
-		// Per-bullet complete delegate (successful timed cancel)
-		if (AmmoSysComp->PerBulletCompleteDelegate.IsBound()) {
 
-			AmmoSysComp->PerBulletCompleteDelegate.RemoveDynamic(this, &USCrosshair::K2_OnPerBulletComplete);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous per-bullet complete delegate bound? %u"), AmmoSysComp->PerBulletCompleteDelegate.IsBound());
+		// Per-bullet complete event (successful timed cancel)
+		AmmoSysComp->PerBulletCompleteEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous per-bullet complete event bound? %u"), AmmoSysComp->PerBulletCompleteEvent.IsBound());
 
 		
-		// Per-bullet instant cancel delegate (for reload cancel animation to be triggered)
-		if (AmmoSysComp->PerBulletInstantCancelDelegate.IsBound()) {
-
-			AmmoSysComp->PerBulletInstantCancelDelegate.RemoveDynamic(this, &USCrosshair::K2_OnPerBulletCancelledInstant);
-				
-		}
-		UE_LOG(LogTemp, Log, TEXT("previous per-bullet instant cancel delegate bound? %u"), AmmoSysComp->PerBulletInstantCancelDelegate.IsBound());
+		// Per-bullet instant cancel event (for reload cancel animation to be triggered)
+		AmmoSysComp->PerBulletInstantCancelEvent.RemoveAll(this);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("previous per-bullet instant cancel event bound? %u"), AmmoSysComp->PerBulletInstantCancelEvent.IsBound());
 		
 	}
 	
@@ -307,86 +252,86 @@ void USCrosshair::BindReloadDelegates(USAmmoSystemComponent* AmmoSysComp) {
 }
 
 
-// Auxiliary function for binding all passive reload system delegates
+// Auxiliary function for binding all passive reload system events
 void USCrosshair::BindPassiveReloadDelegates(USAmmoSystemComponent* AmmoSysComp) {
 
 	if (AmmoSysComp) {
 		
-		// Bullets added delegate (for +1 pop-up once bullets-in)
-		AmmoSysComp->BulletsAddedDelegate.AddDynamic(this, &USCrosshair::K2_OnBulletsAdded);
-		UE_LOG(LogTemp, Log, TEXT("current bullets added delegate bound? %u"), AmmoSysComp->BulletsAddedDelegate.IsBound());
+		// Bullets added event (for +1 pop-up once bullets-in)
+		AmmoSysComp->BulletsAddedEvent.AddUObject(this, &USCrosshair::K2_OnBulletsAdded);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current bullets added event bound? %u"), AmmoSysComp->BulletsAddedEvent.IsBound());
 	
-		// Passive start delegate (for initial delay animation and successive bullets-in)
-		AmmoSysComp->PassiveStartDelegate.AddDynamic(this, &USCrosshair::USCrosshair::K2_OnPassiveReloadStarted);
-		UE_LOG(LogTemp, Log, TEXT("current passive start delegate bound? %u"), AmmoSysComp->PassiveStartDelegate.IsBound());
+		// Passive start event (for initial delay animation and successive bullets-in)
+		AmmoSysComp->PassiveStartEvent.AddUObject(this, &USCrosshair::K2_OnPassiveReloadStarted);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current passive start event bound? %u"), AmmoSysComp->PassiveStartEvent.IsBound());
 
-		// Passive reload cycle start delegate (looping section)
-		AmmoSysComp->PassiveReloadCycleStartDelegate.AddDynamic(this, &USCrosshair::K2_OnPassiveReloadCycleStarted);
-		UE_LOG(LogTemp, Log, TEXT("current passive reload cycle start delegate bound? %u"), AmmoSysComp->PassiveReloadCycleStartDelegate.IsBound());
+		// Passive reload cycle start event (looping section)
+		AmmoSysComp->PassiveReloadCycleStartEvent.AddUObject(this, &USCrosshair::K2_OnPassiveReloadCycleStarted);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current passive reload cycle start event bound? %u"), AmmoSysComp->PassiveReloadCycleStartEvent.IsBound());
 		
-		// Passive cancel delegate (for reload cancel animation to be triggered)
-		AmmoSysComp->PassiveCancelDelegate.AddDynamic(this, &USCrosshair::K2_OnPassiveReloadCancelled);
-		UE_LOG(LogTemp, Log, TEXT("current passive cancel delegate bound? %u"), AmmoSysComp->PassiveCancelDelegate.IsBound());
+		// Passive cancel event (for reload cancel animation to be triggered)
+		AmmoSysComp->PassiveCancelEvent.AddUObject(this, &USCrosshair::K2_OnPassiveReloadCancelled);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current passive cancel event bound? %u"), AmmoSysComp->PassiveCancelEvent.IsBound());
 		
 	}
 	
 }
 
 
-// Auxiliary function for binding all magazine reload system delegates
+// Auxiliary function for binding all magazine reload system events
 void USCrosshair::BindMagazineReloadDelegates(USAmmoSystemComponent* AmmoSysComp) {
 
 	if (AmmoSysComp) {
 		
-		// Magazine start delegate (start of bullets-in animation)
-		AmmoSysComp->MagazineStartDelegate.AddDynamic(this, &USCrosshair::K2_OnMagazineReloadStarted);	
-		UE_LOG(LogTemp, Log, TEXT("current magazine start delegate bound? %u"), AmmoSysComp->MagazineStartDelegate.IsBound());
+		// Magazine start event (start of bullets-in animation)
+		AmmoSysComp->MagazineStartEvent.AddUObject(this, &USCrosshair::K2_OnMagazineReloadStarted);	
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current magazine start event bound? %u"), AmmoSysComp->MagazineStartEvent.IsBound());
 	
-		// Magazine bullets-in delegate (start of wind-down animation)
-		AmmoSysComp->MagazineBulletsInDelegate.AddDynamic(this, &USCrosshair::K2_OnMagazineReloadBulletsIn);
-		UE_LOG(LogTemp, Log, TEXT("current magazine bullets-in delegate bound? %u"), AmmoSysComp->MagazineBulletsInDelegate.IsBound());
+		// Magazine bullets-in event (start of wind-down animation)
+		AmmoSysComp->MagazineBulletsInEvent.AddUObject(this, &USCrosshair::K2_OnMagazineReloadBulletsIn);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current magazine bullets-in event bound? %u"), AmmoSysComp->MagazineBulletsInEvent.IsBound());
 	
-		// Magazine complete delegate (start of fade-out animation)
-		AmmoSysComp->MagazineCompleteDelegate.AddDynamic(this, &USCrosshair::K2_OnMagazineReloadComplete);
-		UE_LOG(LogTemp, Log, TEXT("current magazine complete delegate bound? %u"), AmmoSysComp->MagazineCompleteDelegate.IsBound());
+		// Magazine complete event (start of fade-out animation)
+		AmmoSysComp->MagazineCompleteEvent.AddUObject(this, &USCrosshair::K2_OnMagazineReloadComplete);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current magazine complete event bound? %u"), AmmoSysComp->MagazineCompleteEvent.IsBound());
 	
-		// Magazine cancel delegate (for reload cancel animation to be triggered)
-		AmmoSysComp->MagazineCancelDelegate.AddDynamic(this, &USCrosshair::K2_OnMagazineReloadCancelled);
-		UE_LOG(LogTemp, Log, TEXT("current magazine cancel delegate bound? %u"), AmmoSysComp->MagazineCancelDelegate.IsBound());
+		// Magazine cancel event (for reload cancel animation to be triggered)
+		AmmoSysComp->MagazineCancelEvent.AddUObject(this, &USCrosshair::K2_OnMagazineReloadCancelled);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current magazine cancel event bound? %u"), AmmoSysComp->MagazineCancelEvent.IsBound());
 		
 	}
 	
 }
 
 
-// Auxiliary function for binding all per-bullet reload system delegates
+// Auxiliary function for binding all per-bullet reload system events
 void USCrosshair::BindPerBulletReloadDelegates(USAmmoSystemComponent* AmmoSysComp) {
 
 	if (AmmoSysComp) {
 		
-		// Bullets added delegate (for +x pop-up once bullets-in)
-		AmmoSysComp->BulletsAddedDelegate.AddDynamic(this, &USCrosshair::K2_OnBulletsAdded);
-		UE_LOG(LogTemp, Log, TEXT("current bullets added delegate bound? %u"), AmmoSysComp->BulletsAddedDelegate.IsBound());
+		// Bullets added event (for +x pop-up once bullets-in)
+		AmmoSysComp->BulletsAddedEvent.AddUObject(this, &USCrosshair::K2_OnBulletsAdded);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current bullets added event bound? %u"), AmmoSysComp->BulletsAddedEvent.IsBound());
 
-		// Per-bullet start delegate (start of readying-up animation)
-		AmmoSysComp->PerBulletStartDelegate.AddDynamic(this, &USCrosshair::K2_OnPerBulletReloadStarted);
-		UE_LOG(LogTemp, Log, TEXT("current per-bullet start delegate bound? %u"), AmmoSysComp->PerBulletStartDelegate.IsBound());
+		// Per-bullet start event (start of readying-up animation)
+		AmmoSysComp->PerBulletStartEvent.AddUObject(this, &USCrosshair::K2_OnPerBulletReloadStarted);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current per-bullet start event bound? %u"), AmmoSysComp->PerBulletStartEvent.IsBound());
 
-		// Per-bullet reload cycle start delegate (looping section)
-		AmmoSysComp->PerBulletReloadCycleStartDelegate.AddDynamic(this, &USCrosshair::K2_OnPerBulletReloadCycleStarted);
-		UE_LOG(LogTemp, Log, TEXT("current per-bullet reload cycle start delegate bound? %u"), AmmoSysComp->PerBulletReloadCycleStartDelegate.IsBound());
+		// Per-bullet reload cycle start event (looping section)
+		AmmoSysComp->PerBulletReloadCycleStartEvent.AddUObject(this, &USCrosshair::K2_OnPerBulletReloadCycleStarted);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current per-bullet reload cycle start event bound? %u"), AmmoSysComp->PerBulletReloadCycleStartEvent.IsBound());
 		
-		// Per-bullet timed cancel delegate (start of wind-down animation)
-		AmmoSysComp->PerBulletTimedCancelDelegate.AddDynamic(this, &USCrosshair::K2_OnPerBulletCancelledWithTime);
-		UE_LOG(LogTemp, Log, TEXT("current per-bullet timed cancel delegate bound? %u"), AmmoSysComp->PerBulletTimedCancelDelegate.IsBound());
+		// Per-bullet timed cancel event (start of wind-down animation)
+		AmmoSysComp->PerBulletTimedCancelEvent.AddUObject(this, &USCrosshair::K2_OnPerBulletCancelledWithTime);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current per-bullet timed cancel event bound? %u"), AmmoSysComp->PerBulletTimedCancelEvent.IsBound());
 
-		// Per-bullet complete delegate (successful timed cancel)
-		AmmoSysComp->PerBulletCompleteDelegate.AddDynamic(this, &USCrosshair::K2_OnPerBulletComplete);
-		UE_LOG(LogTemp, Log, TEXT("current per-bullet complete delegate bound? %u"), AmmoSysComp->PerBulletCompleteDelegate.IsBound());
+		// Per-bullet complete event (successful timed cancel)
+		AmmoSysComp->PerBulletCompleteEvent.AddUObject(this, &USCrosshair::K2_OnPerBulletComplete);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current per-bullet complete event bound? %u"), AmmoSysComp->PerBulletCompleteEvent.IsBound());
 		
-		// Per-bullet instant cancel delegate (for reload cancel animation to be triggered)
-		AmmoSysComp->PerBulletInstantCancelDelegate.AddDynamic(this, &USCrosshair::K2_OnPerBulletCancelledInstant);
-		UE_LOG(LogTemp, Log, TEXT("current per-bullet instant cancel delegate bound? %u"), AmmoSysComp->PerBulletInstantCancelDelegate.IsBound());
+		// Per-bullet instant cancel event (for reload cancel animation to be triggered)
+		AmmoSysComp->PerBulletInstantCancelEvent.AddUObject(this, &USCrosshair::K2_OnPerBulletCancelledInstant);
+		UE_LOG(LogCoopHUD, Verbose, TEXT("current per-bullet instant cancel event bound? %u"), AmmoSysComp->PerBulletInstantCancelEvent.IsBound());
 		
 	}
 	
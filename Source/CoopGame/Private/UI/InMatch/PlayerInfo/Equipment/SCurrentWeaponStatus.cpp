@@ -7,10 +7,23 @@
 #include "Gameplay/Weapons/Components/SAmmoSystemComponent.h"
 #include "Components/TextBlock.h"
 #include "Components/TextWidgetTypes.h"
+#include "General/SLogCategories.h"
 
 
 
 
+// First operations upon construction
+void USCurrentWeaponStatus::NativeConstruct() {
+
+	Super::NativeConstruct();
+
+	// Nothing displayed yet
+	DisplayedBulletsCurrentlyActive = MIN_int32;
+	DisplayedAvailableReloads = MIN_int32;
+
+}
+
+
 // 
 void USCurrentWeaponStatus::OnWeaponChange(ASWeapon* oldCurrentWeapon, ASWeapon* newCurrentWeapon) {
 
@@ -21,13 +34,9 @@ void USCurrentWeaponStatus::OnWeaponChange(ASWeapon* oldCurrentWeapon, ASWeapon*
 		// Unbind ammo system delegates if weapon is a shooting weapon (has an ammo system component)
 		if (PreviousWeapon && PreviousWeapon->AmmoSysComp) {
 
-			if (PreviousWeapon->AmmoSysComp->AmmoChangedDelegate.IsBound()) {
-				
-				PreviousWeapon->AmmoSysComp->AmmoChangedDelegate.RemoveDynamic(this, &USCurrentWeaponStatus::OnAmmoChanged);
-				
-			}
+			PreviousWeapon->AmmoSysComp->AmmoChangedEvent.RemoveAll(this);
 
-			UE_LOG(LogTemp, Log, TEXT("previous weapon ammo change delegate bound? %u"), PreviousWeapon->AmmoSysComp->AmmoChangedDelegate.IsBound());
+			UE_LOG(LogCoopHUD, Verbose, TEXT("previous weapon ammo change event bound? %u"), PreviousWeapon->AmmoSysComp->AmmoChangedEvent.IsBound());
 			
 		}
 		
@@ -52,9 +61,9 @@ void USCurrentWeaponStatus::OnWeaponChange(ASWeapon* oldCurrentWeapon, ASWeapon*
 				
 			}
 
-			// Bind ammo system delegates
-			CurrentWeapon->AmmoSysComp->AmmoChangedDelegate.AddDynamic(this, &USCurrentWeaponStatus::OnAmmoChanged);
-			UE_LOG(LogTemp, Log, TEXT("current weapon ammo change delegate bound? %u"), CurrentWeapon->AmmoSysComp->AmmoChangedDelegate.IsBound());
+			// Bind ammo system events
+			CurrentWeapon->AmmoSysComp->AmmoChangedEvent.AddUObject(this, &USCurrentWeaponStatus::OnAmmoChanged);
+			UE_LOG(LogCoopHUD, Verbose, TEXT("current weapon ammo change event bound? %u"), CurrentWeapon->AmmoSysComp->AmmoChangedEvent.IsBound());
 			
 		}
 		// else, use N/A values for everything
@@ -74,13 +83,16 @@ void USCurrentWeaponStatus::OnWeaponChange(ASWeapon* oldCurrentWeapon, ASWeapon*
 // Function that updates the values for the bullets available and the reloads available after changes are performed to the ammo quantity, be it removals or additions aka reloading (to be rebound at weapon switch) 
 void USCurrentWeaponStatus::OnAmmoChanged(int32 newBulletsCurrentlyActive, int32 newAvailableReloads) {
 
-	if (AvailableBullets) {
+	if (AvailableBullets && newBulletsCurrentlyActive != DisplayedBulletsCurrentlyActive) {
 		
 		AvailableBullets->SetText(FText::AsNumber(newBulletsCurrentlyActive));
+		DisplayedBulletsCurrentlyActive = newBulletsCurrentlyActive;
 		
 	}
 
-	if (AvailableReloads) {
+	if (AvailableReloads && newAvailableReloads != DisplayedAvailableReloads) {
+
+		DisplayedAvailableReloads = newAvailableReloads;
 		
 		if (newAvailableReloads >= 0) {
 			
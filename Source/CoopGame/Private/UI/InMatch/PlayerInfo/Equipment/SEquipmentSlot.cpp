@@ -25,7 +25,7 @@ void USEquipmentSlot::Construct(FSEquipmentInfoHUD EquipmentInfo) {
 		WeaponShortName->SetText(FText::FromName(EquipmentInfo.EquipmentShortName));
 
 		// check if the slot is valid for a weapon (if weapon, show number)
-		if (EquipmentInfo.EquipmentSlot > 0 && EquipmentInfo.EquipmentSlot <= 3) {
+		if (EquipmentInfo.EquipmentSlot > 0) {
 		
 			WeaponSlotNumber->SetVisibility(ESlateVisibility::Visible);
 			WeaponSlotNumber->SetText(FText::AsNumber(EquipmentInfo.EquipmentSlot));
@@ -4,28 +4,28 @@
 #include "UI/InMatch/PlayerInfo/Equipment/SPlayerLoadout.h"
 #include "UI/InMatch/PlayerInfo/Equipment/SEquipmentSlot.h"
 #include "Gameplay/Weapons/Helpers/WeaponUtilities.h"
+#include "General/SLogCategories.h"
 
 
 
 // Information for the initial setup of the player loadout visualisation
 void USPlayerLoadout::OnLoadoutSpawned(FLoadoutInfo LoadoutInfo, uint8 InitialActiveWeaponSlotNumber) {
 
-	if (WeaponSlot1) {
-		
-		WeaponSlot1->Construct(LoadoutInfo.Weapon1Info);
-		
-	}
+	// Slots without a widget aren't displayed, widgets without a slot are disabled
+	for (int32 SlotIndex = 0; SlotIndex < WeaponSlotWidgets.Num(); ++SlotIndex) {
 
-	if (WeaponSlot2) {
-		
-		WeaponSlot2->Construct(LoadoutInfo.Weapon2Info);
+		if (WeaponSlotWidgets[SlotIndex]) {
+
+			WeaponSlotWidgets[SlotIndex]->Construct(LoadoutInfo.WeaponInfos.IsValidIndex(SlotIndex) ? LoadoutInfo.WeaponInfos[SlotIndex] : FSEquipmentInfoHUD());
+
+		}
 		
 	}
-	
-	if (WeaponSlot3) {
-		
-		WeaponSlot3->Construct(LoadoutInfo.Weapon3Info);
-		
+
+	if (LoadoutInfo.WeaponInfos.Num() > WeaponSlotWidgets.Num()) {
+
+		UE_LOG(LogCoopHUD, Warning, TEXT("Loadout has %d weapon slots but only %d are displayed"), LoadoutInfo.WeaponInfos.Num(), WeaponSlotWidgets.Num());
+
 	}
 	
 	if (SkillSlot) {
@@ -34,25 +34,17 @@ void USPlayerLoadout::OnLoadoutSpawned(FLoadoutInfo LoadoutInfo, uint8 InitialAc
 		
 	}
 	
-	UE_LOG(LogTemp, Log, TEXT("Initial active weapon is %u"), InitialActiveWeaponSlotNumber);
-	switch (InitialActiveWeaponSlotNumber) {
+	UE_LOG(LogCoopHUD, Verbose, TEXT("Initial active weapon is %u"), InitialActiveWeaponSlotNumber);
 
-	case 1:
-		ActivateWeaponSlot1();
-		break;
-		
-	case 2:
-		ActivateWeaponSlot2();
-		break;
-		
-	case 3:
-		ActivateWeaponSlot3();
-		break;
+	if (InitialActiveWeaponSlotNumber > 0 && InitialActiveWeaponSlotNumber <= WeaponSlotWidgets.Num()) {
+
+		ActivateWeaponSlot(InitialActiveWeaponSlotNumber);
 		
-	default:
+	}
+	else {
+
 		// I seriously hope this doesn't happen
-		UE_LOG(LogTemp, Warning, TEXT("Invalid initially active weapon number used for HUD construction"));
-		break;
+		UE_LOG(LogCoopHUD, Warning, TEXT("Invalid initially active weapon number used for HUD construction"));
 		
 	}
 	
@@ -62,103 +54,65 @@ void USPlayerLoadout::OnLoadoutSpawned(FLoadoutInfo LoadoutInfo, uint8 InitialAc
 
 void USPlayerLoadout::OnWeaponChange(uint8 newSlot) {
 
-	UE_LOG(LogTemp, Log, TEXT("USPlayerLoadout::OnWeaponChange called by delegate!"));
-	
-	switch (newSlot) {
+	UE_LOG(LogCoopHUD, Verbose, TEXT("USPlayerLoadout::OnWeaponChange called by delegate!"));
 
-		case 1:
-		ActivateWeaponSlot1();
-		break;
-		
-	case 2:
-		ActivateWeaponSlot2();
-		break;
-		
-	case 3:
-		ActivateWeaponSlot3();
-		break;
-		
-	default:
-		// do nothing, invalid value
-		break;
-		
-	}
+	// invalid values are ignored when looking up the slot
+	ActivateWeaponSlot(newSlot);
 
 }
 
 
-// Highlight weapon slot number 1
-void USPlayerLoadout::ActivateWeaponSlot1() {
+// Highlight the weapon slot with the given number (1 is the first slot)
+void USPlayerLoadout::ActivateWeaponSlot(uint8 SlotNumber) {
 
 	uint8 PreviousSlotNumber = 0;
 	uint8 NewSlotNumber = 0;
+
+	const int32 SlotIndex = static_cast<int32>(SlotNumber) - 1;
+	USEquipmentSlot* NewActiveSlot = WeaponSlotWidgets.IsValidIndex(SlotIndex) ? WeaponSlotWidgets[SlotIndex] : nullptr;
 	
-	if (ActiveWeaponSlot) {
+	if (NewActiveSlot) {
 
-		PreviousSlotNumber = ActiveWeaponSlot->GetSlotNumber();
-		ActiveWeaponSlot->K2_DeactivateSlot();
+		if (ActiveWeaponSlot) {
+
+			PreviousSlotNumber = ActiveWeaponSlot->GetSlotNumber();
+			ActiveWeaponSlot->K2_DeactivateSlot();
 		
-	}
-	if (WeaponSlot1) {
+		}
 
-		NewSlotNumber = WeaponSlot1->GetSlotNumber();
-		WeaponSlot1->K2_ActivateSlot();
-		ActiveWeaponSlot = WeaponSlot1;
+		NewSlotNumber = NewActiveSlot->GetSlotNumber();
+		NewActiveSlot->K2_ActivateSlot();
+		ActiveWeaponSlot = NewActiveSlot;
 		
 	}
 	
-	UE_LOG(LogTemp, Log, TEXT("Executing change from slot %u to slot %u"), PreviousSlotNumber, NewSlotNumber);
+	UE_LOG(LogCoopHUD, Verbose, TEXT("Executing change from slot %u to slot %u"), PreviousSlotNumber, NewSlotNumber);
     
 }
 
 
-// Highlight weapon slot number 2
-void USPlayerLoadout::ActivateWeaponSlot2() {
+// Gathers the weapon slot widgets bound by the child BP class, in slot order
+void USPlayerLoadout::NativeOnInitialized() {
 
-	uint8 PreviousSlotNumber = 0;
-	uint8 NewSlotNumber = 0;
-	
-	if (ActiveWeaponSlot) {
+	Super::NativeOnInitialized();
 
-		PreviousSlotNumber = ActiveWeaponSlot->GetSlotNumber();
-		ActiveWeaponSlot->K2_DeactivateSlot();
-		
-	}
-	if (WeaponSlot2) {
+	// Only the leading slots bound in the child BP class are used (a slot can't be displayed without the ones before it)
+	USEquipmentSlot* const BoundSlots[] = { WeaponSlot1, WeaponSlot2, WeaponSlot3, WeaponSlot4, WeaponSlot5 };
 
-		NewSlotNumber = WeaponSlot2->GetSlotNumber();
-		WeaponSlot2->K2_ActivateSlot();
-		ActiveWeaponSlot = WeaponSlot2;
-		
-	}
-	
-	UE_LOG(LogTemp, Log, TEXT("Executing change from slot %u to slot %u"), PreviousSlotNumber, NewSlotNumber);
-    
-}
+	WeaponSlotWidgets.Reset();
 
+	for (USEquipmentSlot* BoundSlot : BoundSlots) {
 
-// Highlight weapon slot number 3
-void USPlayerLoadout::ActivateWeaponSlot3() {
+		if (!BoundSlot) {
 
-	uint8 PreviousSlotNumber = 0;
-	uint8 NewSlotNumber = 0;
-	
-	if (ActiveWeaponSlot) {
+			break;
 
-		PreviousSlotNumber = ActiveWeaponSlot->GetSlotNumber();
-		ActiveWeaponSlot->K2_DeactivateSlot();
-		
-	}
-	if (WeaponSlot3) {
+		}
+
+		WeaponSlotWidgets.Add(BoundSlot);
 
-		NewSlotNumber = WeaponSlot3->GetSlotNumber();
-		WeaponSlot3->K2_ActivateSlot();
-		ActiveWeaponSlot = WeaponSlot3;
-		
 	}
-	
-	UE_LOG(LogTemp, Log, TEXT("Executing change from slot %u to slot %u"), PreviousSlotNumber, NewSlotNumber);
-	
+
 }
 
 
@@ -168,7 +122,7 @@ void USPlayerLoadout::ActivateSkillSlot() {
 	if (SkillSlot) {
 		
 		SkillSlot->K2_ActivateSlot();
-		UE_LOG(LogTemp, Log, TEXT("Activating Skill UI slot"));
+		UE_LOG(LogCoopHUD, Verbose, TEXT("Activating Skill UI slot"));
 		
 	}
 
@@ -183,7 +137,7 @@ void USPlayerLoadout::DeactivateSkillSlot() {
 	if (SkillSlot) {
 		
 		SkillSlot->K2_DeactivateSlot();
-		UE_LOG(LogTemp, Log, TEXT("Deactivating Skill UI slot"));
+		UE_LOG(LogCoopHUD, Verbose, TEXT("Deactivating Skill UI slot"));
 		
 	}
     
@@ -191,21 +145,9 @@ void USPlayerLoadout::DeactivateSkillSlot() {
 
 void USPlayerLoadout::OnPlayerDeath(float DeathAnimTime) {
 
-	if (WeaponSlot1) {
-		
-		WeaponSlot1->K2_OnPlayerDeath(DeathAnimTime);
-		
-	}
-
-	if (WeaponSlot2) {
-		
-		WeaponSlot2->K2_OnPlayerDeath(DeathAnimTime);
-		
-	}
-	
-	if (WeaponSlot3) {
+	for (USEquipmentSlot* WeaponSlot : WeaponSlotWidgets) {
 		
-		WeaponSlot3->K2_OnPlayerDeath(DeathAnimTime);
+		WeaponSlot->K2_OnPlayerDeath(DeathAnimTime);
 		
 	}
 	
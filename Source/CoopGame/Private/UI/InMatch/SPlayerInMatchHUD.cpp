@@ -11,6 +11,7 @@
 #include "UI/InMatch/PlayerInfo/Equipment/SPlayerLoadout.h"
 #include "UI/InMatch/PlayerInfo/Equipment/SCurrentWeaponStatus.h"
 #include "UI/InMatch/PlayerInfo/Crosshair/SCrosshair.h"
+#include "General/SLogCategories.h"
 
 // Sets default values for this HUD's parameters
 ASPlayerInMatchHUD::ASPlayerInMatchHUD() {
@@ -103,7 +104,7 @@ void ASPlayerInMatchHUD::OnLoadoutSpawned(FLoadoutInfo LoadoutInfo, ASWeapon* Cu
 		
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("ASPlayerInMatchHUD::OnLoadoutSpawned called by delegate!"));
+	UE_LOG(LogCoopHUD, Verbose, TEXT("ASPlayerInMatchHUD::OnLoadoutSpawned called by delegate!"));
 	
 }
 
@@ -128,7 +129,7 @@ void ASPlayerInMatchHUD::OnWeaponChange(ASWeapon* oldCurrentWeapon, ASWeapon* ne
 		
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("ASPlayerInMatchHUD::OnWeaponChange called by delegate!"));
+	UE_LOG(LogCoopHUD, Verbose, TEXT("ASPlayerInMatchHUD::OnWeaponChange called by delegate!"));
 	
 }
 
@@ -152,6 +153,6 @@ void ASPlayerInMatchHUD::OnOwningCharacterDeath() {
 		
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("ASPlayerInMatchHUD::OnOwningCharacterDeath called by delegate!"));
+	UE_LOG(LogCoopHUD, Verbose, TEXT("ASPlayerInMatchHUD::OnOwningCharacterDeath called by delegate!"));
 	
 }
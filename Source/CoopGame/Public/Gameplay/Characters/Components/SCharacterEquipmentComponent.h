@@ -13,6 +13,8 @@
 
 class ASPlayerCharacter;
 class ASWeapon;
+struct FSAmmoSnapshot;
+struct FStreamableHandle;
 
 
 
@@ -26,7 +28,15 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnWeaponChangeSignature, ASWeapo
 
 /*
  *
- * todo documentation
+ * Component that holds the character's loadout and forwards the weapon actions to the currently active weapon.
+ * The weapons are kept in a compact array (no empty slots in between, index 0 is slot 1) of at most MaxWeaponSlots entries, so every kind of switch (to a slot, to the next/previous slot
+ * or back to the last weapon) resolves its target in constant time and goes through the same routine, ChangeToWeaponSlot().
+ * After every switch, the weapon most likely to be switched to next (the next one in the direction of the last scroll, the last weapon otherwise) is pre-warmed on the following frame: it is woken up
+ * from hibernation and its effects are set up, so switching to it is only a state flip. A weapon pre-warmed for a switch that didn't come goes back to sleep once the prediction moves on.
+ * The loadout is spawned by the server only and replicated: clients set the weapons up as they arrive (see OnRep_WeaponSlots), the owning client switches weapons right away and tells the server,
+ * and the other clients follow the current slot replicated by the server.
+ * The weapons outlive the character: when it dies they are stowed (detached and hibernating) by its player controller, and the player's next character takes them over with a fresh ammo state
+ * instead of spawning a new loadout (see StowLoadout/EquipStowedLoadout).
  *
  */
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
@@ -39,17 +49,38 @@ public:
 	// Sets default values for this component's properties
 	USCharacterEquipmentComponent();
 
-	// Spawns the configured loadout for the character and delegates its addition to the loadout
+	// Spawns the configured loadout for the character and delegates its addition to the loadout; the weapon classes are loaded asynchronously and the weapons are spawned over several frames, the first one as soon as it's loaded (server only, clients receive the loadout through replication; does nothing if the character already has a loadout)
 	void SpawnDefaultLoadout();
+
+	// Hands the weapons of the loadout over to the given new owner, in slot order, deactivated and detached from the character, and empties the loadout so they can outlive it (server only)
+	void StowLoadout(AActor* NewOwner, TArray<ASWeapon*>& OutWeapons);
+
+	// Takes over the weapons stowed from a previous character instead of spawning the default loadout: attaches them to this character, equips the first one and starts all of them on a fresh ammo state; returns false if none could be equipped (server only, only if the character has no loadout yet)
+	bool EquipStowedLoadout(const TArray<ASWeapon*>& Weapons);
+
+	// Called every frame while the loadout is being spawned or a pre-warm is pending; spawns one weapon per frame, in slot order, then pre-warms the predicted weapon
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	
-	// Deactivate the current weapon and change the currently active weapon to the weapon in slot 1
-	bool ChangeToWeapon1(void);
+	// Deactivate the current weapon and change the currently active weapon to the weapon in the given slot (index 0 is slot 1)
+	bool ChangeToWeaponSlot(int32 SlotIndex);
+
+	// Deactivate the current weapon and change the currently active weapon to the weapon in the next slot, wrapping around
+	bool ChangeToNextWeapon(void);
+
+	// Deactivate the current weapon and change the currently active weapon to the weapon in the previous slot, wrapping around
+	bool ChangeToPreviousWeapon(void);
+
+	// Deactivate the current weapon and change the currently active weapon back to the one that was active before it
+	bool ChangeToLastWeapon(void);
 
-	// Deactivate the current weapon and change the currently active weapon to the weapon in slot 2
-	bool ChangeToWeapon2(void);
+	// Returns the maximum number of weapons in the loadout
+	int32 GetMaxWeaponSlots(void) const;
 
-	// Deactivate the current weapon and change the currently active weapon to the weapon in slot 3
-	bool ChangeToWeapon3(void);
+	// Returns the weapon in the given slot (index 0 is slot 1), nullptr if there is none
+	ASWeapon* GetWeaponInSlot(int32 SlotIndex) const;
+
+	// Returns the slot of the currently active weapon, INDEX_NONE if there is none
+	int32 GetCurrentSlotIndex(void) const;
 
 	// Execute the pressing action of the currently active weapon's primary action
 	void PerformCurrentWeaponPrimaryActionPress(void);
@@ -66,6 +97,15 @@ public:
 	// Request a reload to the current weapon
 	void ReloadCurrentWeapon(void);
 
+	// Registers the replicated loadout and current slot (pushed when dirty)
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// Takes a snapshot of the ammo state of every slot (index 0 is slot 1), empty snapshots for empty slots or weapons without ammo
+	void CaptureLoadoutAmmo(TArray<FSAmmoSnapshot>& OutSnapshots);
+
+	// Restores the ammo state of every slot from snapshots taken with CaptureLoadoutAmmo(); returns false if any of them didn't fit its slot's weapon
+	bool RestoreLoadoutAmmo(const TArray<FSAmmoSnapshot>& Snapshots);
+
 	// Delegate to broadcast of successful loadout spawn
 	FOnLoadoutSpawnedSignature LoadoutSpawnDelegate;
 	
@@ -76,22 +116,25 @@ public:
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+
+	// Called when the component is removed from play; drops any loadout still being loaded, and destroys the weapons still in the loadout along with the character (server only)
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	// Currently active weapon
 	UPROPERTY(BlueprintReadOnly, Category = "Loadout")
 	ASWeapon* CurrentWeapon;
 	
-	// Class of weapon in Slot 1
-	UPROPERTY(BlueprintReadOnly, Category = "Loadout")
-	ASWeapon* WeaponInSlot1;
-	
-	// Class of weapon in Slot 2
-	UPROPERTY(BlueprintReadOnly, Category = "Loadout")
-	ASWeapon* WeaponInSlot2;
+	// Weapons in the loadout, one per slot (index 0 is slot 1), with no empty slots in between
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_WeaponSlots, Category = "Loadout")
+	TArray<ASWeapon*> WeaponSlots;
 
-	// Class of weapon in Slot 3
-	UPROPERTY(BlueprintReadOnly, Category = "Loadout")
-	ASWeapon* WeaponInSlot3;
+	// Maximum number of weapons in the loadout
+	UPROPERTY(EditDefaultsOnly, Category = "Loadout", meta = (ClampMin = 1, ClampMax = 9))
+	uint8 MaxWeaponSlots;
+
+	// Whether the weapon most likely to be switched to next is kept ready for an instant switch
+	UPROPERTY(EditDefaultsOnly, Category = "Loadout")
+	bool bPrewarmPredictedWeapon;
 
 	
 private:
@@ -110,9 +153,100 @@ private:
 
 	// Creates a temporary object that holds all information relative to the player loadout necessary for the HUD
 	FLoadoutInfo CreateLoadoutInfo() const;
+
+	// Spawns the weapon of the next DefaultWeapons entry and adds it to the loadout (the first one is equipped), finishing the loadout after the last one
+	void SpawnNextLoadoutWeapon();
+
+	// Called once the classes of the weapons after the first one are in memory; starts spawning them, one per frame
+	void OnLoadoutClassesLoaded();
+
+	// Ends the loadout spawn: broadcasts the loadout and the current weapon for the HUD, and starts pre-warming
+	void FinishLoadoutSpawn();
+
+	// Stops a loadout spawn still underway, dropping the classes still being loaded
+	void CancelLoadoutSpawn(void);
+
+	// Returns true if the character has weapons or some are being spawned
+	bool HasLoadout(void) const;
+
+	// Deactivates a weapon leaving the loadout and detaches it from the character
+	void ReleaseWeapon(ASWeapon* Weapon);
+
+	// Forgets the current, last and pre-warmed slots, once the loadout has been emptied
+	void ResetSlotTracking(void);
+
+	// Asks for the predicted weapon to be pre-warmed on the next frame, keeping the switch frame free of it
+	void RequestPrewarm(void);
+
+	// Returns the slot most likely to be switched to next: the next one in the direction of the last scroll, the last weapon otherwise; INDEX_NONE if there is no other weapon
+	int32 PredictNextSlot(void) const;
+
+	// Pre-warms the weapon in the predicted slot, and puts the one pre-warmed before it back to sleep if the prediction changed
+	void PrewarmPredictedWeapon(void);
+
+	// Replication
+
+	// Copies the current slot into its replicated counterpart and marks it dirty if it changed (server only)
+	void UpdateReplicatedSlotIndex(void);
+
+	// Lets go of the weapons that left the loadout, sets up the ones that arrived from the server and broadcasts the loadout for the HUD once every slot has arrived (clients only)
+	UFUNCTION()
+	void OnRep_WeaponSlots(const TArray<ASWeapon*>& PreviousWeaponSlots);
+
+	// Switches to the current slot of the server (clients other than the owning one)
+	UFUNCTION()
+	void OnRep_ReplicatedSlotIndex(void);
+
+	// Attaches the weapons that arrived from the server to the character and equips the server's current weapon if this client follows it; returns true if every slot has arrived (clients only)
+	bool ApplyReplicatedLoadout(void);
+
+	// Applies a weapon switch already made by the owning client, sending it back to the server's slot if the server can't follow
+	UFUNCTION(Server, Reliable)
+	void ServerChangeToWeaponSlot(int32 SlotIndex, int32 SwitchKey);
+
+	// Takes the owning client back to the server's current slot after the server refused one of its switches, unless the client made another switch since
+	UFUNCTION(Client, Reliable)
+	void ClientRestoreWeaponSlot(int32 SlotIndex, int32 SwitchKey);
 	
-	// Array containing the weapons to be used by the character (only the first 3 members will be taken into consideration)
+	// Array containing the weapons to be used by the character (only the first MaxWeaponSlots members will be taken into consideration), loaded when the loadout is spawned
 	UPROPERTY(EditAnywhere, Category = "Loadout")
-	TArray<TSubclassOf<ASWeapon>> DefaultWeapons;
+	TArray<TSoftClassPtr<ASWeapon>> DefaultWeapons;
+
+	// Streaming handles of the first weapon's class and of the classes of the rest of the loadout, kept while the loadout is being spawned
+	TSharedPtr<FStreamableHandle> FirstWeaponLoadHandle;
+	TSharedPtr<FStreamableHandle> LoadoutLoadHandle;
+
+	// Number of DefaultWeapons entries to spawn, and index of the next one
+	int32 NumLoadoutWeapons;
+	int32 NextLoadoutSpawnIndex;
+
+	// Whether the classes of the weapons after the first one are in memory
+	bool bLoadoutClassesLoaded;
+
+	// Whether the first weapon was spawned and equipped (the loadout is only broadcast if it was)
+	bool bLoadoutSpawnSuccess;
+
+	// Slot of the currently active weapon and of the one active before it, INDEX_NONE if there is none
+	int32 CurrentSlotIndex;
+	int32 LastSlotIndex;
+
+	// Direction of the last switch: 1 for next, -1 for previous, 0 for a switch to a given slot or to the last weapon
+	int32 LastSwitchDirection;
+
+	// Slot of the weapon currently pre-warmed, INDEX_NONE if there is none
+	int32 PrewarmedSlotIndex;
+
+	// Whether the predicted weapon is to be pre-warmed on the next frame
+	bool bPrewarmPending;
+
+	// Sequence number of the latest weapon switch sent to the server (owning client) or received from the owning client (server)
+	int32 LastSlotSwitchKey;
+
+	// Whether the switch being made was requested by the server, so it isn't sent back to it (owning client only)
+	bool bRestoringServerSlot;
+
+	// Slot of the currently active weapon on the server, replicated to the clients other than the owning one (which makes its own switches)
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedSlotIndex)
+	int32 ReplicatedSlotIndex;
 		
 };
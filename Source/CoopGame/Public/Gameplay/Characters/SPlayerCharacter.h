@@ -75,6 +75,9 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Called when a controller takes the character (server only); hands it the weapons of the player's previous character, or spawns its default loadout if there are none
+	virtual void PossessedBy(AController* NewController) override;
+
 	// Called when "Move Forward" or "Move Backward" keys are pressed; "Move Forward" -> Value = 1.0f, "Move Backward" -> Value = -1.0f
 	void MoveForward(float Value);
 
@@ -90,14 +93,17 @@ protected:
 	// Called when "Jump" key is pressed
 	virtual void Jump(void) override;
 
-	// Called when "WeaponSlot1" key is pressed
-	virtual void ChangetoWeaponSlot1(void);
+	// Called when one of the "WeaponSlotN" keys is pressed, with the index of its slot (index 0 is "WeaponSlot1")
+	virtual void ChangeToWeaponSlot(int32 SlotIndex);
+
+	// Called when "NextWeapon" key is pressed
+	virtual void ChangeToNextWeapon(void);
 
-	// Called when "WeaponSlot2" key is pressed
-	virtual void ChangetoWeaponSlot2(void);
+	// Called when "PreviousWeapon" key is pressed
+	virtual void ChangeToPreviousWeapon(void);
 
-	// Called when "WeaponSlot3" key is pressed
-	virtual void ChangetoWeaponSlot3(void);
+	// Called when "LastWeapon" key is pressed
+	virtual void ChangeToLastWeapon(void);
 	
 	// Called when "MousePrimaryAction" key is pressed
 	virtual void WeaponPrimaryActionPress(void);
@@ -114,15 +120,6 @@ protected:
 	// Called when "ReloadWeapon" is pressed
 	virtual void ReloadPressed(void);
 
-	// Called when "WeaponSlot1" is pressed
-	virtual void ChangeToWeaponSlot1(void);
-	
-	// Called when "WeaponSlot2" is pressed
-	virtual void ChangeToWeaponSlot2(void);
-	
-	// Called when "WeaponSlot3" is pressed
-	virtual void ChangeToWeaponSlot3(void);
-
 	// Called when a health change has been detected by the attribute component
 	UFUNCTION()
 	virtual void OnHPChanged(USAttributesComponent* AttrComp, float CurrentHP, float DeltaHP, const UDamageType* DamageType, AController* InstigatedBy, AActor* DamageCauser);
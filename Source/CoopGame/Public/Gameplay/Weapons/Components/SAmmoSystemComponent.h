@@ -5,10 +5,14 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Gameplay/Weapons/Helpers/WeaponUtilities.h"
+#include "Gameplay/Weapons/Helpers/AmmoCore.h"
+#include "General/SReloadTimingWheelSubsystem.h"
 #include "SAmmoSystemComponent.generated.h"
 
 
 
+// Blueprint delegates (only broadcast when something is bound to them, see the native events below for C++ listeners)
+
 // General delegates
 
 // Declaration of delegate type for broadcast of ammo and available reload values upon ammo consumption or successful reload
@@ -45,7 +49,6 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMagazineReloadCompleteSignature);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMagazineReloadCancelledSignature);
 
 
-// Per-bullet reload-specific delegates
 // Per-bullet reload-specific delegates
 
 // Declaration of delegate type for broadcast of start of per-bullet reload
@@ -65,6 +68,205 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPerBulletCancelledInstantSignature);
 
 
 
+// Native events (same events and parameters as the Blueprint delegates above, without going through reflection)
+
+// General events
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnAmmoChangedEvent, int32 /* newBulletsCurrentlyAvailable */, int32 /* newAvailableReloads */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBulletAddedEvent, uint8 /* NumBulletsAdded */);
+
+// Passive reload-specific events
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPassiveReloadStartedEvent, float /* FirstDelay */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPassiveReloadCycleStartedEvent, float /* BulletsInDelay */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPassiveReloadCancelledEvent, UReloadCancelTrigger /* CancelType */);
+
+// Magazine reload-specific events
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnMagazineReloadStartedEvent, float /* TimeToBulletsIn */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnMagazineReloadBulletsInEvent, float /* TimeToCompletion */);
+DECLARE_MULTICAST_DELEGATE(FOnMagazineReloadCompleteEvent);
+DECLARE_MULTICAST_DELEGATE(FOnMagazineReloadCancelledEvent);
+
+// Per-bullet reload-specific events
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPerBulletReloadStartedEvent, float /* FirstDelay */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPerBulletReloadCycleStartedEvent, float /* BulletsInDelay */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPerBulletCancelledWithTimeEvent, float /* TimeToCompletion */);
+DECLARE_MULTICAST_DELEGATE(FOnPerBulletReloadCompleteEvent);
+DECLARE_MULTICAST_DELEGATE(FOnPerBulletCancelledInstantEvent);
+
+
+
+class USAmmoSystemComponent;
+class USWeaponDefinition;
+
+
+
+/*
+ *
+ *	Point in time of the reload clock as sent over the network: the whole second it falls in, as a packed integer, plus a float offset from it below one second.
+ *	A float holding the absolute server time would lose precision as the match goes on (a millisecond is gone after a few hours), the offset keeps it the same all along
+ *
+ */
+USTRUCT()
+struct FSNetReloadTime {
+
+	GENERATED_USTRUCT_BODY()
+
+
+public:
+	FSNetReloadTime() {}
+
+	// Splits the given time of the reload clock into its whole second and the offset from it
+	explicit FSNetReloadTime(double Time);
+
+	// Returns the time of the reload clock this stands for
+	double ToTime(void) const;
+
+	// Custom serialization of the base second and offset
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	// Compares base second and offset
+	bool operator==(const FSNetReloadTime& Other) const;
+
+
+	// Whole second of the reload clock the time falls in, and offset from it (in [0, 1))
+	int32 BaseSecond = 0;
+	float Offset = 0.0f;
+
+};
+
+template<>
+struct TStructOpsTypeTraits<FSNetReloadTime> : public TStructOpsTypeTraitsBase2<FSNetReloadTime> {
+
+	enum {
+
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+
+	};
+
+};
+
+
+
+/*
+ *
+ *	Ammo state as replicated to the owning client: the whole FSAmmoState packed into a few bytes (bullets and counters as packed integers, phase and flags in one byte,
+ *	and the end of the current phase as a server timestamp only while reloading), so a change costs a handful of bytes instead of one RPC per event
+ *
+ */
+USTRUCT()
+struct FSReplicatedAmmoState {
+
+	GENERATED_USTRUCT_BODY()
+
+
+public:
+	// Copies the given ammo state into this one
+	void Pack(const FSAmmoState& State);
+
+	// Copies this state into the given ammo state
+	void Unpack(FSAmmoState& State) const;
+
+	// Custom serialization of the packed state
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	// Compares every packed value
+	bool operator==(const FSReplicatedAmmoState& Other) const;
+
+
+	// Last ammo action (shot, reload trigger or cancel) predicted by the owning client that the server has applied to this state
+	int32 LastAcknowledgedAmmoAction = 0;
+
+	// Bullets currently available, magazines and bullets used in this life, and reload cycles completed (per-bullet) or applied (passive) in the current reload
+	int32 BulletsCurrentlyActive = 0;
+	int32 MagazinesExpended = 0;
+	int32 BulletsExpended = 0;
+	int32 PerBulletReloadCycles = 0;
+	int32 PassiveCyclesApplied = 0;
+
+	// Reload phase and whether a timed cancel is underway
+	ESAmmoPhase Phase = ESAmmoPhase::Idle;
+	bool bReloadIsBeingCancelled = false;
+
+	// Server time at which the current phase ends (see FSAmmoState::PhaseTime), only sent while reloading
+	FSNetReloadTime PhaseTime;
+
+};
+
+template<>
+struct TStructOpsTypeTraits<FSReplicatedAmmoState> : public TStructOpsTypeTraitsBase2<FSReplicatedAmmoState> {
+
+	enum {
+
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+
+	};
+
+};
+
+
+
+// Serializes an ammo snapshot (checkpoint saves, per-player storage); phase and cancel flag share a byte
+inline FArchive& operator<<(FArchive& Ar, FSAmmoSnapshot& Snapshot) {
+
+	uint8 PhaseAndFlags = static_cast<uint8>(Snapshot.Phase) | (Snapshot.bReloadIsBeingCancelled ? (1 << 2) : 0);
+
+	Ar << Snapshot.ReloadType << PhaseAndFlags;
+	Ar << Snapshot.BulletsCurrentlyActive << Snapshot.MagazinesExpended << Snapshot.BulletsExpended;
+	Ar << Snapshot.PerBulletReloadCycles << Snapshot.PassiveCyclesApplied << Snapshot.PhaseTimeOffset;
+
+	if (Ar.IsLoading()) {
+
+		Snapshot.Phase = static_cast<ESAmmoPhase>(PhaseAndFlags & 0x3);
+		Snapshot.bReloadIsBeingCancelled = (PhaseAndFlags & (1 << 2)) != 0;
+
+	}
+
+	return Ar;
+
+}
+
+
+
+// Kind of ammo action predicted by the owning client
+enum class ESPredictedAmmoActionType : uint8 {
+
+	Consume,
+	Trigger,
+	Cancel
+
+};
+
+
+
+/*
+ *
+ *	Ammo consumption, reload trigger or reload cancel predicted by the owning client and not yet acknowledged by the server, kept so it can be replayed on top of the server's state
+ *
+ */
+struct FSPredictedAmmoAction {
+
+	// Sequence number of the action, acknowledged by the server through FSReplicatedAmmoState::LastAcknowledgedAmmoAction
+	int32 ActionKey = 0;
+
+	// What the action is
+	ESPredictedAmmoActionType Type = ESPredictedAmmoActionType::Consume;
+
+	// Parameters of the consumption
+	bool bCanBePartial = false;
+	uint8 NumToExpend = 0;
+
+	// Parameters of the trigger/cancel
+	bool bWeaponIsBusy = false;
+	UReloadCancelTrigger CancelType = UReloadCancelTrigger::Invalid;
+
+	// Time (on the server's clock) at which the action happened
+	double Time = 0.0;
+
+};
+
+
+
 /*
  *
  * Master class that handles all ammo and reload functionality with minimal exposure to the weapon. It supports three types of reload:
@@ -80,12 +282,24 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPerBulletCancelledInstantSignature);
  *			UpdateHUDInfo should be called in the containing class after any action that may or will certainly change the status of the ammo system (e.g.: reloading, firing weapon, player stun).
  *			ManageAmmoWhenUseRequested() should be called whenever an action that expends ammo is executed, it performs all ammo system operations required: it checks whether the requested ammo usage can be expended (both in partial-fire and whole-fire capabilities both), and attempts to cancel any on-going reloading actions; only if this function returns true (meaning that, as far as the ammo system goes, the weapon can fire and any ammo has been expended) should further operations be made (e.g.: spawning grenade actors, raycasts to find damage targets. Care needs to be done when using this function however, as it will automatically expend the ammo if the AmmoSystem gives the OK; if there are things aside from the weapon itself that may block weapon actions (e.g.: player being stunned), those must be checked in the containing class BEFORE calling this function.
  *			HandleReloadTrigger() should be called for any reload-triggering or reload-cancelling operations; depending on the reload type chosen, it delegates to type-specific functions which check if the weapon is already reloading and try to cancel it depending on the action that caused HandleReloadTrigger to be called.
+ *			Ammo changes (AmmoChanged/BulletsAdded) are coalesced: however many shots, pellets or bullets-in happen in a frame, listeners receive a single notification at the end of it, with the final values and the total of bullets added; the other events are broadcast as they happen.
+ *			C++ listeners (HUD, crosshair, AI) bind to the native events (e.g.: AmmoChangedEvent.AddUObject); the dynamic delegates of the same name (e.g.: AmmoChangedDelegate) are only the Blueprint bridge and are skipped entirely while nothing is bound to them.
+ *			The ammo state is replicated to the owning client only (weapons are spawned by the server and replicated, see USCharacterEquipmentComponent), and only when it changes: the server packs it into ReplicatedAmmoState after every operation on it, and the client
+ *			unpacks it and keeps advancing the reload on its own from the replicated phase timestamps, so no reload event is ever sent over the network. The ammo core runs on the server's clock everywhere for that reason, and its timestamps travel as FSNetReloadTime.
+ *			CaptureAmmoSnapshot()/RestoreAmmoSnapshot() save and restore the whole ammo and reload state as a 24-byte plain struct (serializable with <<) for checkpoints, and ResetAmmoState() starts a new life on a pooled weapon; all of them are O(1).
+ *			Shots, reload triggers and cancels are predicted on the owning client: ManageAmmoWhenUseRequested/HandleReloadTrigger/HandleReloadCancel apply them locally right away and send them to the server with their timestamp, and the server applies them at that same time.
+ *			Whenever the server's state comes in, the actions it hasn't acknowledged yet are replayed on top of it; if the result differs from what the client predicted (e.g.: a per-bullet cancel rejected because no cycle had completed yet), the client rolls back to it.
  *			
  *
+ * Implementation:
+ *		All the ammo/reload logic lives in the engine-free ammo core (AmmoCore.h), as one compile-time policy per reload type; this component is only a thin wrapper around it that
+ *		owns the state, builds the configuration from the properties below, turns the core's events into the delegates and keeps a single deadline on the core's next phase boundary in the reload timing wheel (USReloadTimingWheelSubsystem).
+ *		The policy is bound once in BeginPlay according to ReloadType (which also sets the maximum bullets). Every entry point, firing included, then goes through VisitAmmoCore(), in which each branch
+ *		has the whole code of its policy inlined: there is no indirect nor virtual call, only a branch on the bound policy, which never changes for a given weapon and is therefore always predicted
+ *
+ *
  * Planned future development and features:
- *		Fix issue in PassiveReload() (see cpp file for hint)
  *		Encapsulate HUDInfo management entirely within the AmmoSystemComponent, but also prevent issues arising in weapons without any sort of AmmoSystem (e.g.: melee weapons)
- *		Networking
  *
  *		
  *
@@ -99,6 +313,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPerBulletCancelledInstantSignature);
  *		Section A represents an ongoing reload-cancelling weapon action
  *		Section 1 is the "delay period", a configurable period of time that must pass after the end of an ammo-consuming weapon action before passive reload effectively begins
  *		Section 2 is the reload proper, after each while, 1 bullet is added; this is done over and over automatically until the maximum is met; the start of a new weapon action shall cancel this cycle
+ *		Passive reload is analytic: only the start time of section 2 and the number of cycles already applied are stored, and the bullet count is derived from them whenever it is needed (firing, broadcast requests)
+ *		A single deadline for the next section boundary is only scheduled while the weapon is visible in the HUD, so weapons nobody is looking at cost no deadlines and no broadcasts
  *
  *
  * Magazine Reload functionality explanation:
@@ -126,11 +342,20 @@ class COOPGAME_API USAmmoSystemComponent : public UActorComponent {
 	
 	GENERATED_BODY()
 
+	friend struct FSAmmoCoreListener;
+	friend class USReloadTimingWheelSubsystem;
+
 
 public:	
 	// Sets default values for this component's properties
 	USAmmoSystemComponent();
 
+	// Called every frame (only enabled while there are ammo notifications waiting to be flushed)
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Registers the replicated ammo state (owner only, pushed when dirty)
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 	
 	// Main functions to be called outside
 
@@ -149,70 +374,129 @@ public:
 	
 	// Status extracting functions (getters that depend on reload type)
 
-	// Returns the maximum number of bullets that can be available for the weapon simultaneously (depends on reload type)
+	// Returns the maximum number of bullets that can be available for the weapon simultaneously (depends on reload type, set when the ammo core is bound)
 	FORCEINLINE int32 GetMaximumBullets(void) const;
 	
 	// Expose the reload type
 	FORCEINLINE UReloadType GetReloadType(void) const;
 
 	// Broadcasts information on generic request
-	void OnBroadcastRequested(void) const;
+	void OnBroadcastRequested(void);
+
+	// Sets whether this ammo system's weapon is the one being displayed in the HUD; only then are timed events (e.g.: passive bullets-in) scheduled and broadcast
+	void SetHUDVisibility(bool bVisible);
+
+	// Makes the ammo system read its ammo and reload settings through a weapon definition instead of this component's defaults; must be called before BeginPlay
+	void ApplyWeaponDefinition(const USWeaponDefinition& Definition);
+
+
+	// Snapshots (respawn, checkpoints)
+
+	// Takes a compact snapshot of the ammo and reload state, brought up to now
+	FSAmmoSnapshot CaptureAmmoSnapshot(void);
+
+	// Restores a snapshot taken from a weapon of the same reload type, resuming any reload it had on-going; returns false if the snapshot doesn't fit this weapon
+	bool RestoreAmmoSnapshot(const FSAmmoSnapshot& Snapshot);
+
+	// Resets the ammo state to that of a freshly spawned weapon, so a pooled weapon can start a new life without being spawned again
+	void ResetAmmoState(void);
 
 	
 	// Public class members
 
 	
-	// Delegates
+	// Native events
+
+	// Event broadcast with the new ammo and available reload values
+	FOnAmmoChangedEvent AmmoChangedEvent;
+
+	// Event broadcast upon the addition of bullets into a weapon (passive and per-bullet reload)
+	FOnBulletAddedEvent BulletsAddedEvent;
+
+	// Passive reload-specific events
+	FOnPassiveReloadStartedEvent PassiveStartEvent;
+	FOnPassiveReloadCycleStartedEvent PassiveReloadCycleStartEvent;
+	FOnPassiveReloadCancelledEvent PassiveCancelEvent;
+
+	// Magazine reload-specific events
+	FOnMagazineReloadStartedEvent MagazineStartEvent;
+	FOnMagazineReloadBulletsInEvent MagazineBulletsInEvent;
+	FOnMagazineReloadCompleteEvent MagazineCompleteEvent;
+	FOnMagazineReloadCancelledEvent MagazineCancelEvent;
+
+	// Per-bullet reload-specific events
+	FOnPerBulletReloadStartedEvent PerBulletStartEvent;
+	FOnPerBulletReloadCycleStartedEvent PerBulletReloadCycleStartEvent;
+	FOnPerBulletCancelledWithTimeEvent PerBulletTimedCancelEvent;
+	FOnPerBulletReloadCompleteEvent PerBulletCompleteEvent;
+	FOnPerBulletCancelledInstantEvent PerBulletInstantCancelEvent;
+
+	
+	// Blueprint delegates
 	
 	// Delegate to broadcast new ammo and available reload values
+	UPROPERTY(BlueprintAssignable, Category = "Ammo")
 	FOnAmmoChangedSignature AmmoChangedDelegate;
 
 	// Delegate to broadcast the addition of bullets into a weapon (used for passive and per-bullet reload broadcast)
+	UPROPERTY(BlueprintAssignable, Category = "Ammo")
 	FOnBulletAddedSignature BulletsAddedDelegate;
 
 	
 	// Passive reload-specific delegates
 	
 	// Delegate to broadcast the start of passive reload and its parameters
+	UPROPERTY(BlueprintAssignable, Category = "Ammo | Passive")
 	FOnPassiveReloadStartedSignature PassiveStartDelegate;
 
 	// Delegate to broadcast the start of a passive reload cycle and its duration
+	UPROPERTY(BlueprintAssignable, Category = "Ammo | Passive")
 	FOnPassiveReloadCycleStartedSignature PassiveReloadCycleStartDelegate;
 	
 	// Delegate to broadcast the cancellation of passive reload 
+	UPROPERTY(BlueprintAssignable, Category = "Ammo | Passive")
 	FPassiveReloadCancelledSignature PassiveCancelDelegate;
 
 	
 	// Magazine reload-specific delegates
 	
 	// Delegate to broadcast the start of magazine reload and its parameters
+	UPROPERTY(BlueprintAssignable, Category = "Ammo | Magazine")
 	FOnMagazineReloadStartedSignature MagazineStartDelegate;
 
 	// Delegate to broadcast bullets being inserted in magazine and the parameters for the new stage
+	UPROPERTY(BlueprintAssignable, Category = "Ammo | Magazine")
 	FOnMagazineReloadBulletsInSignature MagazineBulletsInDelegate;
 
 	// Delegate to broadcast the proper conclusion of magazine reload
+	UPROPERTY(BlueprintAssignable, Category = "Ammo | Magazine")
 	FOnMagazineReloadCompleteSignature MagazineCompleteDelegate;
 
 	// Delegate to broadcast the cancellation of magazine reload
+	UPROPERTY(BlueprintAssignable, Category = "Ammo | Magazine")
 	FOnMagazineReloadCancelledSignature MagazineCancelDelegate;
 
 	
 	// Per-bullet reload-specific delegates
 	
 	// Delegate to broadcast the start of per-bullet reload and its initial delay
+	UPROPERTY(BlueprintAssignable, Category = "Ammo | Bullet-per-bullet")
 	FOnPerBulletReloadStartedSignature PerBulletStartDelegate;
 
 	// Delegate to broadcast the start of a per-bullet reload cycle and its duration
+	UPROPERTY(BlueprintAssignable, Category = "Ammo | Bullet-per-bullet")
 	FOnPerBulletReloadCycleStartedSignature PerBulletReloadCycleStartDelegate;
 	
 	// Delegate to broadcast the cancellation of per-bullet reload with winddown
+	UPROPERTY(BlueprintAssignable, Category = "Ammo | Bullet-per-bullet")
 	FOnPerBulletCancelledWithTimeSignature PerBulletTimedCancelDelegate;
 
 	// Delegate to broadcast the completion of the per-bullet reload procedure
+	UPROPERTY(BlueprintAssignable, Category = "Ammo | Bullet-per-bullet")
 	FOnPerBulletReloadCompleteSignature PerBulletCompleteDelegate;
 
 	// Delegate to broadcast the cancellation of per-bullet reload without winddown
+	UPROPERTY(BlueprintAssignable, Category = "Ammo | Bullet-per-bullet")
 	FOnPerBulletCancelledInstantSignature PerBulletInstantCancelDelegate;
 
 	
@@ -220,6 +504,9 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	// Called when the game ends or the component is destroyed
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// Variable that states what reload rules does the ammo system follow
 	UPROPERTY(EditDefaultsOnly, Category = "Reload | Type")
 	UReloadType ReloadType;
@@ -318,118 +605,156 @@ protected:
 
 	
 private:
-	// Internal functions
-	// Status extracting functions (getters that depend on reload type)
+	// Ammo core bindings (defined for every reload policy in the cpp file)
 
-	// Returns the number of leftover bullets/magazines depending on the active reload type; if the reload type is passive, this function returns 0
-	int32 GetAvailableReloads(void) const;
+	// Binds the given reload policy with its maximum bullets and initializes the ammo state for it
+	template<typename PolicyType>
+	void BindAmmoCore(int32 MaximumBullets);
 
+	// Calls the given functor with an instance of the bound reload policy (an empty struct, only there for its type), returning whatever the functor returns
+	template<typename FunctorType>
+	decltype(auto) VisitAmmoCore(FunctorType&& Functor) const;
 
-	// Status helpers
-	
-	// Indicates whether this weapon can be fired, using intBulletsCurrentlyActive as a basis vs the number of bullets the attack to be used requires and whether reloading blocks firing the weapon.
-	// Internal function called only in the scope of CanFireAndExpendBullets
-	bool CanFire(bool CanBePartial, uint8 NumToExpend) const;
-	
-	// Returns true if the request performed and the weapon status and configuration is proper for triggering of passive-type reload
-	bool CanTriggerPassiveReload(const UReloadCancelTrigger& CancelType) const;
+	// Consumes ammo at the given time through the ammo core of the given reload policy
+	template<typename PolicyType>
+	bool ConsumeAmmoWithPolicy(bool CanBePartial, uint8 NumToExpend, uint8& BulletsTrulyExpended, double Now);
 
-	// Returns true if the request performed and the weapon status and configuration is proper for triggering of magazine-type reload
-	bool CanTriggerMagazineReload(bool OtherWeaponActionOccurring) const;
+	// Requests the start of a reload at the given time through the ammo core of the given reload policy
+	template<typename PolicyType>
+	bool TriggerReloadWithPolicy(bool WeaponIsBusy, UReloadCancelTrigger CancelType, double Now);
 
-	// Returns true if the request performed and the weapon status and configuration is proper for triggering of per-bullet-type reload
-	bool CanTriggerPerBulletReload(bool OtherWeaponActionOccurring) const;
-	
-	// Returns true if the request performed and the weapon status and configuration is proper for cancellation of passive-type reload
-	bool CanCancelPassiveReload(UReloadCancelTrigger CancelType) const;
-	
-	// Returns true if the request performed and the weapon status and configuration is proper for cancellation of magazine-type reload
-	bool CanCancelMagazineReload(UReloadCancelTrigger CancelType) const;
+	// Requests the cancelling of the on-going reload at the given time through the ammo core of the given reload policy
+	template<typename PolicyType>
+	bool CancelReloadWithPolicy(UReloadCancelTrigger CancelType, double Now);
 
-	// Returns true if the request performed and the weapon status and configuration is proper for cancellation of per-bullet-type reload
-	bool CanCancelPerBulletReload(UReloadCancelTrigger CancelType) const;
+	// Processes every reload phase boundary up to the given time through the ammo core of the given reload policy
+	template<typename PolicyType>
+	void AdvanceReloadWithPolicy(double Now);
 
-	
-	// Handler functions
+	// Starts the automatic reload behaviour (if any) through the ammo core of the given reload policy
+	template<typename PolicyType>
+	void ActivateReloadWithPolicy(void);
 
-	// Function dedicated to handling passive reload, returns success
-	bool TriggerPassiveReload(const UReloadCancelTrigger& CancelType);
+	// Sets the ammo state of a freshly spawned weapon through the ammo core of the given reload policy
+	template<typename PolicyType>
+	void InitializeAmmoWithPolicy(void);
 
-	// Function dedicated to handling passive reload, returns success
-	bool TriggerMagazineReload(bool OtherWeaponActionOccurring);
-	
-	// Function dedicated to handling passive reload, returns success
-	bool TriggerPerBulletReload(bool OtherWeaponActionOccurring);
-	
-	// Inner function that handles reload cancelling in passive reload type weapons, after the conditions have been checked
-	bool CancelPassiveReload(UReloadCancelTrigger CancelType);
-	
-	// Inner function that handles reload cancelling in active magazine reload type weapons, after the conditions have been checked
-	bool CancelMagazineReload(UReloadCancelTrigger CancelType);
+	// Takes the server's state, replays the ammo actions (shots, reload triggers and cancels) it hasn't acknowledged yet on top of it, and rolls back to the result if it differs from the prediction (owning client only)
+	template<typename PolicyType>
+	void ReconcileReloadWithPolicy(void);
+
+	// Schedules the next reload phase boundary of the given reload policy in the timing wheel, if there is one and someone needs it on time
+	template<typename PolicyType>
+	void ScheduleReloadDeadlineWithPolicy(void);
+
+	// Returns the number of leftover bullets/magazines according to the given reload policy, -1 if there is no limit
+	template<typename PolicyType>
+	int32 GetAvailableReloadsWithPolicy(void) const;
 
-	// Inner function that handles reload cancelling in active per-bullet reload type weapons, after the conditions have been checked (implements step 3 of the per-bullet reload schema)
-	bool CancelPerBulletReload(UReloadCancelTrigger CancelType);
 
-	
 	// Timer functions in reload
-	
-	// Function called once the initial delay for passive reload passes
-	void OnStartDelayFinishedPassiveReload(void);
 
-	// Function called every time ReloadTimePassive elapses in passive reload weapons
-	void OnBulletsInPassiveReload(void);
+	// Function called at every reload phase boundary (end of a delay, bullets in, completion), processes it and schedules the next one
+	void OnReloadDeadline(void);
 
-	// Function called when the ammo is added to the currently available ammo
-	void OnBulletsInMagazineReload(void);
+	// Returns the current time of the reload clock, as used by the ammo core (see USReloadTimingWheelSubsystem::GetReloadTime)
+	double GetAmmoCoreTime(void) const;
 
-	// Function called when the animation for magazine reload is complete
-	void OnCompleteMagazineReload(void);
+	// Marks the ammo values as changed (with the given bullets added, if any) and makes sure they are flushed at the end of the frame
+	void QueueAmmoNotification(int32 NumBulletsAdded);
 
-	// Function called once the initial delay for per-bullet reload passes
-	void OnStartDelayFinishedPerBulletReload(void);
-	
-	// Function called after the initial delay for bullet-per-bullet reload has finished (section 1, wind up)
-	void OnBulletsInPerBulletReload(void);
+	// Broadcasts the ammo changes accumulated during this frame as a single notification
+	void FlushAmmoNotifications(void);
 
-	// Inner function that handles the cancelling of the per-bullet reload proper in case it's a timed cancel
-	void OnCompleteWithSuccessPerBulletReload(void);
+	// Replication
 
-	// Inner function that handles the cancelling of the per-bullet reload proper in case it's an instant cancel
-	void OnCompleteWithCancelPerBulletReload(void);
+	// Packs the ammo state into its replicated counterpart and marks it dirty if anything changed (server only)
+	void UpdateReplicatedAmmoState(void);
+
+	// Takes the ammo state received from the server and reconciles the client's prediction with it
+	UFUNCTION()
+	void OnRep_ReplicatedAmmoState(void);
+
+	// Returns true on the client that owns the weapon, the only one predicting its ammo actions (the weapon itself is only a simulated proxy there)
+	bool IsPredictingAmmo(void) const;
+
+	// Returns the time at which an ammo action requested now happens, rounded to what the server receives so both sides run the exact same timeline
+	double GetAmmoActionTime(void) const;
+
+	// Records an ammo action predicted by the owning client (its key is assigned here) and sends it to the server
+	void PredictAmmoAction(FSPredictedAmmoAction Action);
+
+	// Applies an ammo consumption (a shot) predicted by the owning client, at the time it happened there; sent once per shot, so it's unreliable (a lost one is given back to the client by the reconciliation, see ReconcileReloadWithPolicy)
+	UFUNCTION(Server, Unreliable)
+	void ServerConsumeAmmo(bool CanBePartial, uint8 NumToExpend, FSNetReloadTime ClientTime, int32 ActionKey);
+
+	// Applies a reload trigger predicted by the owning client, at the time it happened there
+	UFUNCTION(Server, Reliable)
+	void ServerTriggerReload(bool WeaponIsBusy, UReloadCancelTrigger CancelType, FSNetReloadTime ClientTime, int32 ActionKey);
+
+	// Applies a reload cancel predicted by the owning client, at the time it happened there
+	UFUNCTION(Server, Reliable)
+	void ServerCancelReload(UReloadCancelTrigger CancelType, FSNetReloadTime ClientTime, int32 ActionKey);
+
+	// Returns the time at which the server applies an action predicted by the client: the client's own timestamp, as long as it's neither in the future, too far in the past nor before the previous action
+	double GetPredictedActionTime(const FSNetReloadTime& ClientTime);
 
-	// Inner function that handles the cancelling of the per-bullet reload proper
-	void OnCompletePerBulletReload(void);
 
-	
 	// Tracker variables
-	// Indicates if the weapon is being reloaded
-	bool bIsReloading;
 
-	// Indicates if the reload cancel is already underway
-	bool bReloadIsBeingCancelled;
+	// Reload policy the ammo core was bound to in BeginPlay, and whether it has been bound yet
+	UReloadType AmmoCorePolicy;
+	bool bIsAmmoCoreBound;
 
-	// Counts the bullets currently available for the player to fire, used for all types of weapons (passive and active reload both, and bullet-per-bullet and magazine reload)
-	int32 BulletsCurrentlyActive;
+	// Shared definition the ammo and reload settings are read through, if the weapon has one (see ApplyWeaponDefinition)
+	UPROPERTY(Transient)
+	const USWeaponDefinition* WeaponDefinition;
 
-	// Tracks the number of magazines already used in the player's life (reset upon character death and respawn)
-	uint8 MagazinesExpended;
+	// Reload configuration handed to the ammo core, built from the properties above (or the weapon definition)
+	FSAmmoConfig AmmoConfig;
 
-	// Tracks the number of bullets loaded into the weapon in the player's life (reset upon character death and respawn)
-	int32 BulletsExpended;
+	// Ammo and reload state of this weapon
+	FSAmmoState AmmoState;
+
+	// Indicates if this ammo system's weapon is the one being displayed in the HUD
+	bool bIsHUDVisible;
+
+	// Time of the reload phase boundary that ReloadDeadlineHandle is scheduled for
+	double ScheduledDeadline;
+
+	// Indicates that the ammo values changed during this frame and are yet to be broadcast
+	bool bAmmoChangedPending;
+
+	// Bullets added during this frame, yet to be broadcast
+	int32 PendingBulletsAdded;
+
+	// Ammo state replicated to the owning client
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedAmmoState)
+	FSReplicatedAmmoState ReplicatedAmmoState;
+
+	// Indicates that the ammo state has been received from the server at least once (clients only)
+	bool bReceivedReplicatedAmmoState;
+
+	// Ammo actions predicted and not yet acknowledged by the server, oldest first (clients only)
+	TArray<FSPredictedAmmoAction> PendingAmmoActions;
+
+	// Sequence number of the latest ammo action predicted (clients only)
+	int32 LastPredictedAmmoAction;
+
+	// Sequence number of the latest predicted ammo action applied (server only)
+	int32 LastAcknowledgedAmmoAction;
+
+	// Time at which the latest predicted ammo action was applied (server only)
+	double LastPredictedActionTime;
 
-	// Tracks the number of times bullets have been loaded into the weapon for the currently-active per-bullet reload cycle (0 if reloading is not happening)
-	uint8 PerBulletReloadCycles;
 
-	
 	// Timers
 
-	// Timer for handling the initial delay in passive and per-bullet reloads
-	FTimerHandle TimerHandle_InitialDelayTimer;
-	
-	// Timer for the update of the currently available bullets
-	FTimerHandle TimerHandle_NewBulletsTimer;
+	// Timing wheel in which the reload phase boundaries are scheduled
+	UPROPERTY(Transient)
+	USReloadTimingWheelSubsystem* ReloadTimingWheel;
 
-	// Timer for the completion of the reload animation/unavailability of the weapon
-	FTimerHandle TimerHandle_ReloadCompletion;
+	// Deadline of the next reload phase boundary in the timing wheel
+	FSReloadTimerHandle ReloadDeadlineHandle;
 	
 };
@@ -0,0 +1,834 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+
+
+/*
+ *
+ * Engine-free ammo and reload core. It contains the whole ammo/reload state machine of the three reload types as plain data (FSAmmoConfig, FSAmmoState) and compile-time reload policies
+ * (FSPassiveReloadPolicy, FSMagazineReloadPolicy, FSPerBulletReloadPolicy, FSNoReloadPolicy), joined together by TSAmmoCore<Policy>. There is no runtime switch nor virtual dispatch:
+ * the policy is chosen once (see USAmmoSystemComponent) and every call afterwards goes straight to the policy's code.
+ *
+ * Time is passed in explicitly (seconds, any monotonic clock) and the core never schedules anything by itself: Advance() processes every phase boundary up to the given time, and
+ * NextDeadline() tells the owner when the next boundary happens, so the owner can set a single timer for it (or just call Advance() lazily before reading the state).
+ *
+ * Events are sent to a listener passed in by the owner. Events specific to a reload type are tag-dispatched: the listener receives the policy as its first parameter, so
+ * the owner can route them with plain overloads (e.g.: OnReloadStarted(FSPassiveReloadPolicy, float) vs OnReloadStarted(FSMagazineReloadPolicy, float)). A listener only has to implement
+ * the overloads of the policies it is used with:
+ *		OnAmmoChanged(int32_t BulletsCurrentlyActive, int32_t AvailableReloads)
+ *		OnBulletsAdded(uint8_t NumBulletsAdded)
+ *		OnReloadStarted(Policy, float FirstDelay)
+ *		OnReloadCycleStarted(Policy, float CycleDuration)					(passive, per-bullet)
+ *		OnMagazineBulletsIn(float TimeToCompletion)							(magazine)
+ *		OnReloadCompleted(Policy)											(magazine, per-bullet)
+ *		OnReloadCancelled(Policy, ESAmmoCancelTrigger CancelType)				(passive, magazine, per-bullet instant cancel)
+ *		OnReloadCancelledWithWinddown(float TimeToCompletion)					(per-bullet)
+ *
+ * Nothing in here depends on the engine, so it can be compiled, tested and benchmarked on its own.
+ *
+ */
+
+
+
+// Mirrors UReloadCancelTrigger (same values) so the core doesn't depend on reflected types
+enum class ESAmmoCancelTrigger : uint8_t {
+
+	Invalid = 0,
+	TriggerByWeaponAction = 1,
+	TriggerByReload = 2,
+	TriggerByLimitReached = 3,
+	TriggerByWeaponSwitch = 4,
+	TriggerByExternal = 5,
+	GenericPassiveTrigger = 6
+
+};
+
+
+// Phase of the reload state machine; each policy gives its own meaning to the non-idle phases (see the policies below)
+enum class ESAmmoPhase : uint8_t {
+
+	Idle = 0,
+	InitialDelay = 1,
+	BulletsIn = 2,
+	Winddown = 3
+
+};
+
+
+/*
+ *
+ *	Reload configuration of a weapon, built once from the ammo system's properties
+ *
+ */
+struct FSAmmoConfig {
+
+	// Maximum number of bullets that can be available simultaneously
+	int32_t MaximumBullets = 0;
+
+	// Passive: delay between the most recent weapon action and the passive reload starting, and time for a single bullet to regenerate
+	float PassiveReloadDelay = 1.0f;
+	float ReloadTimePassive = 1.0f;
+
+	// Magazine: whether the reload key can cancel the reload, time for the bullets to be in and wind-down time after that, magazine cap per life
+	bool bEnableMagazineReloadCancel = false;
+	float BulletsReloadTimeMagazine = 1.0f;
+	float WinddownReloadTimeMagazine = 0.0f;
+	bool bCapMagazinesPerLife = false;
+	int32_t MagazinesPerLife = 0;
+
+	// Per-bullet: bullets per cycle, initial delay, cycle duration, cancel wind-down and bullet cap per life
+	uint8_t BulletPerReload = 1;
+	float ReloadDelayTimeBullet = 0.0f;
+	float ReloadTimeBullet = 1.0f;
+	float ReloadEndTimeBullet = 0.0f;
+	bool bCapBulletsPerLife = false;
+	int32_t BulletsPerLife = 0;
+
+};
+
+
+/*
+ *
+ *	Ammo and reload state of a weapon (plain data, can be copied and compared freely)
+ *
+ */
+struct FSAmmoState {
+
+	// Bullets currently available for the player to fire
+	int32_t BulletsCurrentlyActive = 0;
+
+	// Magazines already used in the player's life (magazine)
+	int32_t MagazinesExpended = 0;
+
+	// Bullets loaded into the weapon in the player's life (per-bullet; also counted by passive)
+	int32_t BulletsExpended = 0;
+
+	// Times bullets have been loaded during the current per-bullet reload (0 if not reloading)
+	int32_t PerBulletReloadCycles = 0;
+
+	// Bullets-in cycles of the current passive reload whose bullet has already been added
+	int32_t PassiveCyclesApplied = 0;
+
+	// Current phase of the reload state machine
+	ESAmmoPhase Phase = ESAmmoPhase::Idle;
+
+	// Indicates if a timed reload cancel is underway (per-bullet)
+	bool bReloadIsBeingCancelled = false;
+
+	// Time at which the current phase ends (for passive reload in the bullets-in phase, the time at which that phase started)
+	double PhaseTime = 0.0;
+
+	// Returns true if any reload phase is on-going
+	bool IsReloading() const { return Phase != ESAmmoPhase::Idle; }
+
+};
+
+
+/*
+ *
+ *	Compact snapshot of an ammo state (plain data, 24 bytes) for respawns and checkpoints. The phase time is stored relative to the moment the snapshot was taken,
+ *	so restoring it later (e.g.: loading a checkpoint) resumes an on-going reload with the time it had left
+ *
+ */
+struct FSAmmoSnapshot {
+
+	// Counters of the ammo state
+	int32_t BulletsCurrentlyActive = 0;
+	int32_t MagazinesExpended = 0;
+	int32_t BulletsExpended = 0;
+	uint16_t PerBulletReloadCycles = 0;
+	uint16_t PassiveCyclesApplied = 0;
+
+	// Time between the snapshot and the end of the current phase (start, for passive reload in the bullets-in phase), in seconds
+	float PhaseTimeOffset = 0.0f;
+
+	// Reload phase and whether a timed cancel is underway
+	ESAmmoPhase Phase = ESAmmoPhase::Idle;
+	bool bReloadIsBeingCancelled = false;
+
+	// Reload type of the weapon the snapshot was taken from, set and checked by the owner (0 for an empty snapshot)
+	uint8_t ReloadType = 0;
+
+	// Takes a snapshot of the given state at the given time
+	static FSAmmoSnapshot Capture(const FSAmmoState& State, double Now) {
+
+		FSAmmoSnapshot Snapshot;
+		Snapshot.BulletsCurrentlyActive = State.BulletsCurrentlyActive;
+		Snapshot.MagazinesExpended = State.MagazinesExpended;
+		Snapshot.BulletsExpended = State.BulletsExpended;
+		Snapshot.PerBulletReloadCycles = static_cast<uint16_t>(State.PerBulletReloadCycles);
+		Snapshot.PassiveCyclesApplied = static_cast<uint16_t>(State.PassiveCyclesApplied);
+		Snapshot.PhaseTimeOffset = State.IsReloading() ? static_cast<float>(State.PhaseTime - Now) : 0.0f;
+		Snapshot.Phase = State.Phase;
+		Snapshot.bReloadIsBeingCancelled = State.bReloadIsBeingCancelled;
+
+		return Snapshot;
+
+	}
+
+	// Writes the snapshot into the given state as if it had been taken at the given time
+	void Restore(FSAmmoState& State, double Now) const {
+
+		State.BulletsCurrentlyActive = BulletsCurrentlyActive;
+		State.MagazinesExpended = MagazinesExpended;
+		State.BulletsExpended = BulletsExpended;
+		State.PerBulletReloadCycles = PerBulletReloadCycles;
+		State.PassiveCyclesApplied = PassiveCyclesApplied;
+		State.Phase = Phase;
+		State.bReloadIsBeingCancelled = bReloadIsBeingCancelled;
+		State.PhaseTime = (Phase != ESAmmoPhase::Idle) ? (Now + PhaseTimeOffset) : 0.0;
+
+	}
+
+};
+
+
+// Value returned by NextDeadline() when nothing is scheduled
+static constexpr double AmmoCoreNoDeadline = -1.0;
+
+
+
+/*
+ *
+ *	Passive reload: InitialDelay (after the last weapon action) -> BulletsIn (1 bullet per cycle, derived analytically from the elapsed time) -> Idle once the maximum is reached
+ *	Cancelled by weapon actions (if there are bullets left), limit reached, weapon switch or external causes; any cancel other than limit reached or weapon switch retriggers it immediately
+ *
+ */
+struct FSPassiveReloadPolicy {
+
+	// Reload never blocks firing
+	static constexpr bool bBlocksFiring = false;
+
+	// Deadlines are only for broadcasting, state is derived lazily, so nobody needs to wait for them when the weapon isn't displayed
+	static constexpr bool bNeedsDeadlineWhenHidden = false;
+
+	// Passive reload has no limit on reloads
+	static int32_t GetAvailableReloads(const FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		return -1;
+
+	}
+
+	// Initial state of a freshly spawned weapon
+	static void Initialize(FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		State = FSAmmoState();
+		State.BulletsCurrentlyActive = Config.MaximumBullets;
+
+	}
+
+	// Starts the passive reload if there is space in the weapon and it wasn't requested via the reload key
+	template<typename ListenerType>
+	static bool Trigger(FSAmmoState& State, const FSAmmoConfig& Config, double Now, bool bWeaponIsBusy, ESAmmoCancelTrigger CancelType, ListenerType& Listener) {
+
+		bool Success = false;
+
+		if (!State.IsReloading() && State.BulletsCurrentlyActive < Config.MaximumBullets && CancelType != ESAmmoCancelTrigger::TriggerByReload) {
+
+			State.Phase = ESAmmoPhase::InitialDelay;
+			State.PhaseTime = Now + Config.PassiveReloadDelay;
+			State.PassiveCyclesApplied = 0;
+
+			Listener.OnReloadCancelled(FSPassiveReloadPolicy(), CancelType);
+			Listener.OnReloadStarted(FSPassiveReloadPolicy(), Config.PassiveReloadDelay);
+
+			Success = true;
+
+		}
+
+		return Success;
+
+	}
+
+	// Applies the bullets of every cycle completed up to Now, cancelling the reload once the maximum is reached
+	template<typename ListenerType>
+	static void Advance(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ListenerType& Listener) {
+
+		if (State.IsReloading() && Now >= State.PhaseTime) {
+
+			const bool bEnteredBulletsIn = (State.Phase == ESAmmoPhase::InitialDelay);
+			State.Phase = ESAmmoPhase::BulletsIn;
+
+			// Small tolerance so a deadline hit exactly on a cycle boundary always counts that cycle's bullet
+			const int32_t CyclesCompleted = static_cast<int32_t>(std::floor(((Now - State.PhaseTime) / Config.ReloadTimePassive) + 1e-4));
+			const int32_t BulletsAdded = std::min(CyclesCompleted - State.PassiveCyclesApplied, Config.MaximumBullets - State.BulletsCurrentlyActive);
+			State.PassiveCyclesApplied = CyclesCompleted;
+
+			if (BulletsAdded > 0) {
+
+				State.BulletsExpended += BulletsAdded;
+				State.BulletsCurrentlyActive += BulletsAdded;
+
+				Listener.OnAmmoChanged(State.BulletsCurrentlyActive, GetAvailableReloads(State, Config));
+				Listener.OnBulletsAdded(static_cast<uint8_t>(BulletsAdded));
+
+			}
+
+			if (State.BulletsCurrentlyActive >= Config.MaximumBullets) {
+
+				Cancel(State, Config, Now, ESAmmoCancelTrigger::TriggerByLimitReached, Listener);
+
+			}
+			else if (BulletsAdded > 0 || bEnteredBulletsIn) {
+
+				Listener.OnReloadCycleStarted(FSPassiveReloadPolicy(), Config.ReloadTimePassive);
+
+			}
+
+		}
+
+	}
+
+	// Cancels the passive reload if the cause allows it, then retriggers it right away unless the weapon was switched out or is full
+	template<typename ListenerType>
+	static bool Cancel(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ESAmmoCancelTrigger CancelType, ListenerType& Listener) {
+
+		bool Success = false;
+
+		// Keep the bullets regenerated up until now (not needed when advancing is what caused the cancel)
+		if (CancelType != ESAmmoCancelTrigger::TriggerByLimitReached) {
+
+			Advance(State, Config, Now, Listener);
+
+		}
+
+		const bool WeaponActionTriggered = (CancelType == ESAmmoCancelTrigger::TriggerByWeaponAction) && (State.BulletsCurrentlyActive > 0);
+		const bool IndirectCause = (CancelType == ESAmmoCancelTrigger::TriggerByLimitReached) || (CancelType == ESAmmoCancelTrigger::TriggerByWeaponSwitch) || (CancelType == ESAmmoCancelTrigger::TriggerByExternal);
+
+		if (State.IsReloading() && (WeaponActionTriggered || IndirectCause)) {
+
+			State.Phase = ESAmmoPhase::Idle;
+			State.bReloadIsBeingCancelled = false;
+
+			Listener.OnReloadCancelled(FSPassiveReloadPolicy(), CancelType);
+
+			Success = true;
+
+		}
+
+		const bool CanRetriggerImmediately = (CancelType != ESAmmoCancelTrigger::TriggerByWeaponSwitch) && (CancelType != ESAmmoCancelTrigger::TriggerByLimitReached);
+
+		if (!State.IsReloading() && CanRetriggerImmediately) {
+
+			Trigger(State, Config, Now, false, ESAmmoCancelTrigger::GenericPassiveTrigger, Listener);
+
+		}
+
+		return Success;
+
+	}
+
+	// Passive reload starts by itself whenever the weapon is activated
+	template<typename ListenerType>
+	static void Activate(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ListenerType& Listener) {
+
+		Trigger(State, Config, Now, false, ESAmmoCancelTrigger::GenericPassiveTrigger, Listener);
+
+	}
+
+	// End of the initial delay, or the moment the next bullet comes in
+	static double NextDeadline(const FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		switch (State.Phase) {
+
+		case ESAmmoPhase::InitialDelay:
+			return State.PhaseTime;
+
+		case ESAmmoPhase::BulletsIn:
+			return State.PhaseTime + (State.PassiveCyclesApplied + 1) * static_cast<double>(Config.ReloadTimePassive);
+
+		default:
+			return AmmoCoreNoDeadline;
+
+		}
+
+	}
+
+};
+
+
+/*
+ *
+ *	Magazine reload: BulletsIn (magazine replacement, bullets restored at its end) -> Winddown (weapon still unavailable) -> Idle
+ *	Only cancellable with the reload key if configured so, or by limit reached, weapon switch or external causes; cancels are instantaneous
+ *
+ */
+struct FSMagazineReloadPolicy {
+
+	// Firing is blocked for the whole reload
+	static constexpr bool bBlocksFiring = true;
+
+	// Completion of the reload is what frees the weapon, so it must happen on time
+	static constexpr bool bNeedsDeadlineWhenHidden = true;
+
+	// Leftover magazines, -1 if uncapped
+	static int32_t GetAvailableReloads(const FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		return Config.bCapMagazinesPerLife ? (Config.MagazinesPerLife - State.MagazinesExpended) : -1;
+
+	}
+
+	// Initial state of a freshly spawned weapon (always 1 magazine used at game start)
+	static void Initialize(FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		State = FSAmmoState();
+		State.BulletsCurrentlyActive = Config.MaximumBullets;
+		State.MagazinesExpended = 1;
+
+	}
+
+	// Starts the magazine reload if there are magazines left and the weapon isn't busy
+	template<typename ListenerType>
+	static bool Trigger(FSAmmoState& State, const FSAmmoConfig& Config, double Now, bool bWeaponIsBusy, ESAmmoCancelTrigger CancelType, ListenerType& Listener) {
+
+		bool Success = false;
+
+		const bool MagazinesAvailableForUse = (!Config.bCapMagazinesPerLife || (State.MagazinesExpended < Config.MagazinesPerLife));
+
+		if (!State.IsReloading() && !bWeaponIsBusy && MagazinesAvailableForUse) {
+
+			State.Phase = ESAmmoPhase::BulletsIn;
+			State.PhaseTime = Now + Config.BulletsReloadTimeMagazine;
+
+			Listener.OnReloadStarted(FSMagazineReloadPolicy(), Config.BulletsReloadTimeMagazine);
+
+			Success = true;
+
+		}
+
+		return Success;
+
+	}
+
+	// Restores the magazine and completes the reload as their times are reached
+	template<typename ListenerType>
+	static void Advance(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ListenerType& Listener) {
+
+		if (State.Phase == ESAmmoPhase::BulletsIn && Now >= State.PhaseTime) {
+
+			++State.MagazinesExpended;
+			State.BulletsCurrentlyActive = Config.MaximumBullets;
+			State.Phase = ESAmmoPhase::Winddown;
+			State.PhaseTime += Config.WinddownReloadTimeMagazine;
+
+			Listener.OnAmmoChanged(State.BulletsCurrentlyActive, GetAvailableReloads(State, Config));
+			Listener.OnMagazineBulletsIn(Config.WinddownReloadTimeMagazine);
+
+		}
+
+		if (State.Phase == ESAmmoPhase::Winddown && Now >= State.PhaseTime) {
+
+			State.Phase = ESAmmoPhase::Idle;
+
+			Listener.OnReloadCompleted(FSMagazineReloadPolicy());
+
+		}
+
+	}
+
+	// Cancels the magazine reload instantly if the cause allows it
+	template<typename ListenerType>
+	static bool Cancel(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ESAmmoCancelTrigger CancelType, ListenerType& Listener) {
+
+		bool Success = false;
+
+		Advance(State, Config, Now, Listener);
+
+		const bool ReloadKeyPressed = (CancelType == ESAmmoCancelTrigger::TriggerByReload) && Config.bEnableMagazineReloadCancel;
+		const bool IndirectCause = (CancelType == ESAmmoCancelTrigger::TriggerByLimitReached) || (CancelType == ESAmmoCancelTrigger::TriggerByWeaponSwitch) || (CancelType == ESAmmoCancelTrigger::TriggerByExternal);
+
+		if (State.IsReloading() && (ReloadKeyPressed || IndirectCause)) {
+
+			State.Phase = ESAmmoPhase::Idle;
+
+			Listener.OnReloadCancelled(FSMagazineReloadPolicy(), CancelType);
+
+			Success = true;
+
+		}
+
+		return Success;
+
+	}
+
+	// Nothing automatic about magazine reload
+	template<typename ListenerType>
+	static void Activate(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ListenerType& Listener) {
+
+	}
+
+	// End of the current phase
+	static double NextDeadline(const FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		return State.IsReloading() ? State.PhaseTime : AmmoCoreNoDeadline;
+
+	}
+
+};
+
+
+/*
+ *
+ *	Per-bullet reload: InitialDelay (wind up) -> BulletsIn (BulletPerReload bullets per cycle) -> Winddown (cancel penalty, also used when the limit is reached) -> Idle
+ *	Weapon switch and external causes cancel instantly; any other cancel goes through the wind-down, and the owner's weapon actions are only accepted once a cycle has completed
+ *
+ */
+struct FSPerBulletReloadPolicy {
+
+	// Firing is blocked for the whole reload
+	static constexpr bool bBlocksFiring = true;
+
+	// Bullets coming in and the end of the wind-down are gameplay, so they must happen on time
+	static constexpr bool bNeedsDeadlineWhenHidden = true;
+
+	// Bullets left in storage, -1 if uncapped
+	static int32_t GetAvailableReloads(const FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		// Guard against bad configuration in which the maximum capacity is higher than the bullets per life
+		return Config.bCapBulletsPerLife ? std::max(Config.BulletsPerLife - State.BulletsExpended, 0) : -1;
+
+	}
+
+	// Initial state of a freshly spawned weapon (the loaded bullets count as expended)
+	static void Initialize(FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		State = FSAmmoState();
+		State.BulletsCurrentlyActive = Config.MaximumBullets;
+		State.BulletsExpended = Config.MaximumBullets;
+
+	}
+
+	// Starts the per-bullet reload if there is space in the weapon, bullets in storage and the weapon isn't busy
+	template<typename ListenerType>
+	static bool Trigger(FSAmmoState& State, const FSAmmoConfig& Config, double Now, bool bWeaponIsBusy, ESAmmoCancelTrigger CancelType, ListenerType& Listener) {
+
+		bool Success = false;
+
+		const bool SpaceAvailableInWeapon = (State.BulletsCurrentlyActive < Config.MaximumBullets);
+		const bool EnoughBulletsAvailableInStorage = (!Config.bCapBulletsPerLife || (Config.BulletsPerLife - State.BulletsExpended) >= Config.BulletPerReload);
+
+		if (!State.IsReloading() && !bWeaponIsBusy && SpaceAvailableInWeapon && EnoughBulletsAvailableInStorage) {
+
+			State.Phase = ESAmmoPhase::InitialDelay;
+			State.PhaseTime = Now + Config.ReloadDelayTimeBullet;
+
+			Listener.OnReloadStarted(FSPerBulletReloadPolicy(), Config.ReloadDelayTimeBullet);
+
+			Success = true;
+
+		}
+
+		return Success;
+
+	}
+
+	// Goes through every phase boundary up to Now (boundaries are processed at their own time, so late processing gives the same result)
+	template<typename ListenerType>
+	static void Advance(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ListenerType& Listener) {
+
+		while (State.IsReloading() && Now >= State.PhaseTime) {
+
+			const double BoundaryTime = State.PhaseTime;
+
+			if (State.Phase == ESAmmoPhase::InitialDelay) {
+
+				State.Phase = ESAmmoPhase::BulletsIn;
+				State.PhaseTime = BoundaryTime + Config.ReloadTimeBullet;
+
+				Listener.OnReloadCycleStarted(FSPerBulletReloadPolicy(), Config.ReloadTimeBullet);
+
+			}
+			else if (State.Phase == ESAmmoPhase::BulletsIn) {
+
+				// Never load more than the weapon can hold, nor more than what's left in storage (a cycle can start with fewer than BulletPerReload bullets left)
+				const int32_t BulletsLeftInStorage = Config.bCapBulletsPerLife ? (Config.BulletsPerLife - State.BulletsExpended) : Config.BulletPerReload;
+				const int32_t BulletsReloaded = std::min<int32_t>(std::min<int32_t>(Config.BulletPerReload, BulletsLeftInStorage), Config.MaximumBullets - State.BulletsCurrentlyActive);
+				State.BulletsExpended += BulletsReloaded;
+				State.BulletsCurrentlyActive += BulletsReloaded;
+				++State.PerBulletReloadCycles;
+
+				Listener.OnAmmoChanged(State.BulletsCurrentlyActive, GetAvailableReloads(State, Config));
+				Listener.OnBulletsAdded(static_cast<uint8_t>(BulletsReloaded));
+
+				const bool MaximumBulletsPerLifeReached = (Config.bCapBulletsPerLife && (State.BulletsExpended >= Config.BulletsPerLife));
+				const bool MaximumBulletCapacityReached = (State.BulletsCurrentlyActive >= Config.MaximumBullets);
+
+				if (MaximumBulletsPerLifeReached || MaximumBulletCapacityReached) {
+
+					// The wind-down starts at the boundary itself, not whenever this is being processed
+					CancelAt(State, Config, BoundaryTime, ESAmmoCancelTrigger::TriggerByLimitReached, Listener);
+
+				}
+				else {
+
+					State.PhaseTime = BoundaryTime + Config.ReloadTimeBullet;
+
+					Listener.OnReloadCycleStarted(FSPerBulletReloadPolicy(), Config.ReloadTimeBullet);
+
+				}
+
+			}
+			else {
+
+				Listener.OnReloadCompleted(FSPerBulletReloadPolicy());
+
+				Complete(State);
+
+			}
+
+		}
+
+	}
+
+	// Cancels the per-bullet reload if the cause allows it, either instantly or through the wind-down
+	template<typename ListenerType>
+	static bool Cancel(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ESAmmoCancelTrigger CancelType, ListenerType& Listener) {
+
+		Advance(State, Config, Now, Listener);
+
+		return CancelAt(State, Config, Now, CancelType, Listener);
+
+	}
+
+	// Nothing automatic about per-bullet reload
+	template<typename ListenerType>
+	static void Activate(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ListenerType& Listener) {
+
+	}
+
+	// End of the current phase
+	static double NextDeadline(const FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		return State.IsReloading() ? State.PhaseTime : AmmoCoreNoDeadline;
+
+	}
+
+
+private:
+	// Cancel proper, with the wind-down (if any) starting at the given time
+	template<typename ListenerType>
+	static bool CancelAt(FSAmmoState& State, const FSAmmoConfig& Config, double CancelTime, ESAmmoCancelTrigger CancelType, ListenerType& Listener) {
+
+		bool Success = false;
+
+		const bool bSkipCancelProcess = (CancelType == ESAmmoCancelTrigger::TriggerByWeaponSwitch) || (CancelType == ESAmmoCancelTrigger::TriggerByExternal);
+		const bool bValidCause = bSkipCancelProcess || (CancelType == ESAmmoCancelTrigger::TriggerByWeaponAction) || (CancelType == ESAmmoCancelTrigger::TriggerByLimitReached);
+
+		if (State.IsReloading() && bValidCause) {
+
+			if (bSkipCancelProcess) {
+
+				Listener.OnReloadCancelled(FSPerBulletReloadPolicy(), CancelType);
+
+				Complete(State);
+
+				Success = true;
+
+			}
+			// Section 2 must have been executed at least once before the weapon owner can cancel, so holding the attack button doesn't constantly trigger and cancel the reload
+			else if (State.PerBulletReloadCycles >= 1 && !State.bReloadIsBeingCancelled) {
+
+				State.bReloadIsBeingCancelled = true;
+				State.Phase = ESAmmoPhase::Winddown;
+				State.PhaseTime = CancelTime + Config.ReloadEndTimeBullet;
+
+				Listener.OnReloadCancelledWithWinddown(Config.ReloadEndTimeBullet);
+
+				Success = true;
+
+			}
+
+		}
+
+		return Success;
+
+	}
+
+	// Resets the reload state once the reload is over
+	static void Complete(FSAmmoState& State) {
+
+		State.Phase = ESAmmoPhase::Idle;
+		State.bReloadIsBeingCancelled = false;
+		State.PerBulletReloadCycles = 0;
+
+	}
+
+};
+
+
+/*
+ *
+ *	No reload: the weapon has no ammo system to speak of, every reload request fails
+ *
+ */
+struct FSNoReloadPolicy {
+
+	// There is never a reload to block firing
+	static constexpr bool bBlocksFiring = false;
+
+	// There are never deadlines
+	static constexpr bool bNeedsDeadlineWhenHidden = false;
+
+	// No reloads
+	static int32_t GetAvailableReloads(const FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		return 0;
+
+	}
+
+	// Initial state of a freshly spawned weapon
+	static void Initialize(FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		State = FSAmmoState();
+		State.BulletsCurrentlyActive = Config.MaximumBullets;
+
+	}
+
+	// Reload is impossible
+	template<typename ListenerType>
+	static bool Trigger(FSAmmoState& State, const FSAmmoConfig& Config, double Now, bool bWeaponIsBusy, ESAmmoCancelTrigger CancelType, ListenerType& Listener) {
+
+		return false;
+
+	}
+
+	// Nothing to advance
+	template<typename ListenerType>
+	static void Advance(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ListenerType& Listener) {
+
+	}
+
+	// Nothing to cancel
+	template<typename ListenerType>
+	static bool Cancel(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ESAmmoCancelTrigger CancelType, ListenerType& Listener) {
+
+		return false;
+
+	}
+
+	// Nothing automatic
+	template<typename ListenerType>
+	static void Activate(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ListenerType& Listener) {
+
+	}
+
+	// No deadlines
+	static double NextDeadline(const FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		return AmmoCoreNoDeadline;
+
+	}
+
+};
+
+
+
+/*
+ *
+ *	Ammo core for a given reload policy; everything common to all reload types (firing/ammo consumption) lives here, the rest is forwarded to the policy at compile time
+ *
+ */
+template<typename PolicyType>
+struct TSAmmoCore {
+
+	// Sets the state of a freshly spawned weapon
+	static void Initialize(FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		PolicyType::Initialize(State, Config);
+
+	}
+
+	// Consumes the requested bullets if possible (partially if allowed), then requests the cancelling of the on-going reload; returns true if any ammo was spent
+	template<typename ListenerType>
+	static bool ConsumeAmmo(FSAmmoState& State, const FSAmmoConfig& Config, double Now, bool bCanBePartial, uint8_t NumToExpend, uint8_t& BulletsTrulyExpended, ListenerType& Listener) {
+
+		bool Success = false;
+
+		// Bring the reload up to date before checking the bullets
+		PolicyType::Advance(State, Config, Now, Listener);
+
+		const bool EnoughBulletsAvailable = (bCanBePartial && (State.BulletsCurrentlyActive > 0)) || (State.BulletsCurrentlyActive >= NumToExpend);
+		const bool IsNotBlockedByReload = !PolicyType::bBlocksFiring || !State.IsReloading();
+
+		if (EnoughBulletsAvailable && IsNotBlockedByReload) {
+
+			// Prevent underflow by expending at most the bullets available
+			BulletsTrulyExpended = static_cast<uint8_t>(std::min<int32_t>(NumToExpend, State.BulletsCurrentlyActive));
+			State.BulletsCurrentlyActive -= BulletsTrulyExpended;
+
+			PolicyType::Cancel(State, Config, Now, ESAmmoCancelTrigger::TriggerByWeaponAction, Listener);
+
+			Listener.OnAmmoChanged(State.BulletsCurrentlyActive, PolicyType::GetAvailableReloads(State, Config));
+
+			Success = true;
+
+		}
+
+		return Success;
+
+	}
+
+	// Requests the start of a reload
+	template<typename ListenerType>
+	static bool Trigger(FSAmmoState& State, const FSAmmoConfig& Config, double Now, bool bWeaponIsBusy, ESAmmoCancelTrigger CancelType, ListenerType& Listener) {
+
+		PolicyType::Advance(State, Config, Now, Listener);
+
+		return PolicyType::Trigger(State, Config, Now, bWeaponIsBusy, CancelType, Listener);
+
+	}
+
+	// Requests the cancelling of the on-going reload
+	template<typename ListenerType>
+	static bool Cancel(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ESAmmoCancelTrigger CancelType, ListenerType& Listener) {
+
+		return PolicyType::Cancel(State, Config, Now, CancelType, Listener);
+
+	}
+
+	// Processes every phase boundary up to Now
+	template<typename ListenerType>
+	static void Advance(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ListenerType& Listener) {
+
+		PolicyType::Advance(State, Config, Now, Listener);
+
+	}
+
+	// Starts the automatic behaviour of the reload type upon weapon activation
+	template<typename ListenerType>
+	static void Activate(FSAmmoState& State, const FSAmmoConfig& Config, double Now, ListenerType& Listener) {
+
+		PolicyType::Advance(State, Config, Now, Listener);
+		PolicyType::Activate(State, Config, Now, Listener);
+
+	}
+
+	// Time of the next phase boundary, AmmoCoreNoDeadline if none
+	static double NextDeadline(const FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		return PolicyType::NextDeadline(State, Config);
+
+	}
+
+	// Leftover magazines/bullets, -1 if uncapped
+	static int32_t GetAvailableReloads(const FSAmmoState& State, const FSAmmoConfig& Config) {
+
+		return PolicyType::GetAvailableReloads(State, Config);
+
+	}
+
+	// Whether the owner must keep a timer on NextDeadline() even when nobody is looking at the weapon
+	static constexpr bool NeedsDeadlineWhenHidden() {
+
+		return PolicyType::bNeedsDeadlineWhenHidden;
+
+	}
+
+};
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+
+
+#include "CoreMinimal.h"
+#include "Gameplay/Weapons/Helpers/WeaponUtilities.h"
+
+
+
+class ASShootingWeapon;
+
+
+
+/*
+ *
+ *	Entry points of a fire mode, plain function pointers bound once per weapon (see FSFireModes::Resolve); pressing, releasing or cancelling the trigger is a single indirect call
+ *
+ */
+struct FSFireModeBinding {
+
+	// Sets up the weapon's fire timing for this mode and registers it in the fire scheduler
+	void (*Initialize)(ASShootingWeapon& Weapon);
+
+	// The primary weapon action button has been pressed
+	void (*Press)(ASShootingWeapon& Weapon);
+
+	// The primary weapon action button has been released
+	void (*Release)(ASShootingWeapon& Weapon);
+
+	// Drops whatever the mode was doing without firing (e.g.: weapon switch)
+	void (*Cancel)(ASShootingWeapon& Weapon);
+
+};
+
+
+
+/*
+ *
+ * Fire mode policies of shooting weapons, one per UShootingWeaponType. Each policy is a self-contained set of static functions (Initialize, Press, Release, Cancel) working on the weapon it is given,
+ * and the shot timing is left to the fire scheduler (USFireSchedulerSubsystem):
+ *		Automatic - repeated fire at the rate of fire while held, the first shot delayed so a quick re-press doesn't beat the rate of fire
+ *		Manual - one shot per press, then firing is blocked for TimeBetweenShotsManual
+ *		Burst - repeated fire while held, firing being blocked for TimeBetweenBursts after every ShotsInBurst shots
+ *		Charge - the shot charges while held and is fired on release with its damage scaled by the charge (at least MinimumChargeFraction of FullChargeTime), then firing is blocked for ChargeCooldown
+ *		Continuous - sustained fire at ContinuousTickRate ticks per second from the press to the release, each tick dealing ShotDamage per second times the tick's duration
+ *
+ * The weapon type is looked at only once, in Resolve(); adding a mode means adding a policy and its case there, nothing else. ASShootingWeapon befriends this struct so the policies can use its internals.
+ *
+ */
+struct FSFireModes {
+
+	struct FSAutomatic;
+	struct FSManual;
+	struct FSBurst;
+	struct FSCharge;
+	struct FSContinuous;
+	struct FSInvalid;
+
+	// Returns the entry points of the fire mode of the given weapon type
+	static const FSFireModeBinding& Resolve(UShootingWeaponType WeaponType);
+
+};
@@ -0,0 +1,170 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+
+
+/*
+ *
+ * Engine-free recoil and spread simulation of shooting weapons. The state (FSRecoilState) only changes when a shot is fired: it is first brought up to the shot's time in fixed steps
+ * (RecoilStepsPerSecond, the recovery of the elapsed steps being applied in closed form), then the shot's offsets are computed from it and its kick is added.
+ * Nothing is simulated per frame, so the result only depends on the shot timestamps, never on the frame rate: a 60 Hz and a 144 Hz client firing at the same times get the same offsets,
+ * and firing the same shot times into a fresh state rebuilds the exact same state (the state is 24 bytes, nothing else has to be sent).
+ *
+ * Randomness (horizontal recoil direction, position in the spread cone) comes from a hash of the weapon's seed and the shot index, never from a random stream whose state would have to be kept in sync.
+ *
+ */
+
+
+
+// Fixed steps per second of the recovery
+static constexpr double RecoilStepsPerSecond = 120.0;
+
+
+/*
+ *
+ *	Recoil and spread configuration of a weapon, built once from its properties (all angles in degrees)
+ *
+ */
+struct FSRecoilConfig {
+
+	// Spread cone half-angle of a weapon at rest, added per shot, and maximum
+	float BaseSpread = 0.0f;
+	float SpreadPerShot = 0.0f;
+	float MaxSpread = 0.0f;
+
+	// Vertical kick per shot and its maximum, horizontal kick per shot (its direction varies from shot to shot) and its maximum either way
+	float RecoilPitchPerShot = 0.0f;
+	float MaxRecoilPitch = 0.0f;
+	float RecoilYawPerShot = 0.0f;
+	float MaxRecoilYaw = 0.0f;
+
+	// Time in seconds for the accumulated spread and recoil to halve once firing stops
+	float RecoveryHalfLife = 0.2f;
+
+	// Seed of the weapon's recoil pattern (the same for every weapon of a type)
+	uint32_t PatternSeed = 0;
+
+};
+
+
+/*
+ *
+ *	Recoil and spread state of a weapon (plain data)
+ *
+ */
+struct FSRecoilState {
+
+	// Spread and recoil accumulated on top of the base spread
+	float AccumulatedSpread = 0.0f;
+	float RecoilPitch = 0.0f;
+	float RecoilYaw = 0.0f;
+
+	// Number of shots fired so far (index of the next shot)
+	uint32_t ShotIndex = 0;
+
+	// Fixed step the state was last brought up to
+	int64_t Step = 0;
+
+};
+
+
+/*
+ *
+ *	Aim offsets of a single shot, in degrees
+ *
+ */
+struct FSRecoilShot {
+
+	// Offset to the pitch and yaw of the aim, recoil and spread together
+	float PitchOffset = 0.0f;
+	float YawOffset = 0.0f;
+
+};
+
+
+/*
+ *
+ *	Recoil and spread simulation proper (static functions only)
+ *
+ */
+struct FSRecoilCore {
+
+	// Brings the state up to the given time, letting the accumulated spread and recoil recover for every elapsed step
+	static void Advance(FSRecoilState& State, const FSRecoilConfig& Config, double Time) {
+
+		const int64_t TargetStep = static_cast<int64_t>(std::floor(Time * RecoilStepsPerSecond));
+
+		if (TargetStep > State.Step) {
+
+			// Recovery per step is constant, so the steps elapsed are applied all at once
+			const double StepsPerHalfLife = std::max(static_cast<double>(Config.RecoveryHalfLife), 1.0e-3) * RecoilStepsPerSecond;
+			const float Recovery = static_cast<float>(std::pow(0.5, static_cast<double>(TargetStep - State.Step) / StepsPerHalfLife));
+
+			State.AccumulatedSpread *= Recovery;
+			State.RecoilPitch *= Recovery;
+			State.RecoilYaw *= Recovery;
+			State.Step = TargetStep;
+
+		}
+
+	}
+
+	// Fires a shot at the given time: returns its aim offsets (the state before its own kick, so a first shot from rest only has the base spread) and adds its kick to the state
+	static FSRecoilShot Fire(FSRecoilState& State, const FSRecoilConfig& Config, double ShotTime) {
+
+		Advance(State, Config, ShotTime);
+
+		const uint32_t Hash = HashShot(Config.PatternSeed, State.ShotIndex);
+
+		// Uniformly distributed point in the spread cone
+		const float Spread = std::min(Config.BaseSpread + State.AccumulatedSpread, std::max(Config.MaxSpread, Config.BaseSpread));
+		const float Radius = Spread * std::sqrt(ToUnit(Hash));
+		const float Angle = 6.2831853f * ToUnit(HashShot(Hash, 0x9E3779B9u));
+
+		FSRecoilShot Shot;
+		Shot.PitchOffset = State.RecoilPitch + Radius * std::sin(Angle);
+		Shot.YawOffset = State.RecoilYaw + Radius * std::cos(Angle);
+
+		// Kick of this shot, felt by the next ones
+		const float YawDirection = (Hash & 1u) ? 1.0f : -1.0f;
+		State.AccumulatedSpread = std::min(State.AccumulatedSpread + Config.SpreadPerShot, std::max(Config.MaxSpread - Config.BaseSpread, 0.0f));
+		State.RecoilPitch = std::min(State.RecoilPitch + Config.RecoilPitchPerShot, Config.MaxRecoilPitch);
+		State.RecoilYaw = std::max(std::min(State.RecoilYaw + YawDirection * Config.RecoilYawPerShot, Config.MaxRecoilYaw), -Config.MaxRecoilYaw);
+		++State.ShotIndex;
+
+		return Shot;
+
+	}
+
+
+
+private:
+	// Mixes the seed and the shot index into well-distributed bits
+	static uint32_t HashShot(uint32_t Seed, uint32_t ShotIndex) {
+
+		uint32_t Hash = Seed ^ (ShotIndex * 0x85EBCA6Bu);
+		Hash ^= Hash >> 16;
+		Hash *= 0x7FEB352Du;
+		Hash ^= Hash >> 15;
+		Hash *= 0x846CA68Bu;
+		Hash ^= Hash >> 16;
+
+		return Hash;
+
+	}
+
+	// Maps hash bits to [0, 1)
+	static float ToUnit(uint32_t Hash) {
+
+		return static_cast<float>(Hash >> 8) * (1.0f / 16777216.0f);
+
+	}
+
+};
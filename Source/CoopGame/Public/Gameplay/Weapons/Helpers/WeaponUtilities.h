@@ -27,6 +27,9 @@
  *		AutomaticFire = weapon action can be held continuously and the weapon will shoot as long as bullets are available
  *		SingleShotFire = weapon action is only executed at the moment the respective button is pressed, holding it will yield no further action (however, there still is a maximum rate of fire to stop spam)
  *		BurstFire = weapon action causes a given number of bullets to be fired in quick succession much as if the weapon were of AutomaticFire type, but stops for a moment after that time is fulfilled before firing again; this continues until ammo is deplated
+ *		ChargeFire = weapon action charges the shot while held and fires it on release, its damage scaled by how long it was charged; releasing before the minimum charge fires nothing
+ *		ContinuousFire = weapon action fires a sustained stream (e.g.: a beam) from the moment it is pressed until it is released, consuming ammo and dealing damage per second at a fixed tick rate
+ *	Every type is implemented by a fire mode policy (see FSFireModes)
  *	
  */
 UENUM(BlueprintType)
@@ -35,7 +38,9 @@ enum class UShootingWeaponType : uint8 {
 	Invalid = 0,
 	AutomaticFire = 1,
 	ManualFire = 2,
-	BurstFire = 3
+	BurstFire = 3,
+	ChargeFire = 4,
+	ContinuousFire = 5
 	
 };
 
@@ -104,26 +109,27 @@ struct FLoadoutInfo {
 
 	
 public:
-	// Information for Weapon in slot 1
-	FSEquipmentInfoHUD Weapon1Info;
-
-	// Information for Weapon in slot 2
-	FSEquipmentInfoHUD Weapon2Info;
-
-	// Information for Weapon in slot 3
-	FSEquipmentInfoHUD Weapon3Info;
+	// Information for the weapon in every slot of the loadout (index 0 is slot 1), one entry per slot whether it is equipped or not
+	TArray<FSEquipmentInfoHUD> WeaponInfos;
 
 	// Information for Skill
 	FSEquipmentInfoHUD SkillInfo;
 	
 	// Constructor
 	FLoadoutInfo() :
-		Weapon1Info(),
-		Weapon2Info(),
-		Weapon3Info(),
+		WeaponInfos(),
 		SkillInfo() {
 		
 	}
+
+	// Constructor, with an empty entry for each of the given number of weapon slots
+	explicit FLoadoutInfo(int32 NumWeaponSlots) :
+		WeaponInfos(),
+		SkillInfo() {
+
+		WeaponInfos.AddDefaulted(NumWeaponSlots);
+		
+	}
 	
 };
 
@@ -14,6 +14,7 @@ class UDamageType;
 class UParticleSystem;
 class UCameraShakeBase;
 class ASPlayerCharacter;
+struct FSAmmoSnapshot;
 
 
 
@@ -27,6 +28,9 @@ class ASPlayerCharacter;
  *		Trigger Reload Functionality (Reload key)
  *
  *		It also stores information common to all weapons, such as weapon name, information for the player display, socket information, damage type and quantity, and exposes them when necessary
+ *
+ *		Inactive weapons hibernate (unless bHibernateWhenInactive is unset): the weapon and its mesh stop ticking, the skeleton and animations are no longer updated and non-essential components (e.g.: effect emitters) are unregistered.
+ *		Nothing that matters is lost in the process, as the state that keeps evolving while holstered (e.g.: passive reload) is derived from timestamps rather than ticked. Waking up is timed and reported when over ReactivationBudgetMs.
  * 
  */
 UCLASS()
@@ -63,6 +67,15 @@ public:
 	// Perform necessary actions to make a weapon unable to be used in gameplay
 	bool DeactivateWeapon();
 
+	// Puts the weapon to sleep or wakes it up (no-op if it already is in the requested state); waking up is timed against ReactivationBudgetMs
+	void SetHibernating(bool bHibernate);
+
+	// Gets an inactive weapon ready to be switched to, so its activation is only a state flip (Super should always be called on child classes!)
+	virtual void PrewarmWeapon(void);
+
+	// Puts an inactive weapon back to sleep after a pre-warm that wasn't followed by a switch
+	void CoolDownWeapon(void);
+
 	// Function to be defined by child classes for automatic activation of weapon stereotype/specific actions (Super should always be called on child classes!)
 	virtual void TriggerAutomaticActions(void);
 
@@ -71,6 +84,15 @@ public:
 
 	// Returns the reload type of this weapon (NoReload by default, should be overwritten by child classes if they have a reload system)
 	virtual UReloadType GetReloadType() const;
+
+	// Takes a snapshot of this weapon's ammo state; returns false if the weapon has no ammo state (default, should be overwritten by child classes with an ammo system)
+	virtual bool CaptureAmmoSnapshot(FSAmmoSnapshot& OutSnapshot);
+
+	// Restores a snapshot of this weapon's ammo state; returns false if the weapon has no ammo state or the snapshot doesn't fit it (default, should be overwritten by child classes with an ammo system)
+	virtual bool RestoreAmmoSnapshot(const FSAmmoSnapshot& Snapshot);
+
+	// Starts this weapon's ammo state anew, as if the weapon had just been spawned; returns false if the weapon has no ammo state (default, should be overwritten by child classes with an ammo system)
+	virtual bool ResetAmmoState(void);
 	
 	// Get the name of the socket to which the weapon shall attach to
 	FORCEINLINE const FName& GetCharacterSocketName() const;
@@ -81,6 +103,9 @@ public:
 	// Get the weapon's activity status
 	FORCEINLINE bool IsWeaponActive() const;
 
+	// Get the weapon's hibernation status
+	FORCEINLINE bool IsWeaponHibernating() const;
+
 	// Mesh of the weapon
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	USkeletalMeshComponent* MeshComp;
@@ -95,6 +120,12 @@ public:
 protected:
 	// Function to be defined by child classes for cancelling of weapon stereotype/specific actions (Super should always be called on child classes!)
 	virtual void CancelOngoingActions(void);
+
+	// Function to be extended by child classes to put their own components to sleep or wake them up (Super should always be called on child classes!)
+	virtual void SetComponentsHibernating(bool bHibernating);
+
+	// Unregisters a non-essential component while hibernating and registers it back on wake-up
+	static void SetComponentRegistered(UActorComponent* Component, bool bRegistered);
 	
 	// Name of the weapon
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attachment")
@@ -120,7 +151,18 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Damage", meta = (ClampMin = 1.0, ClampMax = 100.0))
 	float ShotDamage;
 
+	// Whether the weapon hibernates while inactive
+	UPROPERTY(EditDefaultsOnly, Category = "Performance")
+	bool bHibernateWhenInactive;
+
+	// Time in milliseconds the wake-up of a hibernating weapon is expected to stay under (a warning is logged if it doesn't)
+	UPROPERTY(EditDefaultsOnly, Category = "Performance", meta = (EditCondition = "bHibernateWhenInactive", ClampMin = 0.01, ClampMax = 10.0))
+	float ReactivationBudgetMs;
+
 	// Represents the current active status of the weapon (if it's been selected for use by the player)
 	bool IsActive;
+
+	// Represents the current hibernation status of the weapon
+	bool bIsHibernating;
 	
 };
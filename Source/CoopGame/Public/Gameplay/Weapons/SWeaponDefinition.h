@@ -0,0 +1,235 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Gameplay/Weapons/Helpers/WeaponUtilities.h"
+#include "SWeaponDefinition.generated.h"
+
+
+
+class UParticleSystem;
+
+
+
+/*
+ *
+ * Shared, read-only definition of a shooting weapon type: fire parameters, muzzle effect and ammo/reload settings. A single asset is referenced by every weapon of that type (see ASShootingWeapon::WeaponDefinition),
+ * which reads its parameters through it (see ReadTuning) instead of keeping a copy of its own.
+ * Definitions are primary assets (type "WeaponDefinition", scanned in /Game/Weapons/Definitions), preloaded with their "Game" bundle (the effects) on every machine when the game instance starts
+ * (see USWeaponDefinitionsSubsystem), so no weapon has to load anything when it is spawned.
+ *
+ */
+UCLASS(BlueprintType, Const)
+class COOPGAME_API USWeaponDefinition : public UPrimaryDataAsset {
+
+	GENERATED_BODY()
+
+
+public:
+	// Sets default values for this definition's properties
+	USWeaponDefinition();
+
+	// Primary asset type of every weapon definition
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	// Bundle holding the assets needed in game (effects)
+	static const FName GameBundle;
+
+	// Identifies the definition to the asset manager
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	// Returns the given parameter of the definition if there is one, the fallback otherwise (the weapon's own property, for weapons still tuned in their Blueprint)
+	template<typename ValueType>
+	static FORCEINLINE const ValueType& ReadTuning(const USWeaponDefinition* Definition, ValueType USWeaponDefinition::* Parameter, const ValueType& Fallback) {
+
+		return Definition ? Definition->*Parameter : Fallback;
+
+	}
+
+
+	// Fire parameters (see ASShootingWeapon)
+
+	// Type of the weapon
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon Parameters | General")
+	UShootingWeaponType WeaponType;
+
+	// Amount of ammo consumed every time this weapon is fired
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | General", meta = (ClampMin = 1, ClampMax = 100))
+	uint8 BulletPerAttack;
+
+	// Whether the weapon can fire with less ammo than BulletPerAttack
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | General", meta = (EditCondition = "BulletPerAttack > 1"))
+	bool bCanPartialFire;
+
+	// Rate of fire variable for automatic weapons, number of bullets shot per second
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Automatic", meta = (EditCondition = "WeaponType == UShootingWeaponType::AutomaticFire", ClampMin = 0.01, ClampMax = 50.0))
+	float RateOfFireAutomatic;
+
+	// Time between shots of manual weapons, in seconds
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Manual", meta = (EditCondition = "WeaponType == UShootingWeaponType::ManualFire", ClampMin = 0.01, ClampMax = 10.0))
+	float TimeBetweenShotsManual;
+
+	// Number of shots in a burst
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Burst", meta = (EditCondition = "WeaponType == UShootingWeaponType::BurstFire", ClampMin = 1, ClampMax = 10))
+	uint8 ShotsInBurst;
+
+	// Rate of fire variable for burst weapons, number of bullets shot per second
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Burst", meta = (EditCondition = "WeaponType == UShootingWeaponType::BurstFire", ClampMin = 0.01, ClampMax = 50.0))
+	float RateOfFireBurst;
+
+	// Time between bursts of fire in burst-mode, in seconds
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Burst", meta = (EditCondition = "WeaponType == UShootingWeaponType::BurstFire", ClampMin = 0.10, ClampMax = 5.0))
+	float TimeBetweenBursts;
+
+	// Time in seconds for a shot to be fully charged
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Charge", meta = (EditCondition = "WeaponType == UShootingWeaponType::ChargeFire", ClampMin = 0.05, ClampMax = 10.0))
+	float FullChargeTime;
+
+	// Fraction of the full charge below which releasing fires nothing (the damage of a shot is scaled by its charge fraction)
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Charge", meta = (EditCondition = "WeaponType == UShootingWeaponType::ChargeFire", ClampMin = 0.0, ClampMax = 1.0))
+	float MinimumChargeFraction;
+
+	// Time in seconds during which firing is blocked after a charged shot
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Charge", meta = (EditCondition = "WeaponType == UShootingWeaponType::ChargeFire", ClampMin = 0.0, ClampMax = 10.0))
+	float ChargeCooldown;
+
+	// Number of times per second a continuous weapon fires
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Continuous", meta = (EditCondition = "WeaponType == UShootingWeaponType::ContinuousFire", ClampMin = 1.0, ClampMax = 60.0))
+	float ContinuousTickRate;
+
+
+	// Recoil and spread (all angles in degrees, 0 disables them)
+
+	// Half-angle of the spread cone when the weapon is at rest
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 30.0))
+	float BaseSpread;
+
+	// Spread added by every shot, and maximum half-angle of the spread cone
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 10.0))
+	float SpreadPerShot;
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 30.0))
+	float MaxSpread;
+
+	// Upwards kick of every shot, and maximum accumulated upwards kick
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 10.0))
+	float RecoilPitchPerShot;
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 45.0))
+	float MaxRecoilPitch;
+
+	// Sideways kick of every shot, and maximum accumulated sideways kick either way
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 10.0))
+	float RecoilYawPerShot;
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 45.0))
+	float MaxRecoilYaw;
+
+	// Time in seconds for the accumulated spread and recoil to halve once the weapon stops firing
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.01, ClampMax = 5.0))
+	float RecoilRecoveryHalfLife;
+
+
+	// Muzzle effect
+
+	// Particle effect to be emitted when the weapon is fired, loaded with the game bundle
+	UPROPERTY(EditDefaultsOnly, Category = "VFX", meta = (AssetBundles = "Game"))
+	TSoftObjectPtr<UParticleSystem> MuzzleEffect;
+
+	// Scale vector to be applied to the MuzzleEffect particle system when weapon is fired (it is recommended this vector is uniform)
+	UPROPERTY(EditDefaultsOnly, Category = "VFX")
+	FVector MuzzleEffectScale;
+
+	// Name of socket from which MuzzleParticleEffect shall be emitted
+	UPROPERTY(EditDefaultsOnly, Category = "VFX")
+	FName MuzzleSocketName;
+
+
+	// Ammo and reload settings (see USAmmoSystemComponent)
+
+	// Variable that states what reload rules does the ammo system follow
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Type")
+	UReloadType ReloadType;
+
+	// If true, reloading is done without player actively triggering it after a certain delay; otherwise, reload needs to be triggered via the "Reload" key
+	UPROPERTY(EditDefaultsOnly, Category = "Reload")
+	bool bIsPassiveReload;
+
+	// Maximum number of bullets that can be restored via passive regeneration
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Passive", meta = (EditCondition = "ReloadType == UReloadType::PassiveReload", ClampMin = 1, ClampMax = 255))
+	uint8 MaximumPassiveCapacity;
+
+	// Time in seconds for the delay between a weapon's most recent action and passive reload being possible
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Passive", meta = (EditCondition = "ReloadType == UReloadType::PassiveReload", ClampMin = 0.01, ClampMax = 300.0))
+	float PassiveReloadDelay;
+
+	// Time in seconds for a single bullet to regenerate passively
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Passive", meta = (EditCondition = "ReloadType == UReloadType::PassiveReload", ClampMin = 0.01, ClampMax = 300.0))
+	float ReloadTimePassive;
+
+	// If true, reloading a magazine can be halted by pressing the "Reload" key during reloading; otherwise, the act of reloading can only be halted by switching the weapon
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Magazine", meta = (EditCondition = "ReloadType == UReloadType::ActiveMagazineReload"))
+	bool bEnableMagazineReloadCancel;
+
+	// Total number of bullets in a single magazine
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Magazine", meta = (EditCondition = "ReloadType == UReloadType::ActiveMagazineReload", ClampMin = 1, ClampMax = 1000))
+	int32 BulletPerMagazine;
+
+	// Time in seconds for the ammo to be added after reload is triggered, should be lower than FullReloadTimeMagazine
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Magazine", meta = (EditCondition = "ReloadType == UReloadType::ActiveMagazineReload", ClampMin = 0.01, ClampMax = 30.0))
+	float BulletsReloadTimeMagazine;
+
+	// Time in seconds after the bullet reload time for the action of magazine reloading to be finalized
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Magazine", meta = (EditCondition = "ReloadType == UReloadType::ActiveMagazineReload", ClampMin = 0.01, ClampMax = 30.0))
+	float WinddownReloadTimeMagazine;
+
+	// If true, there is a maximum of magazines (and hence, reloads) available per life; otherwise, magazine reloads can be done infinitely within a single life
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Magazine", meta = (EditCondition = "ReloadType == UReloadType::ActiveMagazineReload"))
+	bool bCapMagazinesPerLife;
+
+	// Total number of magazines available to a player per life (initially available magazines included)
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Magazine", meta = (EditCondition = "ReloadType == UReloadType::ActiveMagazineReload && bCapMagazinesPerLife", ClampMin = 1, ClampMax = 100))
+	uint8 MagazinesPerLife;
+
+	// Number of bullets restored per reload
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Bullet-per-bullet", meta = (EditCondition = "ReloadType == UReloadType::ActivePerBulletReload", ClampMin = 1, ClampMax = 10))
+	uint8 BulletPerReload;
+
+	// Maximum number of bullets that can be restored after reload is triggered (must be a multiple of BulletPerReload)
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Bullet-per-bullet", meta = (EditCondition = "ReloadType == UReloadType::ActivePerBulletReload", ClampMin = 1, ClampMax = 255))
+	uint8 MaximumBulletCapacity;
+
+	// Time in seconds for the initial delay before reloading starts proper on weapons with X-bullets-per-X-bullets
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Bullet-per-bullet", meta = (EditCondition = "ReloadType == UReloadType::ActivePerBulletReload", ClampMin = 0.01, ClampMax = 10.0))
+	float ReloadDelayTimeBullet;
+
+	// Time in seconds for the action of reloading BulletPerReload bullets on weapons with X-bullets-per-X-bullets
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Bullet-per-bullet", meta = (EditCondition = "ReloadType == UReloadType::ActivePerBulletReload", ClampMin = 0.01, ClampMax = 10.0))
+	float ReloadTimeBullet;
+
+	// Time in seconds for the delay before weapon is available after reloading is cancelled on weapons with X-bullets-per-X-bullets
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Bullet-per-bullet", meta = (EditCondition = "ReloadType == UReloadType::ActivePerBulletReload", ClampMin = 0.01, ClampMax = 10.0))
+	float ReloadEndTimeBullet;
+
+	// If true, there is a maximum of bullets per player life for this weapon; otherwise, X-bullets-per-X-bullets reloads can be done infinitely within a single life
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Bullet-per-bullet", meta = (EditCondition = "ReloadType == UReloadType::ActivePerBulletReload"))
+	bool bCapBulletsPerLife;
+
+	// Total number of bullets available to a player per life (initially available bullets included)
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Bullet-per-bullet", meta = (EditCondition = "ReloadType == UReloadType::ActivePerBulletReload && bCapBulletsPerLife", ClampMin = 1, ClampMax = 10000))
+	int32 BulletsPerLife;
+
+	// If true, the act of reloading stops all player movement, overriding bStopSpecialMovement
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Other Actions", meta = (EditCondition = "ReloadType == UReloadType::ActiveMagazineReload || ReloadType == UReloadType::ActivePerBulletReload"))
+	bool bStopAllMovement;
+
+	// If true, the act of reloading stops all other weapon actions, primary and secondary both; movement actions stay unchanged
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Other Actions", meta = (EditCondition = "ReloadType == UReloadType::ActiveMagazineReload || ReloadType == UReloadType::ActivePerBulletReload"))
+	bool bStopWeaponActions;
+
+	// If true, reloading stops only special player movement actions (dashing, walljump, etc)
+	UPROPERTY(EditDefaultsOnly, Category = "Reload | Other Actions", meta = (EditCondition = "ReloadType == UReloadType::ActiveMagazineReload || ReloadType == UReloadType::ActivePerBulletReload"))
+	bool bStopSpecialMovement;
+
+};
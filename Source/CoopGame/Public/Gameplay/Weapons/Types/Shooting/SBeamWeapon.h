@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SShootingWeapon.h"
+#include "SBeamWeapon.generated.h"
+
+
+
+/*
+ *
+ *	Damage dealt by the beam to a single target since the last damage batch
+ *
+ */
+struct FSBeamDamageEntry {
+
+	// Actor being damaged
+	TWeakObjectPtr<AActor> Target;
+
+	// Damage accumulated since the last batch
+	float Damage;
+
+	// Most recent hit on the target and direction of the beam at that moment, used when the damage is applied
+	FHitResult Hit;
+	FVector ShotDirection;
+
+};
+
+
+
+/*
+ *
+ * This class implements continuous beam weapons (ContinuousFire by default). The beam is swept at the weapon's fixed tick rate (ContinuousTickRate, scheduled by the fire scheduler, independent
+ * of the frame rate), and every sweep adds its share of the damage (ShotDamage per second) to the target it touches instead of applying it right away.
+ * The accumulated damage is applied in batches, once per target every SweepsPerDamageBatch sweeps and whenever the beam stops (released, switched away from, or refused a sweep), so a beam held on a target costs one ApplyPointDamage per batch
+ * rather than one per sweep. The beam visual is a single persistent emitter attached to the muzzle, activated while firing and re-targeted on every sweep.
+ *
+ */
+UCLASS()
+class COOPGAME_API ASBeamWeapon : public ASShootingWeapon {
+
+	GENERATED_BODY()
+
+
+public:
+	// Sets default values for this actor's properties
+	ASBeamWeapon();
+
+	// Execute the releasing action of this weapon's primary action
+	virtual void OnPrimaryWeaponActionReleased() override;
+
+	// Gets an inactive beam weapon ready to be switched to, its beam emitter included
+	virtual void PrewarmWeapon(void) override;
+
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	// Called when the game ends or the weapon is destroyed
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Implements the cancelling of actions common to all beam weapons
+	virtual void CancelOngoingActions(void) override;
+
+	// Puts the beam emitter to sleep or wakes it up, along with the components common to all shooting weapons
+	virtual void SetComponentsHibernating(bool bHibernating) override;
+
+	// Fires a sweep of the beam like any other shooting weapon; a sweep that is refused (out of ammo, reloading, firing blocked) turns the beam off and applies the damage dealt so far
+	virtual bool FireWeapon(bool bFiringBlocked, double ShotTime) override;
+
+	// Implements the logic specific to this subclass of shooting weapon; in this case, a sweep of the beam whose damage is accumulated on the target
+	virtual bool HandleSpecificFiring(const uint8& BulletsConsumed) override;
+
+	// Maximum length of the beam
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Beam", meta = (ClampMin = 100.0, ClampMax = 20000.0))
+	float BeamRange;
+
+	// Radius of the beam's sweep (0 for a plain line trace)
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Beam", meta = (ClampMin = 0.0, ClampMax = 100.0))
+	float BeamRadius;
+
+	// Number of sweeps whose damage is accumulated before it is applied
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Beam", meta = (ClampMin = 1, ClampMax = 60))
+	uint8 SweepsPerDamageBatch;
+
+	// Particle effect of the beam, kept active while firing
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "VFX")
+	UParticleSystem* BeamEffect;
+
+	// Name of particle system property for the target of the BeamEffect emitter
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "VFX")
+	FName BeamTargetName;
+
+	// Persistent beam emitter, attached to the muzzle
+	UPROPERTY()
+	UParticleSystemComponent* BeamVFXComp;
+
+
+private:
+	// Sweeps the beam from the owner's point of view; returns true if it touched anything, along with the hit and the beam's end
+	bool SweepBeam(FHitResult& Hit, FVector& ShotDirection, FVector& BeamEnd);
+
+	// Adds the damage of one sweep to the accumulated damage of the target that was hit
+	void AccumulateBeamDamage(const FHitResult& Hit, const FVector& ShotDirection);
+
+	// Applies the accumulated damage, once per target, and starts a new batch
+	void ApplyBeamDamage();
+
+	// Creates the persistent beam emitter and attaches it to the muzzle socket (done only once)
+	void SetupBeamEffect();
+
+	// Shows or hides the beam
+	void SetBeamEffectActive(bool bActive);
+
+	// Damage accumulated in the current batch, one entry per target (a beam rarely touches more than a couple of targets per batch)
+	TArray<FSBeamDamageEntry> PendingBeamDamage;
+
+	// Number of sweeps in the current batch
+	uint8 SweepsInDamageBatch;
+
+};
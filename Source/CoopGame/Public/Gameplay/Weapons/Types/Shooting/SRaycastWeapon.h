@@ -8,10 +8,32 @@
 
 
 
+/*
+ *
+ *	Actor pierced by a rail-gun shot, with the damage it takes (already reduced by the penetrations before it)
+ *
+ */
+struct FSPiercedTarget {
+
+	// Actor pierced
+	AActor* Target;
+
+	// Damage dealt to it
+	float Damage;
+
+	// Index in the trace's hits of the first hit on the actor
+	int32 HitIndex;
+
+};
+
+
+
 /*
  *
 * This class implements the specifics of shooting weapons that use raycasts to determine if there are any damageable actors in a pseudo-projectile's path, for weapons that are designed to have fast-moving projectiles.
  * For this purpose, it overrides the HandleSpecificFiring function to do raycast-specific operations, and implements helper functions that deal with firing aspects specific to ShootingWeapons (bullet path, impact effects VFX) and extra hit effects.
+ * Rail-gun weapons (bPiercingShot) pierce every actor along the line until level geometry stops the shot: a single multi-hit query collects them in order, each penetration deals less damage
+ * than the previous one (PenetrationDamageFalloff), and the damage is applied as one batch, nearest actor first, with one impact effect per actor and one tracer per shot.
  * For the moment, this class also implements a zoom-in/zoom-out functionality for the Secondary Weapon Action button (Right Mouse Button).
  * 
  */
@@ -33,9 +55,15 @@ public:
 
 	
 protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
 	// Implements the cancelling of actions common to all raycast weapons
 	virtual void CancelOngoingActions(void) override;
 
+	// Puts the tracer emitter to sleep or wakes it up, along with the components common to all shooting weapons
+	virtual void SetComponentsHibernating(bool bHibernating) override;
+
 	// Implements the logic specific to this subclass of shooting weapon; in this case, it implements the raycast hit detection
 	// the overload allows us to trace more than one ray at a time
 	virtual bool HandleSpecificFiring(const uint8& BulletsConsumed) override;
@@ -48,6 +76,28 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "VFX")
 	FName TracerTargetName;
 
+	// Automatic weapons only show a tracer every N rounds (the count carries over between trigger pulls), which keeps the tracer density constant independently of the rate of fire
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "VFX", meta = (EditCondition = "WeaponType == UShootingWeaponType::AutomaticFire", ClampMin = 1, ClampMax = 10))
+	uint8 TracerEveryNRounds;
+
+	// Persistent tracer emitter of automatic weapons, attached to the muzzle and re-triggered instead of spawning one emitter per tracer
+	UPROPERTY()
+	UParticleSystemComponent* TracerVFXComp;
+
+	// Rail-gun
+
+	// If true, the shot pierces every actor in its path until it reaches the level's static geometry
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Rail-gun")
+	bool bPiercingShot;
+
+	// Maximum number of actors a single shot can pierce
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Rail-gun", meta = (EditCondition = "bPiercingShot", ClampMin = 1, ClampMax = 32))
+	uint8 MaxPenetrations;
+
+	// Damage multiplier applied for every actor already pierced by the shot (1 = no falloff)
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Rail-gun", meta = (EditCondition = "bPiercingShot", ClampMin = 0.0, ClampMax = 1.0))
+	float PenetrationDamageFalloff;
+
 	// Particle effect to be emitted if the raycast hits SurfaceType1 (FleshDefault)
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "VFX")
 	UParticleSystem* DefaultImpactEffect;
@@ -62,13 +112,27 @@ private:
 	// Returns true if the raycast was successfully executed; also returns the hit information and whether it has collided with anything on the COLLISION_WEAPON channel, trace direction and information about the player character (where it's looking towards)
 	bool ExecuteRaycast(bool& BlockingHit, FHitResult& Hit, FVector& EyeLocation, FRotator& EyeRotation, FVector& TraceEnd);	
 
-	// Function that determine the damage and special effects that will effect the hit component (only doing damage rn)
-	virtual float CalculateHitEffect(const EPhysicalSurface& HitSurfaceType);
+	// Casts a single multi-hit ray in the direction the player character is looking towards, collecting every hit (nearest first) up to the level's static geometry
+	// Returns true if the raycast was successfully executed; also returns the trace direction and information about the player character (where it's looking towards)
+	bool ExecutePiercingRaycast(TArray<FHitResult>& Hits, FVector& EyeLocation, FRotator& EyeRotation, FVector& TraceEnd);
+
+	// Fires a rail-gun shot: one multi-hit query, damage with falloff per penetration applied as one ordered batch, one impact effect per actor pierced and one tracer
+	bool FirePiercingShot(void);
 
 	// Function that triggers the emitting of the particle effects and sound effects on raycast hit
 	virtual void PlayImpactEffects(EPhysicalSurface SurfaceType, const FVector& HitLocation, const FRotator& HitRotation);
 
 	// Emit the tracer effect with the muzzle socket name as source location, then set target location via parameter setting
 	virtual void PlayTraceEffect(const FVector& ShotTraceEnd);
+
+	// Creates the persistent tracer emitter of automatic weapons and attaches it to the muzzle socket (done only once)
+	void SetupTracerEffect();
+
+	// Number of rounds fired since the last tracer was shown (automatic weapons only)
+	uint8 RoundsSinceLastTracer;
+
+	// Hits and pierced actors of the current rail-gun shot, kept to re-use their memory from shot to shot
+	TArray<FHitResult> PiercingHits;
+	TArray<FSPiercedTarget> PiercedTargets;
 	
 };
@@ -4,19 +4,31 @@
 
 #include "CoreMinimal.h"
 #include "Gameplay/Weapons/SWeapon.h"
+#include "Gameplay/Weapons/Helpers/FireModes.h"
+#include "Gameplay/Weapons/Helpers/RecoilCore.h"
+#include "Gameplay/Weapons/SWeaponDefinition.h"
 #include "SShootingWeapon.generated.h"
 
 
 
 class USAmmoSystemComponent;
+class UParticleSystemComponent;
+class USFireSchedulerSubsystem;
 
 /**
  *
  * Parent class for all weapons with shooting mechanics such as Ammo management (which in turn is implemented via the USAmmoSystemComponent class, ubiquitous in shooting weapons), and projectile fire.
- * It implements all logic related to control of weapon fire (frequency, damage, how it's triggered) and delegates the handling of weapon reload to the Ammo System Component. For control of weapon fire, the developer can specify whether firing mode they prefer out of the following three:
+ * It implements all logic related to control of weapon fire (frequency, damage, how it's triggered) and delegates the handling of weapon reload to the Ammo System Component. For control of weapon fire, the developer can specify whether firing mode they prefer out of the following:
  *		Automatic Fire - Weapon fires continuously until there is no more ammo or the Weapon Action button is released; the rate of fire can be configured by the developer
  *		Manual Fire - Weapon fires only upon Weapon Action button press and after a given time has passed (rate of fire)
  *		Burst Fire - Weapon fires a configurable number of times with a configurable rate of fire; after it has fired that period, firing is disabled for a short period of time
+ *		Charge Fire - Weapon charges while the Weapon Action button is held and fires on release, with damage scaled by the charge
+ *		Continuous Fire - Weapon fires a sustained stream at a fixed tick rate while the Weapon Action button is held, its damage being per second
+ *
+ * Each firing mode is a fire mode policy (see FSFireModes), resolved once in BeginPlay; pressing or releasing the Weapon Action button is a single call through its entry points.
+ * When a weapon definition (USWeaponDefinition) is assigned, the fire parameters, muzzle effect and ammo settings are read through it (see GetTuning) rather than from the properties below, which remain as the fallback.
+ * The timing of the shots (trigger state, rate of fire, bursts and firing blocks) is handled by the world's fire scheduler (USFireSchedulerSubsystem), which calls FireWeapon() for every shot that comes due.
+ * Spread and recoil are simulated per shot from the shot's scheduled time (see FSRecoilCore), never per frame, and child classes apply the resulting aim offset through GetShotAimRotation().
  * 
  */
 UCLASS()
@@ -24,6 +36,9 @@ class COOPGAME_API ASShootingWeapon : public ASWeapon {
 
 	GENERATED_BODY()
 
+	friend class USFireSchedulerSubsystem;
+	friend struct FSFireModes;
+
 
 public:
 	// Sets default values for this actor's properties
@@ -44,31 +59,72 @@ public:
 	// Requests broadcast of information from the subcomponents after this weapon's activation has been confirmed to be successful and broadcast
 	virtual void RequestSubcomponentBroadcast(void) override;
 
+	// Gets an inactive shooting weapon ready to be switched to, its muzzle flash emitter included
+	virtual void PrewarmWeapon(void) override;
+
 	// Returns the reload type of this weapon (forwards ReloadType from AmmoSysComp)
 	virtual UReloadType GetReloadType() const override;
 
+	// Takes a snapshot of this weapon's ammo state; returns false if the weapon has no ammo state (default, should be overwritten by child classes with an ammo system)
+	virtual bool CaptureAmmoSnapshot(FSAmmoSnapshot& OutSnapshot) override;
+
+	// Restores a snapshot of this weapon's ammo state; returns false if the weapon has no ammo state or the snapshot doesn't fit it (default, should be overwritten by child classes with an ammo system)
+	virtual bool RestoreAmmoSnapshot(const FSAmmoSnapshot& Snapshot) override;
+
+	// Starts this weapon's ammo state anew, as if the weapon had just been spawned; returns false if the weapon has no ammo state (default, should be overwritten by child classes with an ammo system)
+	virtual bool ResetAmmoState(void) override;
+
+	// Returns the recoil and spread configuration of this weapon, the same on every machine
+	const FSRecoilConfig& GetRecoilConfig() const { return RecoilConfig; }
+
+	// Returns the current recoil and spread state of this weapon
+	const FSRecoilState& GetRecoilState() const { return RecoilState; }
+
 	// Component that handles everything related to weapon ammo (bullets available to fire, reload, etc)
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	USAmmoSystemComponent* AmmoSysComp;
 
-	// Timer used to control the time between shots (used in automatic and burst shooting weapon types only)
-	FTimerHandle TimerHandle_TimeBetweenShots;
-
-	// Timer used to control the time between bursts (used in burst shooting weapon types only)
-	FTimerHandle TimerHandle_TimeBetweenBursts;
-
 	
 protected:
+	// Points the ammo system to the weapon definition, if any, once the components are initialized (before BeginPlay)
+	virtual void PostInitializeComponents() override;
+
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+
+	// Called when the game ends or the weapon is destroyed
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	// Implements the cancelling of actions common to all shooting weapons
 	virtual void CancelOngoingActions(void) override;
 
+	// Puts the components common to all shooting weapons to sleep or wakes them up (the muzzle flash emitter is unregistered while hibernating)
+	virtual void SetComponentsHibernating(bool bHibernating) override;
+
+	// Called by the fire scheduler for every shot that comes due while the primary weapon action button is pressed, with the time the shot was due at; returns true if the shot counts towards a burst
+	virtual bool FireWeapon(bool bFiringBlocked, double ShotTime);
+
 	// Polymorphic function that handles the specifics of the weapon being fired (e.g: raycast vs actor spawning)
 	virtual bool HandleSpecificFiring(const uint8& BulletsConsumed);
 
+	// Function that determine the damage and special effects that will effect the hit component (only doing damage rn)
+	virtual float CalculateHitEffect(const EPhysicalSurface& HitSurfaceType);
+
+	// Returns the given aim rotation offset by the recoil and spread of the shot being fired
+	FRotator GetShotAimRotation(const FRotator& AimRotation) const;
+
+	// Reads a parameter through the weapon definition if there is one, from the given property of this weapon otherwise
+	template<typename ValueType>
+	FORCEINLINE const ValueType& GetTuning(ValueType USWeaponDefinition::* Parameter, const ValueType& Fallback) const { return USWeaponDefinition::ReadTuning(WeaponDefinition, Parameter, Fallback); }
+
+	// Returns the muzzle effect of the weapon definition (preloaded with its game bundle) if there is one, MuzzleEffect otherwise
+	UParticleSystem* GetMuzzleEffect() const;
+
 	// Weapon attack parameters
+
+	// Shared definition of this weapon type; when set, it overrides the parameters below and the ammo system's settings
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon Parameters | General")
+	const USWeaponDefinition* WeaponDefinition;
 	
 	// Type of the weapon
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon Parameters | General")
@@ -111,6 +167,57 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Burst", meta = (EditCondition = "WeaponType == UShootingWeaponType::BurstFire", ClampMin = 0.10, ClampMax = 5.0))
 	float TimeBetweenBursts;
 
+
+	// Charge
+
+	// Time in seconds for a shot to be fully charged
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Charge", meta = (EditCondition = "WeaponType == UShootingWeaponType::ChargeFire", ClampMin = 0.05, ClampMax = 10.0))
+	float FullChargeTime;
+
+	// Fraction of the full charge below which releasing fires nothing (the damage of a shot is scaled by its charge fraction)
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Charge", meta = (EditCondition = "WeaponType == UShootingWeaponType::ChargeFire", ClampMin = 0.0, ClampMax = 1.0))
+	float MinimumChargeFraction;
+
+	// Time in seconds during which firing is blocked after a charged shot
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Charge", meta = (EditCondition = "WeaponType == UShootingWeaponType::ChargeFire", ClampMin = 0.0, ClampMax = 10.0))
+	float ChargeCooldown;
+
+
+	// Continuous
+
+	// Number of times per second a continuous weapon fires (consuming BulletPerAttack and dealing ShotDamage per second times the tick's duration every time)
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Continuous", meta = (EditCondition = "WeaponType == UShootingWeaponType::ContinuousFire", ClampMin = 1.0, ClampMax = 60.0))
+	float ContinuousTickRate;
+
+
+	// Recoil and spread (all angles in degrees, 0 disables them)
+
+	// Half-angle of the spread cone when the weapon is at rest
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 30.0))
+	float BaseSpread;
+
+	// Spread added by every shot, and maximum half-angle of the spread cone
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 10.0))
+	float SpreadPerShot;
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 30.0))
+	float MaxSpread;
+
+	// Upwards kick of every shot, and maximum accumulated upwards kick
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 10.0))
+	float RecoilPitchPerShot;
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 45.0))
+	float MaxRecoilPitch;
+
+	// Sideways kick of every shot (its direction is part of the weapon's recoil pattern), and maximum accumulated sideways kick either way
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 10.0))
+	float RecoilYawPerShot;
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.0, ClampMax = 45.0))
+	float MaxRecoilYaw;
+
+	// Time in seconds for the accumulated spread and recoil to halve once the weapon stops firing
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon Parameters | Recoil", meta = (ClampMin = 0.01, ClampMax = 5.0))
+	float RecoilRecoveryHalfLife;
+
 	
 	// Other properties
 	
@@ -125,6 +232,10 @@ protected:
 	// Name of socket from which MuzzleParticleEffect shall be emitted
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "VFX")
 	FName MuzzleSocketName;
+
+	// Persistent muzzle flash emitter, attached to MuzzleSocketName once and re-triggered on every shot
+	UPROPERTY()
+	UParticleSystemComponent* MuzzleVFXComp;
 	
 	// Dictates whether the user can trigger a reload via a button press
 	UPROPERTY(EditAnywhere, Category = "User Definitions")
@@ -139,33 +250,40 @@ protected:
 	// Time in seconds since the last time this weapon fired a bullet
 	float LastFireTime;
 
+	// Scale applied to ShotDamage for the shot being fired (charge of a charged shot, tick duration of continuous fire, 1 otherwise)
+	float ShotDamageScale;
 
-private:
-	// Function dedicated to handling automatic fire
-	virtual void StartFireAutomatic(float FirstDelay);
-
-	// Function dedicated to handling manual fire with in-built delay and forced button pressing
-	virtual void StartFireManual();
-
-	// Function dedicated to handling burst fire (short bursts of automatic fire with in-built delay between them)
-	virtual void StartFireBurst(float FirstDelay);
-	
-	// While the primary weapon action button is pressed, this function will be called continuously
-	virtual void FireWeapon();
 
-	// Resets the block for manual and burst firing
-	virtual void ResetFiringBlock();
+private:
+	// Builds the recoil and spread configuration from the properties above, the pattern seeded by the weapon's class
+	void SetupRecoil();
 	
 	// Triggers a reload via a Weapon action, always
 	void TriggerReloadViaWeaponAction();
 	
+	// Creates the persistent muzzle flash emitter and attaches it to the muzzle socket (done only once)
+	void SetupMuzzleEffect();
+
 	// Emit the muzzle effect (happens in all shooting weapons)
 	virtual void PlayMuzzleEffect();
 
-	// flag that determines the period of time for which manual firing is blocked
-	bool bBlockFiring;
+	// Entry points of this weapon's fire mode, resolved from WeaponType in BeginPlay
+	const FSFireModeBinding* FireMode;
+
+	// Whether a shot is being charged, and since when (charge fire only)
+	bool bIsCharging;
+	float ChargeStartTime;
+
+	// Fire scheduler of the world, which times the shots of this weapon
+	UPROPERTY(Transient)
+	USFireSchedulerSubsystem* FireScheduler;
+
+	// Slot of this weapon in the fire scheduler, INDEX_NONE if it isn't registered
+	int32 FireSchedulerSlot;
 
-	// counts the number of bullets shot in the current burst
-	uint8 CurrentBurstCount;
+	// Recoil and spread configuration, state, and aim offsets of the shot being fired
+	FSRecoilConfig RecoilConfig;
+	FSRecoilState RecoilState;
+	FSRecoilShot CurrentShotRecoil;
 	
 };
\ No newline at end of file
@@ -10,15 +10,101 @@
 
 
 
+class UCameraShakeBase;
+class USCharacterEquipmentComponent;
+class ASWeapon;
+
+
+
+/*
+ *
+ * Live shake instance of a shake class played by a controller, with the time it was last (re)started at, from which the part of its intensity that is left is derived
+ *
+ */
+struct FSActiveCameraShake {
+
+	// Shake instance, re-used for every request of its class
+	TWeakObjectPtr<UCameraShakeBase> Shake;
+
+	// World time at which the shake was last (re)started
+	float StartTime = 0.0f;
+
+};
+
+
+
 /**
  *
+ * Player controller used by the player characters. It aggregates the camera shakes requested during a frame (e.g.: one per round fired by a high rate of fire weapon) into a single
+ * shake per shake class, with the requested intensities added up and clamped, and keeps re-using the same live shake instance instead of creating a new one for every request.
+ * A shake restarted while still running carries over only the part of its intensity that hasn't faded yet, so sustained fire keeps a steady shake rather than pinning it to its maximum.
+ * It also keeps the player's ammo checkpoint (the serialized ammo snapshots of the loadout), which outlives the controlled character, and the weapons of a dead character's loadout
+ * until the player's next character takes them over.
  *
- * 
  */
 UCLASS()
 class COOPGAME_API ASCharacterPlayerController : public APlayerController {
-	
+
 	GENERATED_BODY()
-	
-	
+
+
+public:
+	// Sets default values for this actor's properties
+	ASCharacterPlayerController();
+
+	// Called every frame
+	virtual void Tick(float DeltaTime) override;
+
+	// Adds a camera shake request to the current frame's aggregated shake state; the shake itself is only played when the controller ticks
+	void RequestCameraShake(TSubclassOf<UCameraShakeBase> ShakeClass, float Scale = 1.0f);
+
+	// Stores the ammo state of the controlled character's loadout as this player's checkpoint (server only); returns false if there is no loadout to take it from
+	bool SaveAmmoCheckpoint(void);
+
+	// Restores the ammo state of the controlled character's loadout from this player's checkpoint (server only); returns false if there is no checkpoint or it didn't fit the loadout
+	bool LoadAmmoCheckpoint(void);
+
+	// Keeps the weapons of the given loadout (the one of a dying character) for the next character this controller possesses (server only)
+	void StowLoadout(USCharacterEquipmentComponent* EquipComp);
+
+	// Hands the stowed weapons over to the given loadout; returns false if there were none or none could be equipped (server only)
+	bool UnstowLoadout(USCharacterEquipmentComponent* EquipComp);
+
+
+protected:
+	// Called when the controller is removed from play; destroys the weapons still stowed
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Maximum intensity of the aggregated shake of a given shake class, independently of how many requests were folded into it
+	UPROPERTY(EditDefaultsOnly, Category = "Camera", meta = (ClampMin = 0.1, ClampMax = 10.0))
+	float MaxAggregatedShakeScale;
+
+
+private:
+	// Plays the aggregated shakes of the current frame, either locally or on the owning client, then clears them
+	void FlushCameraShakes();
+
+	// Plays an aggregated shake on this (local) controller's camera, re-using the live shake instance of that class if there is one
+	void PlayAggregatedCameraShake(TSubclassOf<UCameraShakeBase> ShakeClass, float Scale);
+
+	// Plays an aggregated shake on the owning client (at most once per frame and shake class)
+	UFUNCTION(Client, Unreliable)
+	void ClientPlayAggregatedCameraShake(TSubclassOf<UCameraShakeBase> ShakeClass, float Scale);
+
+
+	// Tracker variables
+
+	// Intensity accumulated by the shake requests of the current frame, per shake class
+	TMap<TSubclassOf<UCameraShakeBase>, float> PendingShakeScales;
+
+	// Live shake instance of each shake class played by this controller
+	TMap<TSubclassOf<UCameraShakeBase>, FSActiveCameraShake> ActiveShakes;
+
+	// Serialized ammo snapshots of the loadout's slots, empty if no checkpoint was saved
+	TArray<uint8> AmmoCheckpoint;
+
+	// Weapons of the last character's loadout, in slot order, kept across its death for the next one
+	UPROPERTY(Transient)
+	TArray<ASWeapon*> StowedLoadout;
+
 };
@@ -0,0 +1,147 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/World.h"
+#include "SCosmeticEffectsSubsystem.generated.h"
+
+
+
+class UParticleSystem;
+class UParticleSystemComponent;
+
+
+
+// Cosmetic work (VFX, camera shakes, debug draws) is compiled out of dedicated server builds
+#ifndef WITH_COSMETICS
+#define WITH_COSMETICS (!UE_SERVER)
+#endif
+
+
+
+/*
+ *
+ *	Variable type that specifies how important a cosmetic effect is when the effects budget is under pressure
+ *		Low = effect is dropped first and downgraded early (e.g.: tracers, impacts on non-flesh surfaces)
+ *		Normal = effect is only dropped when the budget is under pressure and it isn't relevant to any view (e.g.: flesh impacts, muzzle flashes)
+ *		High = effect is only dropped when nobody can possibly see it (e.g.: explosions)
+ *
+ */
+UENUM(BlueprintType)
+enum class UCosmeticEffectPriority : uint8 {
+
+	Low = 0,
+	Normal = 1,
+	High = 2
+
+};
+
+
+
+/*
+ *
+ * World subsystem through which every cosmetic effect (VFX) of weapons and hazards must be requested. It enforces a per-frame and a concurrent cap on emitters and ranks every request by
+ * its significance (distance to the closest local view and whether it's inside that view), dropping or downgrading low-value effects when the budget is under pressure.
+ *
+ * Requests are judged greedily, in the order they arrive, rather than being deferred and sorted at the end of the frame: callers need the emitter right away (e.g.: to set a tracer's target),
+ * and effects played a frame late would be visibly out of sync with their shot. The ranking comes from the pressure instead: the more of the frame's budget has already been spent,
+ * the more significant a request must be to be played, so the last slots of a busy frame only go to the most valuable effects. High priority effects are exempt from that ranking and from the caps.
+ *		SpawnEmitterAtLocation() replaces UGameplayStatics::SpawnEmitterAtLocation for fire-and-forget effects (impacts, tracers, explosions)
+ *		RetriggerEmitter() is to be used for persistent effect components that are re-activated instead of spawned (e.g.: muzzle flashes)
+ *
+ * Budget caps are configurable via the COOP.Cosmetics.* console variables, and the current budget pressure can be dumped with COOP.DumpCosmeticBudget
+ *
+ * AreCosmeticsEnabled() is the single gate for all cosmetic work (including camera shakes and debug draws); the subsystem itself isn't created on dedicated servers
+ *
+ */
+UCLASS()
+class COOPGAME_API USCosmeticEffectsSubsystem : public UWorldSubsystem {
+
+	GENERATED_BODY()
+
+
+public:
+	// Sets default values for this subsystem's properties
+	USCosmeticEffectsSubsystem();
+
+	// Returns true if cosmetic work should be done in the given world; always false in dedicated server builds, so guarded code is stripped by the compiler
+	static FORCEINLINE bool AreCosmeticsEnabled(const UWorld* World) {
+
+#if WITH_COSMETICS
+		return World && World->GetNetMode() != NM_DedicatedServer;
+#else
+		return false;
+#endif
+
+	}
+
+	// The subsystem is not created on dedicated servers, nobody would ever see the effects
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	// Spawns a fire-and-forget emitter if the budget allows it, returns nullptr if the request was dropped (callers must always have nullptr checks!)
+	UParticleSystemComponent* SpawnEmitterAtLocation(UParticleSystem* EmitterTemplate, const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator, const FVector& Scale = FVector(1.0f), UCosmeticEffectPriority Priority = UCosmeticEffectPriority::Normal);
+
+	// Restarts a persistent emitter component if the budget allows it, returns true if the emitter was re-activated
+	bool RetriggerEmitter(UParticleSystemComponent* PersistentEmitter, UCosmeticEffectPriority Priority = UCosmeticEffectPriority::Normal);
+
+	// Writes the current and accumulated budget pressure to the log
+	void DumpBudgetPressure() const;
+
+
+private:
+	// Evaluates the request against the budget, returns true if the effect may play and signals whether it should be downgraded
+	bool EvaluateRequest(const FVector& Location, UCosmeticEffectPriority Priority, bool bCountsAsConcurrent, bool& bShouldDowngrade);
+
+	// Returns the significance of a location (0 = irrelevant, 1 = fully relevant) relative to the closest local player view
+	float CalculateSignificance(const FVector& Location) const;
+
+	// Resets the per-frame counters and discards emitters that are no longer alive, done once per frame at most
+	void RefreshFrameBudget();
+
+	// Forces an emitter to its lowest detail level, or resets it to automatic LOD selection
+	void ApplyDowngrade(UParticleSystemComponent* Emitter, bool bShouldDowngrade) const;
+
+
+	// Tracker variables
+
+	// Fire-and-forget emitters spawned through this subsystem that may still be alive
+	TArray<TWeakObjectPtr<UParticleSystemComponent>> LiveEmitters;
+
+	// Frame number for which the per-frame counters are valid
+	uint64 BudgetFrameNumber;
+
+	// Number of effects played during the current frame
+	int32 EffectsPlayedThisFrame;
+
+
+	// Statistics (for COOP.DumpCosmeticBudget)
+
+	// Total number of effects requested
+	int32 TotalRequested;
+
+	// Total number of effects played (spawned or re-triggered)
+	int32 TotalPlayed;
+
+	// Total number of effects played at their lowest detail level
+	int32 TotalDowngraded;
+
+	// Total number of effects dropped because nobody could see them
+	int32 TotalDroppedIrrelevant;
+
+	// Total number of effects dropped because their significance was too low for the current budget pressure
+	int32 TotalDroppedLowValue;
+
+	// Total number of effects dropped because the per-frame or concurrent caps were hit
+	int32 TotalDroppedCapped;
+
+	// Highest number of fire-and-forget emitters alive at the same time
+	int32 PeakLiveEmitters;
+
+	// Highest number of effects played in a single frame
+	int32 PeakEffectsPerFrame;
+
+};
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "SFireSchedulerSubsystem.generated.h"
+
+
+
+class ASShootingWeapon;
+
+
+
+/*
+ *
+ * Fire control of every shooting weapon in the world: trigger state, next shot time, burst counter and firing block of each weapon are kept in parallel arrays (one slot per weapon, dense,
+ * the last slot being moved into the place of a removed one), instead of every weapon running its own timers in the timer manager.
+ * Once per frame, while any trigger is held, a single pass over those arrays collects every shot that has come due (several per weapon if the frame was longer than the weapon's fire interval,
+ * each with its own time), and the due shots are then handed to the weapons' firing handler in one batch, weapon by weapon.
+ * Manual shots don't wait for the frame, they are fired on the press itself, as before.
+ *
+ * Times are in world time (the same clock as the timer manager).
+ *
+ */
+UCLASS()
+class COOPGAME_API USFireSchedulerSubsystem : public UWorldSubsystem, public FTickableGameObject {
+
+	GENERATED_BODY()
+
+
+public:
+	// Sets default values for this subsystem's properties
+	USFireSchedulerSubsystem();
+
+	// Adds a weapon and its fire parameters to the scheduler and stores its slot in the weapon; ShotsInBurst is 0 for weapons that don't fire in bursts, BlockDuration is the time firing stays blocked after a manual shot or a completed burst
+	void RegisterWeapon(ASShootingWeapon* Weapon, float FireInterval, uint8 ShotsInBurst, float BlockDuration);
+
+	// Removes a weapon from the scheduler
+	void UnregisterWeapon(ASShootingWeapon* Weapon);
+
+	// Starts repeated fire (automatic, burst) for the weapon, the first shot being due after the given delay
+	void PressTrigger(const ASShootingWeapon* Weapon, float FirstDelay);
+
+	// Stops repeated fire for the weapon
+	void ReleaseTrigger(const ASShootingWeapon* Weapon);
+
+	// Fires a single shot of the weapon right away, then blocks its firing for its block duration (unless it was already blocked)
+	void FireManualShot(const ASShootingWeapon* Weapon);
+
+
+	// Tickable interface, the scheduler only ticks while a trigger is held
+
+	// Collects the due shots of every weapon in one pass, then fires them
+	virtual void Tick(float DeltaTime) override;
+
+	// Only ticks while a trigger is held
+	virtual bool IsTickable() const override;
+
+	// The class default object never ticks
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	// Ticks with its own world
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	// Stat for the fire pass
+	virtual TStatId GetStatId() const override;
+
+
+private:
+	// Shot that has come due in the current pass
+	struct FSDueShot {
+
+		// Slot of the weapon, and the weapon itself (to tell if the slot was re-used while dispatching)
+		int32 Slot;
+		ASShootingWeapon* Weapon;
+
+		// Time at which the shot was due
+		double ShotTime;
+
+	};
+
+	// Returns the slot of a registered weapon, INDEX_NONE otherwise
+	int32 FindSlot(const ASShootingWeapon* Weapon) const;
+
+	// Hands a shot to the weapon's firing handler, then updates the burst counter and firing block of its slot
+	void DispatchShot(int32 Slot, double ShotTime);
+
+
+	// Per-weapon arrays, all indexed by slot
+
+	// Weapon of each slot
+	UPROPERTY(Transient)
+	TArray<ASShootingWeapon*> Weapons;
+
+	// Whether the trigger is held (repeated fire only)
+	TArray<bool> TriggersHeld;
+
+	// Time at which the next shot is due while the trigger is held
+	TArray<double> NextFireTimes;
+
+	// Time until which firing is blocked (manual shot, completed burst)
+	TArray<double> BlockedUntilTimes;
+
+	// Time between two shots of repeated fire
+	TArray<float> FireIntervals;
+
+	// Time firing stays blocked after a manual shot or a completed burst
+	TArray<float> BlockDurations;
+
+	// Shots in a burst (0 if the weapon doesn't fire in bursts) and shots fired in the current burst
+	TArray<uint8> ShotsInBursts;
+	TArray<uint8> BurstCounts;
+
+
+	// Tracker variables
+
+	// Number of triggers currently held
+	int32 NumTriggersHeld;
+
+	// Shots due in the current pass
+	TArray<FSDueShot> DueShots;
+
+};
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+
+
+#include "CoreMinimal.h"
+
+
+
+/*
+ *
+ * Log categories of the game. Anything logged on a hot path (weapon actions, reload validation, weapon switching, HUD bindings) is logged as Verbose:
+ *		At runtime these categories default to Log, so hot path messages are silent unless enabled (e.g.: "log LogCoopAmmo Verbose")
+ *		In Test and Shipping builds their compile-time maximum is Warning, so hot path messages are not even compiled in
+ * For a record of what happened to weapons without any of the formatting cost, see SWeaponTrace.h
+ *
+ */
+
+
+
+#if UE_BUILD_SHIPPING || UE_BUILD_TEST
+#define COOP_LOG_COMPILE_VERBOSITY Warning
+#else
+#define COOP_LOG_COMPILE_VERBOSITY All
+#endif
+
+
+// Weapons: weapon actions, firing, activation/deactivation
+COOPGAME_API DECLARE_LOG_CATEGORY_EXTERN(LogCoopWeapon, Log, COOP_LOG_COMPILE_VERBOSITY);
+
+// Ammo systems: ammo consumption, reload triggers and cancels
+COOPGAME_API DECLARE_LOG_CATEGORY_EXTERN(LogCoopAmmo, Log, COOP_LOG_COMPILE_VERBOSITY);
+
+// Character equipment: loadout spawning and weapon switching
+COOPGAME_API DECLARE_LOG_CATEGORY_EXTERN(LogCoopEquipment, Log, COOP_LOG_COMPILE_VERBOSITY);
+
+// In-match HUD: widgets and their bindings to the character and weapons
+COOPGAME_API DECLARE_LOG_CATEGORY_EXTERN(LogCoopHUD, Log, COOP_LOG_COMPILE_VERBOSITY);
+
+// Cosmetic effects: effect budget and its pressure
+COOPGAME_API DECLARE_LOG_CATEGORY_EXTERN(LogCoopCosmetics, Log, COOP_LOG_COMPILE_VERBOSITY);
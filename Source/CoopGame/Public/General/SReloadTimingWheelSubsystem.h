@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "SReloadTimingWheelSubsystem.generated.h"
+
+
+
+class USAmmoSystemComponent;
+
+
+
+/*
+ *
+ *	Handle to a reload deadline scheduled in the timing wheel; stale handles (deadline already dispatched or cancelled) are detected and ignored
+ *
+ */
+struct FSReloadTimerHandle {
+
+	// Index of the entry in the timing wheel's pool
+	int32 Index = INDEX_NONE;
+
+	// Serial number of the entry when it was scheduled
+	uint32 Serial = 0;
+
+	// Returns true if the handle was ever set (it may be stale)
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	// Forgets the scheduled deadline
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+
+};
+
+
+
+/*
+ *
+ * Hierarchical timing wheel dedicated to the reload phase deadlines of every ammo system in the world (end of a delay, bullets in, completion), so reload-heavy fights don't churn the general timer manager.
+ * Time is cut into ticks of 1/128 s. Deadlines up to 2 s away go into the 256 slots of the first level, further ones into the coarser levels (64 slots each, ~2 min and ~2 h) and are cascaded down as time
+ * gets closer to them; anything further than that waits in an overflow list. Scheduling and cancelling are O(1) (intrusive lists over a pooled array, no allocation once the pool has grown).
+ * Once per frame the wheel is drained up to the current time, and the due deadlines are dispatched grouped by weapon.
+ *
+ * Deadlines are in the ammo core's clock (see GetReloadTime()), the same one used by the ammo systems. A deadline is dispatched at most one tick (plus a frame) late, never early; the ammo core processes
+ * boundaries at their own time regardless, so lateness doesn't change the outcome.
+ *
+ */
+UCLASS()
+class COOPGAME_API USReloadTimingWheelSubsystem : public UWorldSubsystem, public FTickableGameObject {
+
+	GENERATED_BODY()
+
+	// The automation test drives the wheel tick by tick and checks the deadlines it collects
+	friend class FSReloadTimingWheelTest;
+
+
+public:
+	// Sets default values for this subsystem's properties
+	USReloadTimingWheelSubsystem();
+
+	// Returns the time of the reload clock of the given world: the server's world time (the same as the local one on the server and in standalone)
+	static double GetReloadTime(const UWorld* World);
+
+	// Schedules a call to the ammo system's OnReloadDeadline at the given time (reload clock), replacing whatever the handle was scheduled for
+	void Schedule(FSReloadTimerHandle& Handle, USAmmoSystemComponent* AmmoSystem, double Deadline);
+
+	// Cancels the deadline of the handle, if it is still scheduled
+	void Cancel(FSReloadTimerHandle& Handle);
+
+	// Returns true if the handle's deadline is still waiting to be dispatched
+	bool IsScheduled(const FSReloadTimerHandle& Handle) const;
+
+
+	// Tickable interface, the wheel is drained once per frame while there is anything in it
+
+	// Drains the wheel up to the current time and dispatches the due deadlines, grouped by weapon
+	virtual void Tick(float DeltaTime) override;
+
+	// Only ticks while there is something to drain
+	virtual bool IsTickable() const override;
+
+	// The class default object never ticks
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	// Ticks with its own world
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	// Stat for the drain
+	virtual TStatId GetStatId() const override;
+
+
+private:
+	// Entry of the wheel, linked into the list of its slot
+	struct FSReloadTimerEntry {
+
+		// Ammo system to be called
+		TWeakObjectPtr<USAmmoSystemComponent> AmmoSystem;
+
+		// Deadline, in reload clock time and in ticks
+		double Deadline;
+		int64 DeadlineTick;
+
+		// Neighbours in the slot's list (or next free entry, for entries in the free list)
+		int32 Prev;
+		int32 Next;
+
+		// List the entry is in (index in SlotHeads), INDEX_NONE if it is free
+		int32 SlotHeadIndex;
+
+		// Incremented every time the entry is released, so handles to a previous use are stale
+		uint32 Serial;
+
+	};
+
+	// Due deadline, collected before dispatching so dispatched callbacks can safely schedule again
+	struct FSDueReloadTimer {
+
+		// Weapon owning the ammo system, for grouping
+		const AActor* Weapon;
+
+		// Ammo system to be called, and its deadline
+		TWeakObjectPtr<USAmmoSystemComponent> AmmoSystem;
+		double Deadline;
+
+	};
+
+	// Puts an entry in the slot matching its deadline tick, relative to the current tick
+	void Link(int32 EntryIndex);
+
+	// Takes an entry out of its slot's list
+	void Unlink(int32 EntryIndex);
+
+	// Returns an entry to the free list, making its handles stale
+	void Release(int32 EntryIndex);
+
+	// Re-inserts every entry of a list according to its deadline (cascades a slot of a coarser level down)
+	void Cascade(int32 SlotHeadIndex);
+
+	// Advances the wheel up to the given tick, collecting the due deadlines
+	void AdvanceTo(int64 TargetTick);
+
+
+	// Tracker variables
+
+	// Pool of entries (in use and free)
+	TArray<FSReloadTimerEntry> Entries;
+
+	// First entry of the free list
+	int32 FreeListHead;
+
+	// First entry of every slot list, all levels one after the other, the overflow list last
+	TArray<int32> SlotHeads;
+
+	// Last tick that has been drained
+	int64 CurrentTick;
+
+	// Number of deadlines currently scheduled
+	int32 NumScheduled;
+
+	// Deadlines due in the current drain
+	TArray<FSDueReloadTimer> DueTimers;
+
+};
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/World.h"
+#include "SWeaponDefinitionsSubsystem.generated.h"
+
+
+
+struct FStreamableHandle;
+
+
+
+/*
+ *
+ * Game instance subsystem that preloads every weapon definition (see USWeaponDefinition) with its game bundle through the asset manager, and keeps them loaded for as long as the game runs.
+ * Being part of the game instance it exists on every machine (server, listen server and clients alike), and it starts loading before the first map is even loaded.
+ * The load itself is asynchronous, but no world gets past its initialization with the preload still in flight: it's waited for right then, so no weapon (placed in the level, spawned
+ * by the server or replicated to a client) ever begins play without its definition and effects in memory.
+ *
+ */
+UCLASS()
+class COOPGAME_API USWeaponDefinitionsSubsystem : public UGameInstanceSubsystem {
+
+	GENERATED_BODY()
+
+
+public:
+	// Starts preloading the weapon definitions
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// Releases the weapon definitions
+	virtual void Deinitialize() override;
+
+
+private:
+	// Waits for the preload to complete once a world is initialized, before any of its actors is
+	void OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues InitializationValues);
+
+	// Keeps the preloaded weapon definitions and their game bundle in memory
+	TSharedPtr<FStreamableHandle> WeaponDefinitionsHandle;
+
+	// Handle of the delegate bound to the world initialization
+	FDelegateHandle WorldInitializationHandle;
+
+};
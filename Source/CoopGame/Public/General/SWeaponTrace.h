@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+
+
+#include "CoreMinimal.h"
+
+
+
+// Weapon trace is only compiled in non-shipping builds
+#ifndef COOP_WEAPON_TRACE
+#define COOP_WEAPON_TRACE (!UE_BUILD_SHIPPING)
+#endif
+
+
+
+// Events recorded in the weapon trace; the meaning of the two values of each record depends on the event
+enum class ESWeaponTraceEvent : uint8 {
+
+	WeaponFired = 0,			// bullets consumed, -
+	FireBlocked = 1,			// -, -
+	ReloadTriggered = 2,		// success, cancel trigger
+	ReloadCancelled = 3,		// success, cancel trigger
+	WeaponActivated = 4,		// -, -
+	WeaponDeactivated = 5,		// -, -
+	WeaponSwitched = 6,			// new slot, -
+	ReloadRolledBack = 7,		// acknowledged action, actions still pending
+	WeaponWoken = 8				// wake-up time in microseconds, over budget
+
+};
+
+
+/*
+ *
+ *	Single record of the weapon trace, plain data only
+ *
+ */
+struct FSWeaponTraceRecord {
+
+	// Position of this record in the trace, written last so readers can tell complete records from ones being written or already overwritten
+	uint32 Sequence;
+
+	// Time at which the record was written, in CPU cycles
+	uint64 Cycles;
+
+	// Name of the object that caused the event (copying a name doesn't format anything)
+	FName Source;
+
+	// Recorded event
+	ESWeaponTraceEvent Event;
+
+	// Values of the event
+	int32 ValueA;
+	int32 ValueB;
+
+};
+
+
+
+/*
+ *
+ * Lock-free binary ring buffer in which weapon, ammo and equipment events are recorded, to be dumped on demand with COOP.DumpWeaponTrace [Count].
+ * Recording is a handful of stores and one atomic increment, with no string formatting whatsoever, so it can stay on the hot paths that the logs can't afford.
+ * Writers never wait: the newest records overwrite the oldest ones, and a dump simply skips the records that were being overwritten while it read them.
+ * Use the COOP_TRACE_WEAPON macro rather than Record() directly, so the calls disappear from shipping builds.
+ *
+ */
+class COOPGAME_API FSWeaponTrace {
+
+public:
+	// Records an event in the trace
+	static void Record(ESWeaponTraceEvent Event, const UObject* Source, int32 ValueA = 0, int32 ValueB = 0);
+
+	// Writes the most recent records of the trace (at most MaxRecords) to the given output device, oldest first
+	static void Dump(FOutputDevice& Ar, int32 MaxRecords);
+
+
+private:
+	// Number of records kept, must be a power of 2
+	static constexpr uint32 Capacity = 4096;
+
+	// The records proper
+	static FSWeaponTraceRecord Records[Capacity];
+
+	// Number of records ever written
+	static volatile int32 RecordCount;
+
+};
+
+
+
+#if COOP_WEAPON_TRACE
+#define COOP_TRACE_WEAPON(Event, Source, ...) FSWeaponTrace::Record(ESWeaponTraceEvent::Event, Source, ##__VA_ARGS__)
+#else
+#define COOP_TRACE_WEAPON(Event, Source, ...)
+#endif
@@ -170,28 +170,28 @@ private:
 	// Auxiliary function for hiding all reload-indicating widgets
 	void HideAllReloadWidgets();
 
-	// Auxiliary function for processing the unbinding of the previous weapon's reload system delegates
+	// Auxiliary function for processing the unbinding of the previous weapon's reload system events
 	void UnbindReloadDelegates(USAmmoSystemComponent* AmmoSysComp);
 	
-	// Auxiliary function for unbinding all passive reload system delegates
+	// Auxiliary function for unbinding all passive reload system events
 	void UnbindPassiveReloadDelegates(USAmmoSystemComponent* AmmoSysComp);
 
-	// Auxiliary function for unbinding all magazine reload system delegates
+	// Auxiliary function for unbinding all magazine reload system events
 	void UnbindMagazineReloadDelegates(USAmmoSystemComponent* AmmoSysComp);
 
-	// Auxiliary function for unbinding all per-bullet reload system delegates
+	// Auxiliary function for unbinding all per-bullet reload system events
 	void UnbindPerBulletReloadDelegates(USAmmoSystemComponent* AmmoSysComp);
 
 	// Auxiliary function for processing of new weapon reload type and binding of appropriate delegates
 	void BindReloadDelegates(USAmmoSystemComponent* AmmoSysComp);
 
-	// Auxiliary function for binding all passive reload system delegates
+	// Auxiliary function for binding all passive reload system events
 	void BindPassiveReloadDelegates(USAmmoSystemComponent* AmmoSysComp);
 
-	// Auxiliary function for binding all magazine reload system delegates
+	// Auxiliary function for binding all magazine reload system events
 	void BindMagazineReloadDelegates(USAmmoSystemComponent* AmmoSysComp);
 
-	// Auxiliary function for binding all per-bullet reload system delegates
+	// Auxiliary function for binding all per-bullet reload system events
 	void BindPerBulletReloadDelegates(USAmmoSystemComponent* AmmoSysComp);
 
 	// Reload type of the current weapon; this is written only at Weapon Change
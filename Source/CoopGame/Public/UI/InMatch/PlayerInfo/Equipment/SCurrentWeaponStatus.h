@@ -28,6 +28,9 @@ class COOPGAME_API USCurrentWeaponStatus : public UUserWidget {
 
 	
 public:
+	// First operations upon construction
+	virtual void NativeConstruct() override;
+
 	// Function called by the owning HUD once a weapon switch is commanded and a weapon is to be activated, binding functions to the new weapon objects' delegates and unbinding functions from the previous one
 	// Note: the initial set up of the ammo values is done at activation of automatic abilities (broadcast of initial values after activation of weapon) 
 	UFUNCTION()
@@ -69,5 +72,11 @@ protected:
 
 	// Function that only updates the text labels of the CurrentWeaponStatus HUD element, done upon weapon switch
 	void UpdateLabels(UReloadType newCurrentWeaponType);
+
+
+private:
+	// Values currently displayed in AvailableBullets and AvailableReloads, so the texts are only rebuilt when they actually change
+	int32 DisplayedBulletsCurrentlyActive;
+	int32 DisplayedAvailableReloads;
 	
 };
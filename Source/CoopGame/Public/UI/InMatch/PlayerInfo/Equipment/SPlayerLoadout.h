@@ -35,14 +35,8 @@ public:
 	UFUNCTION()
 	void OnWeaponChange(uint8 newSlot);
 	
-	// Highlight weapon slot number 1
-	virtual void ActivateWeaponSlot1();
-
-	// Highlight weapon slot number 2
-	virtual void ActivateWeaponSlot2();
-
-	// Highlight weapon slot number 3
-	virtual void ActivateWeaponSlot3();
+	// Highlight the weapon slot with the given number (1 is the first slot)
+	virtual void ActivateWeaponSlot(uint8 SlotNumber);
 
 	// Highlight skill slot
 	virtual void ActivateSkillSlot();
@@ -54,7 +48,10 @@ public:
 	void OnPlayerDeath(float DeathAnimTime);
 	
 	
-protected:	
+protected:
+	// Gathers the weapon slot widgets bound by the child BP class, in slot order
+	virtual void NativeOnInitialized() override;
+
 	// Pointer to WeaponSlot1 object to be instanced in the child BP class
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 	USEquipmentSlot* WeaponSlot1;
@@ -67,6 +64,14 @@ protected:
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 	USEquipmentSlot* WeaponSlot3;
 
+	// Pointer to WeaponSlot4 object, optionally instanced in the child BP class for loadouts with more than 3 weapons
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	USEquipmentSlot* WeaponSlot4;
+
+	// Pointer to WeaponSlot5 object, optionally instanced in the child BP class for loadouts with more than 4 weapons
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	USEquipmentSlot* WeaponSlot5;
+
 	// Pointer to SkillSlot object to be instanced in the child BP class
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 	USEquipmentSlot* SkillSlot;
@@ -79,5 +84,9 @@ private:
 	// Pointer to slot of the currently active weapon
 	UPROPERTY()
 	USEquipmentSlot* ActiveWeaponSlot;
+
+	// Weapon slot widgets in slot order (index 0 is slot 1), so a slot number maps straight to its widget
+	UPROPERTY()
+	TArray<USEquipmentSlot*> WeaponSlotWidgets;
 	
 };